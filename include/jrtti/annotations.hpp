@@ -5,6 +5,7 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/pointer_cast.hpp>
 #include <boost/function.hpp>
+#include "threads.hpp"
 
 namespace jrtti {
 
@@ -21,6 +22,34 @@ public:
 	virtual ~Annotation(){};
 };
 
+/**
+ * \brief Annotation for non streamable properties
+ *
+ * A property with annotation NoStreamable will not be streamed or returned by
+ * method Metatype::toStr with parameter formatForStreaming set to true
+ */
+class NoStreamable : public Annotation {
+};
+
+class StringifyDelegateBase : public Annotation {
+public:
+	virtual std::string toStr( void * instance )=0;
+	virtual void fromStr( void * instance, std::string str )=0;
+};
+
+/**
+ * \brief Marks property for stream reading
+ * 
+ * Reference or pointer properties without setter are marked as ReadOnly. 
+ * Therefore, the fromStr method ignores such a property and it is not loaded.
+ * Non const references or pointers give access to it contens allowing to change 
+ * internal values. This often happens in streaming. This Annotation forces the 
+ * streaming mechanism to load data for such properties.
+ */
+class ForceStreamLoadable : public Annotation {
+	//TODO: consirering the constness of references and pointers, this may be unnecesary
+};
+
 /**
  * \brief Provides a mechanism for custom annotations
  *
@@ -31,6 +60,10 @@ public:
  * is not streamable.
  * You can create your own annotations by creating a class derived from Annotation
  * See sample.h for an example of use
+ * The well known annotations are resolved when added, see flags and
+ * stringifyDelegate. Lookups of other annotation types take constant time
+ * for types registered with registerType before adding the annotations,
+ * and scan the container otherwise.
  */
 class Annotations
 {
@@ -38,10 +71,25 @@ public:
 	typedef std::vector< Annotation * > Container;
 	typedef Container::const_iterator iterator;
 
-	Annotations(){}
+	/**
+	 * \brief Well known annotations held by the container, see flags
+	 */
+	enum Flag {
+		hasNoStreamable = 1,			///< a NoStreamable annotation
+		hasForceStreamLoadable = 2,		///< a ForceStreamLoadable annotation
+		hasStringifyDelegate = 4		///< a StringifyDelegateBase annotation
+	};
+
+	Annotations()
+		:	m_flags( 0 ),
+			m_delegate( NULL ) {}
 	
-	Annotations( const Annotations& source ) {
-		*this = source;
+	Annotations( const Annotations& source )
+		:	m_annotations( source.m_annotations ),
+			m_flags( source.m_flags ),
+			m_delegate( source.m_delegate ),
+			m_firsts( source.m_firsts ) {
+		own();
 	}
 
 	~Annotations() {
@@ -53,10 +101,16 @@ public:
 
 	Annotations& 
 	operator = ( const Annotations& source ) {
-		for ( iterator it = source.m_annotations.begin(); it != source.m_annotations.end(); ++it ) {
-			(*it)->owner = this;
-		}
+		// a new container is not in any serialization plan, nor is an unchanged one
+		const bool differs = m_annotations != source.m_annotations;
 		m_annotations = source.m_annotations;
+		m_flags = source.m_flags;
+		m_delegate = source.m_delegate;
+		m_firsts = source.m_firsts;
+		own();
+		if ( differs ) {
+			changed();
+		}
 		return *this;
 	}
 
@@ -69,9 +123,69 @@ public:
 	operator << ( Annotation * annotation ) {
 		annotation->owner = this;
 		m_annotations.push_back( annotation );
+		if ( dynamic_cast< NoStreamable * >( annotation ) ) {
+			m_flags |= hasNoStreamable;
+		}
+		if ( dynamic_cast< ForceStreamLoadable * >( annotation ) ) {
+			m_flags |= hasForceStreamLoadable;
+		}
+		if ( !m_delegate && ( m_delegate = dynamic_cast< StringifyDelegateBase * >( annotation ) ) != NULL ) {
+			m_flags |= hasStringifyDelegate;
+		}
+		indexTypes();
+		changed();
 		return *this;
 	}
 
+	/**
+	 * \brief Retrieves the well known annotations held
+	 * \return a combination of Flag values
+	 */
+	unsigned
+	flags() const {
+		return m_flags;
+	}
+
+	/**
+	 * \brief Retrieves the first StringifyDelegateBase annotation
+	 * \return the annotation or NULL if there is none
+	 */
+	StringifyDelegateBase *
+	stringifyDelegate() const {
+		return m_delegate;
+	}
+
+	/**
+	 * \brief Retrieves the number of changes made to the content of all annotation containers
+	 *
+	 * Metatypes compare it with the one seen when compiling their
+	 * serialization plan, to compile it again after annotations change.
+	 * \return the number of changes
+	 */
+	static
+	unsigned
+	version() {
+		return versionCounter().load();
+	}
+
+	/**
+	 * \brief Registers an annotation type for constant time lookups
+	 *
+	 * Containers index the first annotation of each registered type when
+	 * annotations are added to them. Types are registered the first time
+	 * they are looked up, so register custom annotation types before
+	 * declaring the metatypes using them to index them from the start.
+	 * \tparam T the annotation type
+	 * \return the index of the type in the registry
+	 */
+	template< typename T >
+	static
+	size_t
+	registerType() {
+		static const size_t index = registry().add( &findFirst< T > );
+		return index;
+	}
+
 	/**
 	 * \brief Get the first occurrence of annotation of type T
 	 *
@@ -80,13 +194,13 @@ public:
 	 */
 	template< typename T >
 	T *
-	getFirst() {
-		for ( Container::iterator it = m_annotations.begin(); it != m_annotations.end(); ++it ) {
-			T * p = dynamic_cast< T* >( *it );
-			if ( p )
-				return p;
+	getFirst() const {
+		const size_t index = registerType< T >();
+		if ( index < m_firsts.size() ) {
+			return static_cast< T * >( m_firsts[ index ] );
 		}
-		return NULL;
+		// registered after the annotations were added
+		return static_cast< T * >( findFirst< T >( m_annotations ) );
 	}
 
 	/**
@@ -97,9 +211,9 @@ public:
 	 */
 	template< typename T >
 	std::vector< T * >
-	getAll() {
+	getAll() const {
 		std::vector< T * > v;
-		for ( Container::iterator it = m_annotations.begin(); it != m_annotations.end(); ++it ) {
+		for ( iterator it = m_annotations.begin(); it != m_annotations.end(); ++it ) {
 			T * p = dynamic_cast< T* >( *it );
 			if ( p )
 				v.push_back( p );
@@ -115,41 +229,87 @@ public:
 	 */
 	template< typename T >
 	bool
-	has() {
+	has() const {
 		return getFirst< T >() != NULL;
 	}
 
 private:
-	Container m_annotations;
-};
+	typedef void * ( * FindFirst )( const Container& annotations );
 
-/**
- * \brief Annotation for non streamable properties
- *
- * A property with annotation NoStreamable will not be streamed or returned by
- * method Metatype::toStr with parameter formatForStreaming set to true
- */
-class NoStreamable : public Annotation {
-};
+	// Lookup functions of the registered annotation types, by index
+	class Registry {
+	public:
+		size_t
+		add( FindFirst findFirst ) {
+			__LockGuard lock( m_mutex );
+			m_types.push_back( findFirst );
+			return m_types.size() - 1;
+		}
 
-class StringifyDelegateBase : public Annotation {
-public:
-	virtual std::string toStr( void * instance )=0;
-	virtual void fromStr( void * instance, std::string str )=0;
-};
-
-/**
- * \brief Marks property for stream reading
- * 
- * Reference or pointer properties without setter are marked as ReadOnly. 
- * Therefore, the fromStr method ignores such a property and it is not loaded.
- * Non const references or pointers give access to it contens allowing to change 
- * internal values. This often happens in streaming. This Annotation forces the 
- * streaming mechanism to load data for such properties.
- */
-class ForceStreamLoadable : public Annotation {
-	//TODO: consirering the constness of references and pointers, this may be unnecesary
-};
+		void
+		index( const Container& annotations, std::vector< void * >& firsts ) {
+			__LockGuard lock( m_mutex );
+			firsts.resize( m_types.size() );
+			for ( size_t i = 0; i < m_types.size(); ++i ) {
+				firsts[ i ] = m_types[ i ]( annotations );
+			}
+		}
+
+	private:
+		std::vector< FindFirst >	m_types;
+		__Mutex						m_mutex;
+	};
+
+	static
+	Registry&
+	registry() {
+		static Registry instance;
+		return instance;
+	}
+
+	template< typename T >
+	static
+	void *
+	findFirst( const Container& annotations ) {
+		for ( iterator it = annotations.begin(); it != annotations.end(); ++it ) {
+			T * p = dynamic_cast< T* >( *it );
+			if ( p )
+				return p;
+		}
+		return NULL;
+	}
+
+	void
+	own() {
+		for ( iterator it = m_annotations.begin(); it != m_annotations.end(); ++it ) {
+			(*it)->owner = this;
+		}
+	}
+
+	void
+	indexTypes() {
+		registry().index( m_annotations, m_firsts );
+	}
+
+	static
+	__Atomic< unsigned >&
+	versionCounter() {
+		static __Atomic< unsigned > counter;
+		return counter;
+	}
+
+	static
+	void
+	changed() {
+		versionCounter().increment();
+	}
+
+	Container				m_annotations;
+	unsigned				m_flags;
+	StringifyDelegateBase *	m_delegate;
+	// first annotation of each registered type, see registerType
+	std::vector< void * >	m_firsts;
+};
 
 /**
  * \brief Delegates for toStr and fromStr
@@ -181,23 +341,23 @@ public:
 	StringifyDelegate( Stringifier stringifier, DeStringifier deStringifier ) {
 		m_deStringifier = deStringifier;
 		m_stringifier = stringifier;
-	}
-
-	virtual
-	std::string
-	toStr( void * instance ) {
-		return m_stringifier( (T*)instance );
-	}
-
-	virtual
-	void
-	fromStr( void * instance, std::string str ) {
-		m_deStringifier( (T*)instance, str );
-	}
-
-private:
-	DeStringifier m_deStringifier;
-	Stringifier m_stringifier;
+	}
+
+	virtual
+	std::string
+	toStr( void * instance ) {
+		return m_stringifier( (T*)instance );
+	}
+
+	virtual
+	void
+	fromStr( void * instance, std::string str ) {
+		m_deStringifier( (T*)instance, str );
+	}
+
+private:
+	DeStringifier m_deStringifier;
+	Stringifier m_stringifier;
 };
 
 }; //namespace jrtti
@@ -0,0 +1,161 @@
+#ifndef jrttiarenaH
+#define jrttiarenaH
+
+#include <new>
+#include <vector>
+#include <cstdlib>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include "threads.hpp"
+
+namespace jrtti {
+
+/**
+ * \brief Owner of the objects created while loading an object graph
+ *
+ * Objects are created one after another in big memory blocks, instead of
+ * being allocated one by one, and are all destroyed by a single call to
+ * clear. The blocks are kept to create the objects of the next load, so
+ * reloading a graph does not allocate memory again once the blocks are
+ * big enough.
+ * Set an arena to a SerializationContext to create in it the objects
+ * referenced by pointers and collection elements while loading with
+ * Metatype::fromStr. Objects owned by an arena should not be deleted, nor
+ * be deleted by the destructor of other objects.
+ * Creating objects is thread safe, so an arena can be used by parallel
+ * loads.
+ */
+class ObjectArena {
+public:
+	/**
+	 * \brief Constructor
+	 * \param blockSize size in bytes of the memory blocks
+	 */
+	ObjectArena( size_t blockSize = 64 * 1024 )
+		:	m_blockSize( blockSize ),
+			m_block( 0 ),
+			m_used( 0 ) {}
+
+	~ObjectArena() {
+		release();
+	}
+
+	/**
+	 * \brief Creates a default constructed object
+	 * \tparam T the object type
+	 * \return pointer to the object
+	 */
+	template< typename T >
+	T *
+	create() {
+		__LockGuard lock( m_mutex );
+		T * obj = new ( allocate( sizeof( T ), boost::alignment_of< T >::value ) ) T();
+		if ( !boost::has_trivial_destructor< T >::value ) {
+			m_finalizers.push_back( Finalizer( obj, &destroy< T > ) );
+		}
+		return obj;
+	}
+
+	/**
+	 * \brief Destroys all objects, in reverse order of creation
+	 *
+	 * The memory is kept to create new objects.
+	 */
+	void
+	clear() {
+		__LockGuard lock( m_mutex );
+		while ( !m_finalizers.empty() ) {
+			Finalizer finalizer = m_finalizers.back();
+			m_finalizers.pop_back();
+			finalizer.destroy( finalizer.obj );
+		}
+		m_block = 0;
+		m_used = 0;
+	}
+
+	/**
+	 * \brief Destroys all objects and frees the memory
+	 */
+	void
+	release() {
+		clear();
+		__LockGuard lock( m_mutex );
+		for ( size_t i = 0; i < m_blocks.size(); ++i ) {
+			free( m_blocks[ i ].data );
+		}
+		m_blocks.clear();
+	}
+
+	/**
+	 * \brief Retrieves the memory reserved by the arena
+	 * \return the size in bytes of all memory blocks
+	 */
+	size_t
+	capacity() const {
+		size_t total = 0;
+		for ( size_t i = 0; i < m_blocks.size(); ++i ) {
+			total += m_blocks[ i ].size;
+		}
+		return total;
+	}
+
+private:
+	ObjectArena( const ObjectArena& );
+	ObjectArena& operator = ( const ObjectArena& );
+
+	struct Block {
+		Block( char * blockData, size_t blockSize )
+			:	data( blockData ),
+				size( blockSize ) {}
+
+		char *	data;
+		size_t	size;
+	};
+
+	struct Finalizer {
+		Finalizer( void * finalizedObj, void ( * finalizerDestroy )( void * ) )
+			:	obj( finalizedObj ),
+				destroy( finalizerDestroy ) {}
+
+		void *	obj;
+		void	( * destroy )( void * );
+	};
+
+	template< typename T >
+	static
+	void
+	destroy( void * obj ) {
+		static_cast< T * >( obj )->~T();
+	}
+
+	// Memory for an object, from the current block or the next one big enough
+	void *
+	allocate( size_t size, size_t alignment ) {
+		for ( ; m_block < m_blocks.size(); ++m_block, m_used = 0 ) {
+			const Block& block = m_blocks[ m_block ];
+			const size_t start = ( size_t( block.data + m_used ) + alignment - 1 ) / alignment * alignment - size_t( block.data );
+			if ( start + size <= block.size ) {
+				m_used = start + size;
+				return block.data + start;
+			}
+		}
+		const size_t blockSize = size + alignment > m_blockSize ? size + alignment : m_blockSize;
+		char * data = static_cast< char * >( malloc( blockSize ) );
+		if ( !data ) {
+			throw std::bad_alloc();
+		}
+		m_blocks.push_back( Block( data, blockSize ) );
+		return allocate( size, alignment );
+	}
+
+	std::vector< Block >		m_blocks;
+	std::vector< Finalizer >	m_finalizers;
+	size_t						m_blockSize;
+	size_t						m_block;
+	size_t						m_used;
+	__Mutex						m_mutex;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jrttiarenaH
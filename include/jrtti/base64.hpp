@@ -1,220 +1,477 @@
-#ifndef BASE64_H_
-#define BASE64_H_
-
-#include <string>
-#include <sstream>
-#include <memory>
-#include <stdint.h>
-
-namespace jrtti
-{
-	const char base64chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-	const char base64pad = '=';
-
-// based on Kapo coding http://kapo-cpp.blogspot.com/. Thanks!
-
-class Base64 {
-public:
-	/**
-	* @brief Encode a buffer on a string base64 encoded
-	*
-	* Base 64 encoding converts 3 bytes into 4 encoded ASCII
-	* characters.
-	* If the encoded string lenght is not multiple of 4
-	* the padding character "=" is added for fill the buffer.
-	* If the buf_size is 0 an empty string was returned.
-	*
-	* @param buf_ptr pointer to the source buffer
-	* @param buf_size size of the buffer
-	*
-	* @return a string base64 encoded
-	*
-	* @see http://en.wikipedia.org/wiki/Base64
-	*/
-	static std::string encode(uint8_t* buf_ptr, size_t buf_size)
-	{
-		// If the buf_size is 0 return an empty string
-		if (buf_size == 0)
-			return "";
-
-		uint32_t n = 0;
-		uint8_t n0, n1, n2, n3;
-		std::stringstream ss_result;
-
-		// Iterate over the buffer
-		for (size_t x = 0; x < buf_size; x += 3)
-		{
-			// Get 3 bytes of 8 bit from the buffer
-			n = buf_ptr[x] << 16;
-
-			if ((x + 1) < buf_size)
-			{
-				n += buf_ptr[x + 1] << 8;
-
-				if ((x + 2) < buf_size)
-				{
-					n += buf_ptr[x + 2];
-				}
-			}
-
-			// Transform on 4 bytes of 6 bit
-			n0 = (uint8_t)(n >> 18) & 63;
-			n1 = (uint8_t)(n >> 12) & 63;
-			n2 = (uint8_t)(n >> 6) & 63;
-			n3 = (uint8_t)n & 63;
-
-			// Write first 2 bytes into the stream
-			ss_result << base64chars[n0];
-			ss_result << base64chars[n1];
-
-			// Test if only 2 bytes
-			if ((x + 1) < buf_size)
-			{
-				// Write 3rd into the stream
-				ss_result << base64chars[n2];
-
-				// Test if only 3 bytes
-				if ((x + 2) < buf_size)
-				{
-					// Write 4th into the stream
-					ss_result << base64chars[n3];
-				}
-			}
-		}
-
-		// Add padding character for fill the output string
-		for (size_t pad_count = 0; pad_count < ss_result.str().size() % 4; pad_count++)
-		{
-			ss_result << base64pad;
-		}
-
-		return ss_result.str();
-	}
-
-	/**
-	* @brief Decode a string base64 encoded and return a raw buffer
-	*
-	* The function allocate a buffer with size:
-	* @code (text.size() + 3) / 4 * 3 \endcode
-	* and return the pointer. The caller has the ownership of the
-	* pointer.
-	* The source string lenght must be multiple of 4.
-	* Use is_base_64 for test if a string is Base64 well formed.
-	*
-	* @param text the base64 string encoded
-	* @param buf_ptr a previously allocated block of memory to receive
-	* the decoded data. If NULL or not set, the function allocates memory
-	* and the caller is reponsible for deallocation
-	*
-	* @return the pointer to the decoded buffer
-	*/
-	static uint8_t * decode(const std::string& text, uint8_t * buf_ptr = NULL )
-	{
-		// Create the decode matrix
-		uint8_t decode_base64chars[256];
-		std::memset (decode_base64chars, 0, 256);
-
-		for (uint8_t i = 0; i <= 63; i++)
-		{
-			decode_base64chars[(int)base64chars[(int)i]] = i;
-		}
-
-		// Allocate output buffer
-		if (!buf_ptr) {
-			buf_ptr = new uint8_t[decodedSize(text.size())];
-		}
-
-		// Start decode source string
-		size_t buf_idx = 0;
-		for (size_t i = 0; i < text.size(); i += 4, buf_idx += 3)
-		{
-			// Put first base64 char on the first output-byte
-			buf_ptr[buf_idx] = decode_base64chars[(int)text[i]] << 2;
-
-			// Test for string end
-			if ((i + 1 < text.size()) && (text[i + 1] != base64pad))
-			{
-				// Add to the first output-byte 2 bit of the second base64 char
-				buf_ptr[buf_idx] += (decode_base64chars[(int)text[i + 1]] >> 4) & 0x3;
-
-				// Put remaining 4 bit of the second base64 char on the second output-byte
-				buf_ptr[buf_idx + 1] = decode_base64chars[(int)text[i + 1]] << 4;
-
-				// Test for string end
-				if ((i + 2 < text.size()) && (text[i + 2] != base64pad))
-				{
-					// Add to the second output-byte 4 bit of the third base64 char
-					buf_ptr[buf_idx + 1] += (decode_base64chars[(int)text[i + 2]] >> 2) & 0xf;
-
-					// Put remaining 2 bit of the third base64 char on the third output-byte
-					buf_ptr[buf_idx + 2] = decode_base64chars[(int)text[i + 2]] << 6;
-
-					// Test for string end
-					if ((i + 1 < text.size()) && (text[i + 3] != base64pad))
-					{
-						// Add to the third output-byte the forth base64 char
-						buf_ptr[buf_idx + 2] += decode_base64chars[(int)text[i + 3]];
-					}
-				}
-			}
-		}
-
-		return buf_ptr;
-	}
-
-private:
-	/* *
-	* @brief Compute size of decoded stream
-	*
-	* @param encoded_size size of the encoded stream
-	* @return the size of the decoded stream
-	*/
-	static size_t decodedSize(size_t encoded_size)
-	{
-		return (encoded_size + 3) / 4 * 3;
-	}
-
-
-	/* *
-	* @brief Test if a string is well Base64 encoded
-	*
-	* @param text the string Base64 encoded
-	*
-	* @return true if the string is well formed
-	*/
-	static bool isBase64(const std::string& text)
-	{
-		// Create the decode matrix
-		uint8_t decode_base64chars[256];
-		std::memset (decode_base64chars, 65, 256);
-
-		for (uint8_t i = 0; i <= 63; i++)
-		{
-			decode_base64chars[(int)base64chars[(int)i]] = i;
-		}
-
-		// Add padding character
-		decode_base64chars[(int)'='] = 64;
-
-		// Test string characters
-		for (size_t i = 0; i < text.size(); i++)
-		{
-			if (decode_base64chars[(int)text[i]] == 65)
-			{
-				// Invalid character found
-				return false;
-			}
-			else if ((decode_base64chars[(int)text[i]] == 64) && (i < text.size() - 3))
-			{
-				// Padding character at invalid position
-				return false;
-			}
-		}
-
-		return true;
-	}
-};
-
-};
-
-#endif /*BASE64_H_*/
+#ifndef BASE64_H_
+#define BASE64_H_
+
+#include <string>
+#include <cstring>
+#include <stdint.h>
+#include "simd.hpp"
+
+namespace jrtti
+{
+	const char base64chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	const char base64pad = '=';
+
+// based on Kapo coding http://kapo-cpp.blogspot.com/. Thanks!
+
+class Base64 {
+public:
+	/**
+	* @brief Encode a buffer on a string base64 encoded
+	*
+	* Base 64 encoding converts 3 bytes into 4 encoded ASCII
+	* characters.
+	* If the encoded string lenght is not multiple of 4
+	* the padding character "=" is added for fill the buffer.
+	* If the buf_size is 0 an empty string was returned.
+	*
+	* @param buf_ptr pointer to the source buffer
+	* @param buf_size size of the buffer
+	*
+	* @return a string base64 encoded
+	*
+	* @see http://en.wikipedia.org/wiki/Base64
+	*/
+	static std::string encode(const uint8_t* buf_ptr, size_t buf_size)
+	{
+		std::string result(encodedSize(buf_size), base64pad);
+		if (buf_size)
+		{
+			encode(buf_ptr, buf_size, &result[0]);
+		}
+		return result;
+	}
+
+	/**
+	* @brief Encode a buffer into a caller provided buffer
+	*
+	* 12 bytes are encoded at a time when SSSE3 is available.
+	*
+	* @param buf_ptr pointer to the source buffer
+	* @param buf_size size of the buffer
+	* @param out destination buffer, at least encodedSize(buf_size) long
+	*
+	* @return the number of characters written
+	*/
+	static size_t encode(const uint8_t* buf_ptr, size_t buf_size, char* out)
+	{
+		const uint8_t* last = buf_ptr + buf_size;
+		char* start = out;
+
+#if defined( JRTTI_SSSE3 )
+		// 16 bytes are loaded and the first 12 encoded
+		for (; last - buf_ptr >= 16; buf_ptr += 12, out += 16)
+		{
+			_mm_storeu_si128((__m128i*)out, encode12(_mm_loadu_si128((const __m128i*)buf_ptr)));
+		}
+#endif
+		for (; last - buf_ptr >= 3; buf_ptr += 3, out += 4)
+		{
+			const uint32_t n = (buf_ptr[0] << 16) | (buf_ptr[1] << 8) | buf_ptr[2];
+			out[0] = base64chars[n >> 18];
+			out[1] = base64chars[(n >> 12) & 63];
+			out[2] = base64chars[(n >> 6) & 63];
+			out[3] = base64chars[n & 63];
+		}
+
+		// Add padding character for fill the last group
+		if (buf_ptr < last)
+		{
+			const uint32_t n = (buf_ptr[0] << 16) | ((last - buf_ptr > 1) ? buf_ptr[1] << 8 : 0);
+			out[0] = base64chars[n >> 18];
+			out[1] = base64chars[(n >> 12) & 63];
+			out[2] = (last - buf_ptr > 1) ? base64chars[(n >> 6) & 63] : base64pad;
+			out[3] = base64pad;
+			out += 4;
+		}
+		return out - start;
+	}
+
+	/**
+	* @brief Decode a string base64 encoded and return a raw buffer
+	*
+	* The function allocate a buffer with size decodedSize(text)
+	* and return the pointer. The caller has the ownership of the
+	* pointer.
+	* Use is_base_64 for test if a string is Base64 well formed.
+	*
+	* @param text the base64 string encoded
+	* @param buf_ptr a previously allocated block of memory to receive
+	* the decoded data, at least decodedSize(text) long. If NULL or not set,
+	* the function allocates memory and the caller is reponsible for deallocation
+	*
+	* @return the pointer to the decoded buffer
+	*/
+	static uint8_t * decode(const std::string& text, uint8_t * buf_ptr = NULL )
+	{
+		// Allocate output buffer
+		if (!buf_ptr) {
+			buf_ptr = new uint8_t[decodedSize(text)];
+		}
+		decode(text.data(), text.size(), buf_ptr);
+		return buf_ptr;
+	}
+
+	/**
+	* @brief Decode base64 text into a caller provided buffer
+	*
+	* Trailing padding characters are optional. Invalid characters are
+	* decoded as zero bits.
+	* 16 characters are decoded at a time when SSSE3 is available.
+	*
+	* @param text pointer to the base64 encoded text
+	* @param length length of the text
+	* @param out destination buffer, at least decodedSize(text, length) long
+	*
+	* @return the number of bytes written
+	*/
+	static size_t decode(const char* text, size_t length, uint8_t* out)
+	{
+		// Padding characters are only allowed in the last group
+		while (length && (text[length - 1] == base64pad) && (length % 4 != 1))
+		{
+			--length;
+		}
+		const char* last = text + length;
+		uint8_t* start = out;
+
+#if defined( JRTTI_SSSE3 )
+		for (; last - text >= 16; text += 16, out += 12)
+		{
+			if (!decode16(_mm_loadu_si128((const __m128i*)text), out))
+			{
+				decodeGroups(text, 16, out);
+			}
+		}
+#endif
+		out += decodeGroups(text, last - text, out);
+		return out - start;
+	}
+
+	/**
+	* @brief Compute size of the base64 encoded representation
+	*
+	* @param buf_size size of the buffer to encode
+	* @return the number of characters of the encoded text, padding included
+	*/
+	static size_t encodedSize(size_t buf_size)
+	{
+		return (buf_size + 2) / 3 * 4;
+	}
+
+	/**
+	* @brief Compute size of decoded data
+	*
+	* @param text pointer to the base64 encoded text
+	* @param length length of the text
+	* @return the exact size of the decoded data
+	*/
+	static size_t decodedSize(const char* text, size_t length)
+	{
+		while (length && (text[length - 1] == base64pad) && (length % 4 != 1))
+		{
+			--length;
+		}
+		return length / 4 * 3 + ((length % 4) ? (length % 4) - 1 : 0);
+	}
+
+	/**
+	* @brief Compute size of decoded data
+	*
+	* @param text the base64 encoded text
+	* @return the exact size of the decoded data
+	*/
+	static size_t decodedSize(const std::string& text)
+	{
+		return decodedSize(text.data(), text.size());
+	}
+
+	/**
+	* @brief Chunk by chunk base64 encoder
+	*
+	* Encodes a stream of data given in chunks of any size. Bytes not
+	* completing a group of 3 are kept until next chunk.
+	*/
+	class Encoder {
+	public:
+		Encoder()
+			: m_pending(0)
+		{}
+
+		/**
+		* @brief Encode a chunk of data
+		*
+		* @param buf_ptr pointer to the chunk
+		* @param buf_size size of the chunk
+		* @param out destination buffer, at least encodedSize(buf_size + 2) long
+		*
+		* @return the number of characters written
+		*/
+		size_t update(const uint8_t* buf_ptr, size_t buf_size, char* out)
+		{
+			char* start = out;
+			if (m_pending)
+			{
+				while (m_pending < 3 && buf_size)
+				{
+					m_buffer[m_pending++] = *buf_ptr++;
+					--buf_size;
+				}
+				if (m_pending < 3)
+				{
+					return 0;
+				}
+				out += Base64::encode(m_buffer, 3, out);
+				m_pending = 0;
+			}
+			const size_t whole = buf_size / 3 * 3;
+			out += Base64::encode(buf_ptr, whole, out);
+			for (buf_ptr += whole; m_pending < buf_size - whole; ++m_pending)
+			{
+				m_buffer[m_pending] = buf_ptr[m_pending];
+			}
+			return out - start;
+		}
+
+		/**
+		* @brief Encode the bytes kept from the last chunk, adding padding
+		*
+		* @param out destination buffer, at least 4 characters long
+		*
+		* @return the number of characters written
+		*/
+		size_t finish(char* out)
+		{
+			const size_t written = Base64::encode(m_buffer, m_pending, out);
+			m_pending = 0;
+			return written;
+		}
+
+	private:
+		uint8_t	m_buffer[3];
+		size_t	m_pending;
+	};
+
+	/**
+	* @brief Chunk by chunk base64 decoder
+	*
+	* Decodes a stream of base64 text given in chunks of any size. Characters
+	* not completing a group of 4 are kept until next chunk.
+	*/
+	class Decoder {
+	public:
+		Decoder()
+			: m_pending(0)
+		{}
+
+		/**
+		* @brief Decode a chunk of base64 text
+		*
+		* @param text pointer to the chunk
+		* @param length length of the chunk
+		* @param out destination buffer, at least (length + 3) / 4 * 3 long
+		*
+		* @return the number of bytes written
+		*/
+		size_t update(const char* text, size_t length, uint8_t* out)
+		{
+			uint8_t* start = out;
+			if (m_pending)
+			{
+				while (m_pending < 4 && length)
+				{
+					m_buffer[m_pending++] = *text++;
+					--length;
+				}
+				if (m_pending < 4)
+				{
+					return 0;
+				}
+				out += Base64::decode(m_buffer, 4, out);
+				m_pending = 0;
+			}
+			const size_t whole = length / 4 * 4;
+			out += Base64::decode(text, whole, out);
+			for (text += whole; m_pending < length - whole; ++m_pending)
+			{
+				m_buffer[m_pending] = text[m_pending];
+			}
+			return out - start;
+		}
+
+		/**
+		* @brief Decode the characters kept from the last chunk, if unpadded
+		*
+		* @param out destination buffer, at least 2 bytes long
+		*
+		* @return the number of bytes written
+		*/
+		size_t finish(uint8_t* out)
+		{
+			const size_t written = Base64::decode(m_buffer, m_pending, out);
+			m_pending = 0;
+			return written;
+		}
+
+	private:
+		char	m_buffer[4];
+		size_t	m_pending;
+	};
+
+private:
+	static const uint8_t* decodeTable()
+	{
+		static const uint8_t table[256] = {
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+			 52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+			255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+			 15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+			255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+			 41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+		};
+		return table;
+	}
+
+	/* *
+	* @brief Decode whole groups of 4 characters and an unpadded tail of 2 or 3
+	*/
+	static size_t decodeGroups(const char* text, size_t length, uint8_t* out)
+	{
+		const uint8_t* table = decodeTable();
+		uint32_t n = 0;
+		size_t count = 0;
+		size_t written = 0;
+		for (size_t i = 0; i < length; ++i)
+		{
+			const uint8_t value = table[(uint8_t)text[i]];
+			n = (n << 6) | (value < 64 ? value : 0);
+			if (++count == 4)
+			{
+				out[written++] = (uint8_t)(n >> 16);
+				out[written++] = (uint8_t)(n >> 8);
+				out[written++] = (uint8_t)n;
+				n = 0;
+				count = 0;
+			}
+		}
+		if (count > 1)
+		{
+			n <<= 6 * (4 - count);
+			out[written++] = (uint8_t)(n >> 16);
+			if (count > 2)
+			{
+				out[written++] = (uint8_t)(n >> 8);
+			}
+		}
+		return written;
+	}
+
+#if defined( JRTTI_SSSE3 )
+	/* *
+	* @brief Encode the first 12 bytes of a vector into 16 characters
+	*/
+	static __m128i encode12(__m128i in)
+	{
+		// Split every 3 bytes into 4 indices of 6 bits, one per byte
+		in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		const __m128i ac = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+		const __m128i bd = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+		const __m128i indices = _mm_or_si128(ac, bd);
+
+		// Offset from index to character, by range: A-Z, a-z, 0-9, + and /
+		__m128i offset = _mm_set1_epi8('A');
+		offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(indices, _mm_set1_epi8(25)), _mm_set1_epi8('a' - 26 - 'A')));
+		offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(indices, _mm_set1_epi8(51)), _mm_set1_epi8('0' - 52 - 'a' + 26)));
+		offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpeq_epi8(indices, _mm_set1_epi8(62)), _mm_set1_epi8('+' - 62 - '0' + 52)));
+		offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpeq_epi8(indices, _mm_set1_epi8(63)), _mm_set1_epi8('/' - 63 - '0' + 52)));
+		return _mm_add_epi8(indices, offset);
+	}
+
+	/* *
+	* @brief Decode 16 characters into 12 bytes
+	*
+	* @return false if there are invalid characters, writing nothing
+	*/
+	static bool decode16(__m128i in, uint8_t* out)
+	{
+		// Offset from character to index, by range: A-Z, a-z, 0-9, + and /
+		const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), in));
+		const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), in));
+		const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), in));
+		const __m128i plus = _mm_cmpeq_epi8(in, _mm_set1_epi8('+'));
+		const __m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+		const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, plus), slash));
+		if (_mm_movemask_epi8(valid) != 0xFFFF)
+		{
+			return false;
+		}
+		__m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+		offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+		offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+		offset = _mm_or_si128(offset, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+		offset = _mm_or_si128(offset, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+		const __m128i indices = _mm_add_epi8(in, offset);
+
+		// Join every 4 indices of 6 bits into 3 bytes
+		const __m128i pairs = _mm_maddubs_epi16(indices, _mm_set1_epi32(0x01400140));
+		const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+		const __m128i bytes = _mm_shuffle_epi8(groups, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+		_mm_storel_epi64((__m128i*)out, bytes);
+		const uint32_t tail = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+		std::memcpy(out + 8, &tail, 4);
+		return true;
+	}
+#endif
+
+	/* *
+	* @brief Test if a string is well Base64 encoded
+	*
+	* @param text the string Base64 encoded
+	*
+	* @return true if the string is well formed
+	*/
+	static bool isBase64(const std::string& text)
+	{
+		// Create the decode matrix
+		uint8_t decode_base64chars[256];
+		std::memset (decode_base64chars, 65, 256);
+
+		for (uint8_t i = 0; i <= 63; i++)
+		{
+			decode_base64chars[(int)base64chars[(int)i]] = i;
+		}
+
+		// Add padding character
+		decode_base64chars[(int)'='] = 64;
+
+		// Test string characters
+		for (size_t i = 0; i < text.size(); i++)
+		{
+			if (decode_base64chars[(int)text[i]] == 65)
+			{
+				// Invalid character found
+				return false;
+			}
+			else if ((decode_base64chars[(int)text[i]] == 64) && (i < text.size() - 3))
+			{
+				// Padding character at invalid position
+				return false;
+			}
+		}
+
+		return true;
+	}
+};
+
+};
+
+#endif /*BASE64_H_*/
@@ -1,479 +1,590 @@
-#ifndef jrttibasetypesH
-#define jrttibasetypesH
-
-#include <sstream>
-#include <iomanip>
-#include "metatype.hpp"
-
-namespace jrtti {
-
-class MetaPointerType: public Metatype {
-public:
-	MetaPointerType ( const std::type_info& typeinfo, Metatype & baseType )
-		:	Metatype( typeinfo ),
-			m_baseType(baseType)
-	{}
-
-	virtual
-	boost::any
-	create() {
-		return m_baseType.create();
-	}
-
-	bool
-	isPointer() const {
-		return true;
-	}
-
-	bool
-	isAbstract() const {
-		return m_baseType.isAbstract();
-	}
-
-	bool 
-	isCollection() const {
-		return m_baseType.isCollection();
-	}
-
-protected:
-	Metatype *
-	pointerMetatype() {
-		return this;
-	}
-
-	PropertyMap &
-	_properties() {
-		return m_baseType._properties();
-	}
-
-	MethodMap&
-	_methods() {
-		return m_baseType._methods();
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		void * inst = get_instance_ptr(value);
-
-		if ( !inst )
-			return "NULL";
-
-		AddressRefMap::iterator it = _addressRefMap().find( inst );
-		if ( it == _addressRefMap().end() ) {
-			return Metatype::_toStr( value, formatForStreaming );
-		}
-		else {
-			if ( formatForStreaming )
-				return "{\n\t\"$ref\": \"" + it->second + "\"\n}";
-			else 
-				return "{}";
-		}
-	}
-
-	virtual
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-		JSONParser parser( str );
-		boost::any any_ptr;
-
-		if ( str == "NULL" ) {
-			any_ptr = createAsNullPtr();
-		}
-		else {
-			if ( parser.begin()->first == "$ref" ) {
-				void * ptr = _nameRefMap()[ parser.begin()->second ];
-				any_ptr = m_baseType.copyFromInstanceAsPtr( ptr );
-			}
-			else {
-				if ( jrtti_cast< void * >(instance) ) {
-					any_ptr = instance;
-				}
-				else {
-					any_ptr = create();
-				}
-				Metatype::_fromStr( any_ptr, str );
-			}
-		}
-		return any_ptr;
-	}
-
-	virtual
-	void *
-	get_instance_ptr( const boost::any & value ) {
-		if ( value.type() == typeid( void * ) ) {
-			return boost::any_cast< void * >( value );
-		}
-		else {
-			return m_baseType.get_instance_ptr( value );
-		}
-	}
-
-	virtual
-	boost::any
-	createAsNullPtr() {
-		return m_baseType.createAsNullPtr();
-	}
-
-private:
-	Metatype & m_baseType;
-};
-
-// predefined types
-
-class MetaBool: public Metatype {
-public:
-	MetaBool(): Metatype( typeid( bool ) ) {}
-
-	virtual
-	bool
-	isFundamental() const {
-		return true;
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		return boost::any_cast<bool>(value) ? "true" : "false";
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-
-		return str[0] == 't';
-	}
-
-	virtual
-	boost::any
-	create() {
-		return new bool;
-	}
-};
-
-class MetaChar: public Metatype {
-public:
-	MetaChar(): Metatype( typeid( char ) ) {}
-
-	virtual
-	bool
-	isFundamental() const {
-		return true;
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		return numToStr(boost::any_cast<char>(value));
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-		return strToNum<char>( str );
-	}
-
-	virtual
-	boost::any
-	create()
-	{
-		return new char;
-	}
-};
-
-class MetaShort: public Metatype {
-public:
-	MetaShort(): Metatype( typeid( short ) ) {}
-
-	virtual
-	bool
-	isFundamental() const {
-		return true;
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		return numToStr(boost::any_cast<short>(value));
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-
-		return strToNum<short>( str );
-	}
-
-	virtual
-	boost::any
-	create()
-	{
-		return new short;
-	}
-};
-
-class MetaInt: public Metatype {
-public:
-	MetaInt(): Metatype( typeid( int ) ) {}
-
-	virtual
-	bool
-	isFundamental() const {
-		return true;
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		return numToStr(boost::any_cast<int>(value));
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-
-		return strToNum<int>( str );
-	}
-
-	virtual
-	boost::any
-	create()
-	{
-		return new int;
-	}
-};
-
-class MetaLong: public Metatype {
-public:
-	MetaLong(): Metatype( typeid( long ) ) {}
-
-	virtual
-	bool
-	isFundamental() const {
-		return true;
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		return numToStr(boost::any_cast<long>(value));
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-
-		return strToNum<long>( str );
-	}
-
-	virtual
-	boost::any
-	create()
-	{
-		return new long;
-	}
-};
-
-class MetaFloat: public Metatype {
-public:
-	MetaFloat(): Metatype( typeid( float ) ) {}
-
-	virtual
-	bool
-	isFundamental() const {
-		return true;
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		return numToStr(boost::any_cast<float>(value));
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-
-		return strToNum<float>( str );
-	}
-
-	virtual
-	boost::any
-	create() {
-		return new float;
-	}
-};
-
-
-class MetaDouble: public Metatype {
-public:
-	MetaDouble(): Metatype( typeid( double ) ) {}
-
-	virtual
-	bool
-	isFundamental() const {
-		return true;
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		return numToStr(boost::any_cast<double>(value));
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-
-		return strToNum<double>( str );
-	}
-
-	virtual
-	boost::any
-	create() {
-		return new double;
-	}
-};
-
-class MetaLongDouble: public Metatype {
-public:
-	MetaLongDouble(): Metatype( typeid( long double ) ) {}
-
-	virtual
-	bool
-	isFundamental() const {
-		return true;
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		return numToStr(boost::any_cast<long double>(value));
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-
-		return strToNum<long double>( str );
-	}
-
-	virtual
-	boost::any
-	create() {
-		return new long double;
-	}
-};
-
-class MetaWchar_t: public Metatype {
-public:
-	MetaWchar_t(): Metatype( typeid(wchar_t ) ) {}
-
-	virtual
-	bool
-	isFundamental() const {
-		return true;
-	}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		return numToStr((int)boost::any_cast<wchar_t>(value));
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-		int dummy = strToNum<int>( str );
-		return (wchar_t)dummy;
-	}
-
-	virtual
-	boost::any
-	create() {
-		return new wchar_t;
-	}
-};
-
-class MetaString: public Metatype {
-public:
-	MetaString(): Metatype( typeid( std::string ) ) {}
-
-	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ) {
-		return '"' + addEscapeSeq( boost::any_cast<std::string>(value) ) + '"';
-	}
-
-	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-
-		return removeEscapeSeq( str );
-	}
-
-	virtual
-	boost::any
-	create() {
-		return new std::string();
-	}
-private:
-	std::string
-	addEscapeSeq( const std::string& s ) {
-		std::ostringstream ss;
-		for (std::string::const_iterator iter = s.begin(); iter != s.end(); ++iter) {
-			switch (*iter) {
-				case '"': ss << "\\\""; break;
-				case '\\': ss << "\\\\"; break;
-				case '/': ss << "\\/"; break;
-				case '\b': ss << "\\b"; break;
-				case '\f': ss << "\\f"; break;
-				case '\n': ss << "\\n"; break;
-				case '\r': ss << "\\r"; break;
-				case '\t': ss << "\\t"; break;
-				default: {
-					if ( *iter < 0x20 ) {
-						ss << "\\u" << std::setfill('0') << std::setw(4) << std::hex << unsigned( *iter );
-					}
-					else {
-						ss << *iter;
-					}
-					break;
-				}
-			}
-		}
-		std::string ret = ss.str();
-		return ss.str();
-	}
-
-	std::string
-	removeEscapeSeq( const std::string& s ) {
-		std::stringstream ss;
-		for (std::string::const_iterator iter = s.begin(); iter != s.end(); ++iter) {
-			if ( *iter == '\\' )
-			{
-				switch ( *( ++iter ) ) {
-					case 'b' : ss << '\b'; break;
-					case 'f' : ss << '\f'; break;
-					case 'n' : ss << '\n'; break;
-					case 'r' : ss << '\r'; break;
-					case 't' : ss << '\t'; break;
-					case 'u' : {
-						std::string num;
-						for ( size_t i = 0; i<4; ++i,iter++ ) {
-							 num+= *(iter + 1);
-						}
-						std::stringstream d;
-						d << std::hex << num;
-						int n;
-						d >> n;
-						ss << char(n);
-						break;
-					}
-					default: ss << *iter; break;
-				}
-			}
-			else {
-				ss << *iter;
-			}
-		}
-		return ss.str();
-    }
-};
-
-//------------------------------------------------------------------------------
-
-}; //namespace jrtti
-#endif  //jrttibasetypesH
-
-
+#ifndef jrttibasetypesH
+#define jrttibasetypesH
+
+#include <sstream>
+#include "metatype.hpp"
+
+namespace jrtti {
+
+class MetaPointerType: public Metatype {
+public:
+	MetaPointerType ( const std::type_info& typeinfo, Metatype & baseType )
+		:	Metatype( typeinfo ),
+			m_baseType(baseType)
+	{}
+
+	virtual
+	boost::any
+	create() {
+		return m_baseType.create();
+	}
+
+	virtual
+	boost::any
+	createIn( ObjectArena& arena ) {
+		return m_baseType.createIn( arena );
+	}
+
+	virtual
+	void
+	destroy( const boost::any& instance ) {
+		m_baseType.destroy( instance );
+	}
+
+	virtual
+	void
+	enablePool( size_t batchSize = 64 ) {
+		m_baseType.enablePool( batchSize );
+	}
+
+	bool
+	isPointer() const {
+		return true;
+	}
+
+	bool
+	isAbstract() const {
+		return m_baseType.isAbstract();
+	}
+
+	bool 
+	isCollection() const {
+		return m_baseType.isCollection();
+	}
+
+protected:
+	Metatype *
+	pointerMetatype() {
+		return this;
+	}
+
+	PropertyMap &
+	_properties() {
+		return m_baseType._properties();
+	}
+
+	MethodMap&
+	_methods() {
+		return m_baseType._methods();
+	}
+
+	const SerializationPlan&
+	_plan() {
+		return m_baseType._plan();
+	}
+
+	const NameIndex< Property >&
+	_propertyIndex() {
+		return m_baseType._propertyIndex();
+	}
+
+	const NameIndex< Method >&
+	_methodIndex() {
+		return m_baseType._methodIndex();
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		void * inst = get_instance_ptr(value);
+
+		if ( !inst ) {
+			writer.raw( "NULL" );
+			return;
+		}
+
+		size_t id;
+		if ( !writer.context().findId( inst, id ) ) {
+			Metatype::_toStr( writer, value, formatForStreaming );
+		}
+		else {
+			if ( formatForStreaming ) {
+				writer.openObject();
+				writer.beginMember( "$ref" );
+				writer.id( id );
+				writer.endMember();
+				writer.closeObject();
+			}
+			else
+				writer.raw( "{}" );
+		}
+	}
+
+	virtual
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		boost::any any_ptr;
+
+		if ( reader.peek() != '{' ) {
+			reader.scalar();		// NULL
+			any_ptr = createAsNullPtr();
+		}
+		else {
+			size_t mark = reader.position();
+			JSONSpan key;
+			reader.beginObject();
+			if ( reader.nextMember( key ) && reader.equals( key, "$ref" ) ) {
+				const JSONSpan id = reader.stringSpan();
+				void * ptr = reader.context().nameRefs().find( reader.data( id ), id.length );
+				reader.endObject();
+				any_ptr = m_baseType.copyFromInstanceAsPtr( ptr );
+			}
+			else {
+				reader.position( mark );
+				if ( jrtti_cast< void * >(instance) ) {
+					any_ptr = instance;
+				}
+				else {
+					any_ptr = createFor( reader.context() );
+				}
+				Metatype::_fromStr( reader, any_ptr );
+			}
+		}
+		return any_ptr;
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		void * inst = get_instance_ptr(value);
+		size_t id;
+
+		if ( !inst ) {
+			writer.null();
+		}
+		else if ( writer.findRef( inst, id ) ) {
+			writer.ref( id );
+		}
+		else {
+			Metatype::_toBinary( writer, value );
+		}
+	}
+
+	virtual
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		boost::any any_ptr;
+
+		switch ( reader.peekTag() ) {
+			case binNull:
+				reader.readTag();
+				any_ptr = createAsNullPtr();
+				break;
+			case binRef:
+				any_ptr = m_baseType.copyFromInstanceAsPtr( reader.ref() );
+				break;
+			default:
+				if ( jrtti_cast< void * >(instance) ) {
+					any_ptr = instance;
+				}
+				else {
+					any_ptr = create();
+				}
+				Metatype::_fromBinary( reader, any_ptr );
+		}
+		return any_ptr;
+	}
+
+	virtual
+	void *
+	get_instance_ptr( const boost::any & value ) {
+		if ( value.type() == typeid( void * ) ) {
+			return boost::any_cast< void * >( value );
+		}
+		else {
+			return m_baseType.get_instance_ptr( value );
+		}
+	}
+
+	virtual
+	boost::any
+	createAsNullPtr() {
+		return m_baseType.createAsNullPtr();
+	}
+
+private:
+	Metatype & m_baseType;
+};
+
+// predefined types
+
+/**
+ * \brief Base of the predefined metatypes
+ *
+ * Creates and destroys the values of type T, taking them from a pool once
+ * enablePool is called.
+ * \tparam T the value type
+ */
+template< typename T >
+class MetaBasicType: public Metatype {
+public:
+	MetaBasicType(): Metatype( typeid( T ) ) {}
+
+	virtual
+	boost::any
+	create() {
+		return m_pool.create();
+	}
+
+	virtual
+	boost::any
+	createIn( ObjectArena& arena ) {
+		return arena.create< T >();
+	}
+
+	virtual
+	void
+	destroy( const boost::any& instance ) {
+		m_pool.destroy( jrtti_cast< T * >( instance ) );
+	}
+
+	virtual
+	void
+	enablePool( size_t batchSize = 64 ) {
+		m_pool.enable( batchSize );
+	}
+
+private:
+	__PoolSlot< T >	m_pool;
+};
+
+class MetaBool: public MetaBasicType< bool > {
+public:
+	MetaBool() {}
+
+	virtual
+	bool
+	isFundamental() const {
+		return true;
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.raw( boost::any_cast<bool>(value) ? "true" : "false" );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+
+		return reader.scalar()[0] == 't';
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.boolean( boost::any_cast< bool >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.boolean();
+	}
+};
+
+class MetaChar: public MetaBasicType< char > {
+public:
+	MetaChar() {}
+
+	virtual
+	bool
+	isFundamental() const {
+		return true;
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.raw( boost::any_cast<char>(value) );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return strToNum<char>( reader.scalar() );
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.integer( boost::any_cast< char >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.number< char >();
+	}
+};
+
+class MetaShort: public MetaBasicType< short > {
+public:
+	MetaShort() {}
+
+	virtual
+	bool
+	isFundamental() const {
+		return true;
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.number( boost::any_cast<short>(value) );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+
+		return reader.number< short >();
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.integer( boost::any_cast< short >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.number< short >();
+	}
+};
+
+class MetaInt: public MetaBasicType< int > {
+public:
+	MetaInt() {}
+
+	virtual
+	bool
+	isFundamental() const {
+		return true;
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.number( boost::any_cast<int>(value) );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+
+		return reader.number< int >();
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.integer( boost::any_cast< int >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.number< int >();
+	}
+};
+
+class MetaLong: public MetaBasicType< long > {
+public:
+	MetaLong() {}
+
+	virtual
+	bool
+	isFundamental() const {
+		return true;
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.number( boost::any_cast<long>(value) );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+
+		return reader.number< long >();
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.integer( boost::any_cast< long >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.number< long >();
+	}
+};
+
+class MetaFloat: public MetaBasicType< float > {
+public:
+	MetaFloat() {}
+
+	virtual
+	bool
+	isFundamental() const {
+		return true;
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.number( boost::any_cast<float>(value) );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+
+		return reader.number< float >();
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.real( boost::any_cast< float >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.number< float >();
+	}
+};
+
+
+class MetaDouble: public MetaBasicType< double > {
+public:
+	MetaDouble() {}
+
+	virtual
+	bool
+	isFundamental() const {
+		return true;
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.number( boost::any_cast<double>(value) );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+
+		return reader.number< double >();
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.real( boost::any_cast< double >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.number< double >();
+	}
+};
+
+class MetaLongDouble: public MetaBasicType< long double > {
+public:
+	MetaLongDouble() {}
+
+	virtual
+	bool
+	isFundamental() const {
+		return true;
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.number( boost::any_cast<long double>(value) );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+
+		return reader.number< long double >();
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.real( boost::any_cast< long double >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.number< long double >();
+	}
+};
+
+class MetaWchar_t: public MetaBasicType< wchar_t > {
+public:
+	MetaWchar_t() {}
+
+	virtual
+	bool
+	isFundamental() const {
+		return true;
+	}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.number( (int)boost::any_cast<wchar_t>(value) );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		int dummy = reader.number< int >();
+		return (wchar_t)dummy;
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.integer( boost::any_cast< wchar_t >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.number< wchar_t >();
+	}
+};
+
+class MetaString: public MetaBasicType< std::string > {
+public:
+	MetaString() {}
+
+	virtual
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ) {
+		writer.string( boost::any_cast< const std::string& >( value ) );
+	}
+
+	boost::any
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+
+		return reader.string();
+	}
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.string( boost::any_cast< std::string >( value ) );
+	}
+
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		return reader.string();
+	}
+};
+
+//------------------------------------------------------------------------------
+
+}; //namespace jrtti
+#endif  //jrttibasetypesH
+
+
@@ -0,0 +1,591 @@
+#ifndef jrttibinaryH
+#define jrttibinaryH
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstring>
+#include <stdint.h>
+#include "exception.hpp"
+#include "refmaps.hpp"
+
+namespace jrtti {
+
+/**
+ * \brief Value tags of the binary representation
+ *
+ * Every value of the binary representation starts with one of these tags.
+ * Integers are stored as zigzag varints, floating point numbers as little
+ * endian IEEE values and strings as a varint length followed by their bytes.
+ * Objects are a sequence of members ended by a zero name code. Member names
+ * are stored once per document and referenced by index afterwards. Every
+ * object is implicitly numbered in document order, and later occurrences of
+ * the same object are stored as a reference to that number.
+ */
+enum BinaryTag {
+	binNull = 0,
+	binFalse,
+	binTrue,
+	binInteger,
+	binFloat,
+	binDouble,
+	binLongDouble,
+	binString,
+	binObject,
+	binRef,
+	binCollection,
+	binArray,
+	binTyped
+};
+
+/**
+ * \brief Output sink for binary representations
+ *
+ * Metatypes append their binary representation into the buffer of a
+ * BinaryWriter while traversing an object graph.
+ * \sa BinaryTag
+ */
+class BinaryWriter {
+public:
+	BinaryWriter()
+		:	m_refCount( 0 )
+	{
+		m_buffer.append( signature(), signatureLength() );
+	}
+
+	/**
+	 * \brief Retrieves the written buffer
+	 * \return the binary data written so far
+	 */
+	std::string&
+	str() {
+		return m_buffer;
+	}
+
+	/**
+	 * \brief Writes a value tag
+	 * \param t the tag
+	 */
+	void
+	tag( BinaryTag t ) {
+		m_buffer += (char)t;
+	}
+
+	/**
+	 * \brief Writes a boolean value
+	 * \param value the value
+	 */
+	void
+	boolean( bool value ) {
+		tag( value ? binTrue : binFalse );
+	}
+
+	/**
+	 * \brief Writes an integer value
+	 * \param value the value
+	 */
+	void
+	integer( int64_t value ) {
+		tag( binInteger );
+		varint( ( (uint64_t)value << 1 ) ^ (uint64_t)( value >> 63 ) );
+	}
+
+	/**
+	 * \brief Writes a float value
+	 * \param value the value
+	 */
+	void
+	real( float value ) {
+		uint32_t bits;
+		std::memcpy( &bits, &value, sizeof( bits ) );
+		tag( binFloat );
+		fixed( bits, sizeof( bits ) );
+	}
+
+	/**
+	 * \brief Writes a double value
+	 * \param value the value
+	 */
+	void
+	real( double value ) {
+		uint64_t bits;
+		std::memcpy( &bits, &value, sizeof( bits ) );
+		tag( binDouble );
+		fixed( bits, sizeof( bits ) );
+	}
+
+	/**
+	 * \brief Writes a long double value
+	 *
+	 * Long doubles are stored as their native bytes, preceded by their size.
+	 * Reading them on a platform with a different long double size fails.
+	 * \param value the value
+	 */
+	void
+	real( long double value ) {
+		long double native;
+		std::memset( &native, 0, sizeof( native ) );		// keep padding bytes deterministic
+		native = value;
+		tag( binLongDouble );
+		m_buffer += (char)sizeof( native );
+		m_buffer.append( (const char *)&native, sizeof( native ) );
+	}
+
+	/**
+	 * \brief Writes a string value
+	 * \param value the value
+	 */
+	void
+	string( const std::string& value ) {
+		tag( binString );
+		varint( value.length() );
+		m_buffer += value;
+	}
+
+	/**
+	 * \brief Writes a null pointer
+	 */
+	void
+	null() {
+		tag( binNull );
+	}
+
+	/**
+	 * \brief Looks for an already written object
+	 * \param inst the object address
+	 * \param id receives the object number if found
+	 * \return true if the object was already written
+	 */
+	bool
+	findRef( void * inst, size_t& id ) {
+		return m_refs.find( inst, id );
+	}
+
+	/**
+	 * \brief Writes a reference to an already written object
+	 * \param id the object number
+	 */
+	void
+	ref( size_t id ) {
+		tag( binRef );
+		varint( id );
+	}
+
+	/**
+	 * \brief Starts an object and assigns it the next object number
+	 * \param inst the object address, NULL if the object can not be referenced
+	 */
+	void
+	beginObject( void * inst ) {
+		tag( binObject );
+		if ( inst ) {
+			m_refs.insert( inst, m_refCount );
+		}
+		++m_refCount;
+	}
+
+	/**
+	 * \brief Writes the name of an object member
+	 * \param name the member name
+	 */
+	void
+	member( const std::string& name ) {
+		std::map< std::string, size_t >::iterator it = m_names.find( name );
+		if ( it == m_names.end() ) {
+			m_names.insert( std::make_pair( name, m_names.size() ) );
+			varint( ( name.length() << 1 ) | 1 );
+			m_buffer += name;
+		}
+		else {
+			varint( ( it->second + 1 ) << 1 );
+		}
+	}
+
+	/**
+	 * \brief Ends an object
+	 */
+	void
+	endObject() {
+		varint( 0 );
+	}
+
+	/**
+	 * \brief Starts an array of elements
+	 * \param count number of elements in the array
+	 */
+	void
+	beginArray( size_t count ) {
+		tag( binArray );
+		varint( count );
+	}
+
+	/**
+	 * \brief Writes the type name of the following value
+	 * \param typeName the type name
+	 */
+	void
+	typed( const std::string& typeName ) {
+		tag( binTyped );
+		varint( typeName.length() );
+		m_buffer += typeName;
+	}
+
+	/**
+	 * \brief Leading bytes of every binary representation
+	 *
+	 * They identify the format and its version.
+	 */
+	static
+	const char *
+	signature() {
+		return "jr\x01";
+	}
+
+	static
+	size_t
+	signatureLength() {
+		return 3;
+	}
+
+private:
+	void
+	varint( uint64_t value ) {
+		while ( value >= 0x80 ) {
+			m_buffer += (char)( value | 0x80 );
+			value >>= 7;
+		}
+		m_buffer += (char)value;
+	}
+
+	void
+	fixed( uint64_t value, size_t bytes ) {
+		for ( size_t i = 0; i < bytes; ++i ) {
+			m_buffer += (char)( value >> ( i * 8 ) );
+		}
+	}
+
+	std::string						m_buffer;
+	AddressRefMap					m_refs;
+	size_t							m_refCount;
+	std::map< std::string, size_t >	m_names;
+};
+
+/**
+ * \brief Cursor over a binary representation
+ *
+ * Metatypes read their binary representation through a BinaryReader while
+ * filling an object graph.
+ * The reader keeps a pointer to the input data, which should outlive it.
+ * \sa BinaryTag
+ */
+class BinaryReader {
+public:
+	/**
+	 * \brief Constructor
+	 * \param data the binary data to read
+	 * \throw Error if data is not a jrtti binary representation
+	 */
+	BinaryReader( const std::string& data )
+		:	m_end( data.data() + data.length() ),
+			m_pos( data.data() )
+	{
+		if ( data.length() < BinaryWriter::signatureLength() || std::memcmp( m_pos, BinaryWriter::signature(), BinaryWriter::signatureLength() ) ) {
+			error( "unknown format" );
+		}
+		m_pos += BinaryWriter::signatureLength();
+	}
+
+	/**
+	 * \brief Returns the tag of the next value without consuming it
+	 * \return the tag
+	 */
+	BinaryTag
+	peekTag() {
+		need( 1 );
+		return (BinaryTag)*m_pos;
+	}
+
+	/**
+	 * \brief Consumes the tag of the next value
+	 * \return the tag
+	 */
+	BinaryTag
+	readTag() {
+		BinaryTag t = peekTag();
+		++m_pos;
+		return t;
+	}
+
+	/**
+	 * \brief Consumes the tag of the next value
+	 * \param t the expected tag
+	 * \throw Error if the tag is not the expected one
+	 */
+	void
+	expect( BinaryTag t ) {
+		if ( readTag() != t ) {
+			error( "unexpected value" );
+		}
+	}
+
+	/**
+	 * \brief Reads a boolean value
+	 * \return the value
+	 */
+	bool
+	boolean() {
+		switch ( readTag() ) {
+			case binTrue: return true;
+			case binFalse: return false;
+			default: error( "boolean expected" );
+		}
+		return false;
+	}
+
+	/**
+	 * \brief Reads a number
+	 *
+	 * Any number stored in the binary representation is converted to T
+	 * \tparam T the type of the number
+	 * \return the number
+	 */
+	template< typename T >
+	T
+	number() {
+		switch ( readTag() ) {
+			case binInteger: {
+				uint64_t v = varint();
+				return (T)(int64_t)( ( v >> 1 ) ^ ( 0 - ( v & 1 ) ) );
+			}
+			case binFloat: {
+				uint32_t bits = (uint32_t)fixed( sizeof( bits ) );
+				float f;
+				std::memcpy( &f, &bits, sizeof( f ) );
+				return (T)f;
+			}
+			case binDouble: {
+				uint64_t bits = fixed( sizeof( bits ) );
+				double d;
+				std::memcpy( &d, &bits, sizeof( d ) );
+				return (T)d;
+			}
+			case binLongDouble: {
+				if ( longDoubleSize() != sizeof( long double ) ) {
+					error( "unsupported long double size" );
+				}
+				long double ld;
+				std::memcpy( &ld, m_pos, sizeof( ld ) );
+				m_pos += sizeof( ld );
+				return (T)ld;
+			}
+			case binFalse: return (T)0;
+			case binTrue: return (T)1;
+			default:
+				error( "number expected" );
+		}
+		return T();
+	}
+
+	/**
+	 * \brief Reads a string value
+	 * \return the string
+	 */
+	std::string
+	string() {
+		expect( binString );
+		return bytes();
+	}
+
+	/**
+	 * \brief Reads the type name of the following value
+	 * \return the type name
+	 */
+	std::string
+	typed() {
+		expect( binTyped );
+		return bytes();
+	}
+
+	/**
+	 * \brief Starts an object and assigns it the next object number
+	 * \param inst the address of the object being filled
+	 */
+	void
+	beginObject( void * inst ) {
+		expect( binObject );
+		m_refs.push_back( inst );
+	}
+
+	/**
+	 * \brief Moves to the next member of the current object
+	 * \param name receives the member name
+	 * \return false if the end of the object was reached
+	 */
+	bool
+	nextMember( std::string& name ) {
+		uint64_t code = varint();
+		if ( code == 0 ) {
+			return false;
+		}
+		if ( code & 1 ) {
+			size_t length = (size_t)( code >> 1 );
+			need( length );
+			m_names.push_back( std::string( m_pos, length ) );
+			m_pos += length;
+			name = m_names.back();
+		}
+		else {
+			size_t index = (size_t)( code >> 1 ) - 1;
+			if ( index >= m_names.size() ) {
+				error( "unknown member name" );
+			}
+			name = m_names[ index ];
+		}
+		return true;
+	}
+
+	/**
+	 * \brief Reads a reference to an already read object
+	 * \return the object address
+	 */
+	void *
+	ref() {
+		expect( binRef );
+		size_t id = (size_t)varint();
+		if ( id >= m_refs.size() ) {
+			error( "unknown reference" );
+		}
+		return m_refs[ id ];
+	}
+
+	/**
+	 * \brief Starts an array of elements
+	 * \return the number of elements in the array
+	 */
+	size_t
+	beginArray() {
+		expect( binArray );
+		return (size_t)varint();
+	}
+
+	/**
+	 * \brief Skips the next value
+	 */
+	void
+	skipValue() {
+		switch ( readTag() ) {
+			case binNull:
+			case binFalse:
+			case binTrue:
+				break;
+			case binInteger:
+			case binRef:
+				varint();
+				break;
+			case binFloat:
+				fixed( 4 );
+				break;
+			case binDouble:
+				fixed( 8 );
+				break;
+			case binLongDouble:
+				m_pos += longDoubleSize();
+				break;
+			case binString:
+				bytes();
+				break;
+			case binTyped:
+				// the type name, then the value written with that type
+				bytes();
+				skipValue();
+				break;
+			case binObject: {
+				m_refs.push_back( NULL );
+				std::string name;
+				while ( nextMember( name ) ) {
+					skipValue();
+				}
+				break;
+			}
+			case binCollection:
+				skipValue();
+				skipValue();
+				break;
+			case binArray: {
+				size_t count = (size_t)varint();
+				for ( size_t i = 0; i < count; ++i ) {
+					skipValue();
+				}
+				break;
+			}
+			default:
+				error( "unknown value" );
+		}
+	}
+
+private:
+	void
+	need( size_t bytes ) {
+		if ( (size_t)( m_end - m_pos ) < bytes ) {
+			error( "unexpected end of data" );
+		}
+	}
+
+	uint64_t
+	varint() {
+		uint64_t value = 0;
+		for ( int shift = 0; shift < 64; shift += 7 ) {
+			need( 1 );
+			unsigned char b = (unsigned char)*m_pos++;
+			value |= (uint64_t)( b & 0x7f ) << shift;
+			if ( !( b & 0x80 ) ) {
+				return value;
+			}
+		}
+		error( "invalid varint" );
+		return 0;
+	}
+
+	// Reads the size of a long double, checking its bytes follow
+	size_t
+	longDoubleSize() {
+		need( 1 );
+		size_t size = (unsigned char)*m_pos++;
+		need( size );
+		return size;
+	}
+
+	uint64_t
+	fixed( size_t bytes ) {
+		need( bytes );
+		uint64_t value = 0;
+		for ( size_t i = 0; i < bytes; ++i ) {
+			value |= (uint64_t)(unsigned char)m_pos[ i ] << ( i * 8 );
+		}
+		m_pos += bytes;
+		return value;
+	}
+
+	std::string
+	bytes() {
+		size_t length = (size_t)varint();
+		need( length );
+		const char * start = m_pos;
+		m_pos += length;
+		return std::string( start, length );
+	}
+
+	void
+	error( const std::string& message ) {
+		throw Error( "Malformed binary data: " + message );
+	}
+
+	const char *				m_end;
+	const char *				m_pos;
+	std::vector< void * >		m_refs;
+	std::vector< std::string >	m_names;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jrttibinaryH
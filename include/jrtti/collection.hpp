@@ -1,209 +1,486 @@
 #ifndef jrtticollectionH
 #define jrtticollectionH
 
+#include <boost/scoped_array.hpp>
 #include "metatype.hpp"
 
 namespace jrtti {
 
-/**
-* \brief Abstraction for a collection type
-*
-* A collection is a secuence of objects, like STL containers.
-* Collections should expose both, an iterator named iterator and a public type
-* exposing the the type of the contained elements named value_type. Additionally should 
-* also expose member functions begin(), end(), clear() and insert().
-* If contained elements are derived objects from a common ancestor, a property named 
-* __typeInfoName shoud be declare to jrtti so jrtti can stream elements properly.
-* This property should return typeid( *this ).name().
-* In esence, a native collection type should implement the provided
-* interface CollectionInterface. Most STL container implementation are compatible
-* with CollectionInterface. That means you can directly use STL containers.
-*
-*/
-template< typename ClassT >
+/**
+* \brief Abstraction for a collection type
+*
+* A collection is a secuence of objects, like STL containers.
+* Collections should expose both, an iterator named iterator and a public type
+* exposing the the type of the contained elements named value_type. Additionally should 
+* also expose member functions begin(), end(), clear() and insert().
+* If contained elements are derived objects from a common ancestor, a property named 
+* __typeInfoName shoud be declare to jrtti so jrtti can stream elements properly.
+* This property should return typeid( *this ).name().
+* In esence, a native collection type should implement the provided
+* interface CollectionInterface. Most STL container implementation are compatible
+* with CollectionInterface. That means you can directly use STL containers.
+*
+*/
+template< typename ClassT >
 class Metacollection: public CustomMetaclass< ClassT > {
-public:
-	Metacollection( const Annotations& annotations = Annotations() ): CustomMetaclass< ClassT >( annotations ) {}
-
-	bool
-	isCollection() const {
-		return true;
-	}
-
-protected:
+public:
+	Metacollection( const Annotations& annotations = Annotations() ): CustomMetaclass< ClassT >( annotations ) {}
+
+	bool
+	isCollection() const {
+		return true;
+	}
+
+protected:
 	virtual
-	std::string
-	_toStr( const boost::any & value, bool formatForStreaming ){
-		std::string props_str = Metatype::_toStr( value, formatForStreaming );
+	void
+	_toStr( JSONWriter& writer, const boost::any & value, bool formatForStreaming ){
+		writer.openObject();
+		writer.beginMember( "properties" );
+		Metatype::_toStr( writer, value, formatForStreaming );
+		writer.endMember();
+		writer.separator();
 		ClassT& _collection = getReference( value );
 
+		writer.beginMember( "elements" );
+		writer.openArray();
+#if defined( JRTTI_HAS_THREADS )
+		if ( writer.context().threads() > 1 ) {
+			writeElementsParallel( writer, _collection, formatForStreaming );
+		}
+		else
+#endif
+		{
+			////////// COMPILER ERROR   //// Collections must declare a iterator type and a begin and end methods. See documentation for details.
+			writeElements( writer, _collection.begin(), _collection.end(), formatForStreaming );
+		}
+		writer.closeArray();
+		writer.endMember();
+		writer.closeObject();
+	}
+
+	void
+	writeElements( JSONWriter& writer, typename ClassT::iterator begin, typename ClassT::iterator end, bool formatForStreaming ) {
 		////////// COMPILER ERROR   //// Collections must declare a value_type type. See documentation for details.
 		Metatype * mt = &jrtti::metatype< typename ClassT::value_type >();
-		std::string str = "[\n";
 		bool need_nl = false;
 
-		////////// COMPILER ERROR   //// Collections must declare a iterator type and a begin and end methods. See documentation for details.
-		for ( typename ClassT::iterator it = _collection.begin() ; it != _collection.end(); ++it ) {
-			if (need_nl) str += ",\n";
-			need_nl = true;
-
-			PropertyMap::iterator pmit = mt->_properties().find( "__typeInfoName" );
-			if ( pmit != mt->_properties().end() ) {
-				mt = &Reflector::instance().metatype( pmit->second->get< std::string >( getElementPtr( *it ) ) );
-			}
-			str += ident( mt->_toStr( *it, formatForStreaming ) );
-		}
-		str += "\n]";
-		return "{\n" + ident( "\"properties\": " +props_str ) + ",\n" + ident( "\"elements\": " + str ) + "\n}";
+		for ( typename ClassT::iterator it = begin; it != end; ++it ) {
+			if (need_nl) writer.separator();
+			need_nl = true;
+
+			PropertyMap::iterator pmit = mt->_properties().find( "__typeInfoName" );
+			if ( pmit != mt->_properties().end() ) {
+				mt = &Reflector::instance().metatype( pmit->second->get< std::string >( getElementPtr( *it ) ) );
+			}
+			writer.beginElement();
+			mt->_toStr( writer, *it, formatForStreaming );
+			writer.endElement();
+		}
+	}
+
+#if defined( JRTTI_HAS_THREADS )
+	// Writes the elements split in chunks by writer.context().threads() threads. Each chunk is written with
+	// its own context and adopted in order, see SerializationContext::_adopt
+	void
+	writeElementsParallel( JSONWriter& writer, ClassT& collection, bool formatForStreaming ) {
+		SerializationContext& context = writer.context();
+		size_t count = 0;
+		for ( typename ClassT::iterator it = collection.begin(); it != collection.end(); ++it ) {
+			++count;
+		}
+		if ( count < 2 || count < context.minParallelElements() ) {
+			writeElements( writer, collection.begin(), collection.end(), formatForStreaming );
+			return;
+		}
+
+	// a few chunks per thread balance the load and bound the work redone on conflicts
+		const size_t chunkCount = std::min< size_t >( count, context.threads() * 4 );
+		std::vector< typename ClassT::iterator > bounds;
+		typename ClassT::iterator it = collection.begin();
+		for ( size_t chunk = 0, index = 0; chunk < chunkCount; ++chunk ) {
+			bounds.push_back( it );
+			for ( const size_t last = count * ( chunk + 1 ) / chunkCount; index < last; ++index ) {
+				++it;
+			}
+		}
+		bounds.push_back( collection.end() );
+
+		std::vector< boost::shared_ptr< SerializationContext > > contexts;
+		for ( size_t chunk = 0; chunk < chunkCount; ++chunk ) {
+			contexts.push_back( boost::shared_ptr< SerializationContext >( new SerializationContext( &context ) ) );
+		}
+		std::vector< std::string > texts( chunkCount );
+		const bool minified = writer.minified();
+		const int level = writer.level();
+		__parallelFor( chunkCount, context.threads(), [ & ]( size_t chunk ) {
+			SerializationContext::Scope scope( *contexts[ chunk ] );
+			JSONWriter chunkWriter( *contexts[ chunk ], minified, level );
+			writeElements( chunkWriter, bounds[ chunk ], bounds[ chunk + 1 ], formatForStreaming );
+			texts[ chunk ].swap( chunkWriter.str() );
+		} );
+
+		const size_t parts = context.threads();
+		std::vector< std::vector< char > > partConflicts( parts, std::vector< char >( chunkCount ) );
+		__parallelFor( parts, context.threads(), [ & ]( size_t part ) {
+			SerializationContext::_conflicts( contexts, part, parts, partConflicts[ part ] );
+		} );
+		std::vector< char > conflicts( chunkCount );
+		for ( size_t part = 0; part < parts; ++part ) {
+			for ( size_t chunk = 0; chunk < chunkCount; ++chunk ) {
+				conflicts[ chunk ] |= partConflicts[ part ][ chunk ];
+			}
+		}
+
+		// chunks before the first conflict get their ids from a prefix sum, and are resolved in parallel
+		size_t valid = 0;
+		std::vector< size_t > bases( 1, context._nextId() );
+		for ( ; valid < chunkCount && !conflicts[ valid ]; ++valid ) {
+			bases.push_back( bases.back() + contexts[ valid ]->m_added.size() );
+		}
+		std::vector< std::string > resolved( valid );
+		__parallelFor( valid, context.threads(), [ & ]( size_t chunk ) {
+			contexts[ chunk ]->_resolve( texts[ chunk ], bases[ chunk ], resolved[ chunk ] );
+		} );
+		size_t length = writer.str().length();
+		size_t placeholders = 0;
+		size_t lastId = context._nextId();
+		for ( size_t chunk = 0; chunk < chunkCount; ++chunk ) {
+			length += texts[ chunk ].length() + 1;
+			placeholders += contexts[ chunk ]->m_placeholders.size();
+			lastId += contexts[ chunk ]->m_added.size();
+		}
+		// room for the separators, and for the ids, none longer than the last one
+		char digits[ maxNumberLength ];
+		writer.str().reserve( length + placeholders * formatNumber( digits, lastId ) );
+
+		for ( size_t chunk = 0; chunk < chunkCount; ++chunk ) {
+			if ( chunk ) {
+				writer.separator();
+			}
+			if ( chunk < valid ) {
+				writer.str().append( resolved[ chunk ] );
+				context._adopt( contexts[ chunk ] );
+			}
+			else if ( conflicts[ chunk ] ) {
+				// the chunk reached objects written by a chunk before it
+				writeElements( writer, bounds[ chunk ], bounds[ chunk + 1 ], formatForStreaming );
+			}
+			else {
+				// ids shifted by the chunks written again
+				contexts[ chunk ]->_resolve( texts[ chunk ], context._nextId(), writer.str() );
+				context._adopt( contexts[ chunk ] );
+			}
+		}
 	}
+#endif
 
 	virtual
 	boost::any
-	_fromStr( const boost::any& instance, const std::string& str, bool doCopyFromInstance = true ) {
-		JSONParser pre_parser( str );
-		Metatype::_fromStr( instance, pre_parser[ "properties" ], false );
+	_fromStr( JSONReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		JSONSpan key;
+		reader.beginObject();
+		while ( reader.nextMember( key ) ) {
+			if ( reader.equals( key, "properties" ) ) {
+				Metatype::_fromStr( reader, instance, false );
+			}
+			else if ( reader.equals( key, "elements" ) ) {
+				fillElements( reader, instance );
+			}
+			else {
+				reader.skipValue();
+			}
+		}
+		return boost::any();
+	}
+
+	void
+	fillElements( JSONReader& reader, const boost::any& instance ) {
 		ClassT& _collection =  getReference( instance );
 
 		////////// COMPILER ERROR   //// Collections must declare a clear method. See documentation for details.
 		_collection.clear();
-		JSONParser parser( pre_parser["elements"] );
-		for( JSONParser::iterator it = parser.begin(); it != parser.end(); ++it) {
-			Metatype * elemType;
-			JSONParser elemParser( it->second );
-			JSONParser::iterator found = elemParser.find( "__typeInfoName" );
-			if ( found != elemParser.end() ) {
-				elemType = &Reflector::instance().metatype( found->second );
+		Metatype * valueType = &jrtti::metatype< typename ClassT::value_type >();
+		bool isPolymorphic = valueType->_properties().count( "__typeInfoName" ) != 0;
+		std::string typeInfoName;
+
+		reader.beginArray();
+#if defined( JRTTI_HAS_THREADS )
+		if ( reader.context().threads() > 1 ) {
+			const size_t start = reader.position();
+			if ( readElementsParallel( reader, _collection, valueType, isPolymorphic ) ) {
+				return;
 			}
-			else {
-				elemType = &Reflector::instance().metatype< ClassT::value_type >();
+			reader.position( start );
+		}
+#endif
+		while ( reader.nextElement() ) {
+			typename ClassT::value_type elem;
+			readElement( reader, elementType( reader, valueType, isPolymorphic, typeInfoName ), elem );
+			////////// COMPILER ERROR   //// Collections must declare an insert method. See documentation for details.
+			_collection.insert( _collection.end(), elem );
+		}
+	}
+
+	Metatype *
+	elementType( JSONReader& reader, Metatype * valueType, bool isPolymorphic, std::string& typeInfoName ) {
+		if ( isPolymorphic && reader.findMember( "__typeInfoName", typeInfoName ) ) {
+			return &Reflector::instance().metatype( typeInfoName );
+		}
+		return valueType;
+	}
+
+	void
+	readElement( JSONReader& reader, Metatype * elemType, typename ClassT::value_type& elem ) {
+		if ( boost::is_pointer< ClassT::value_type >::value ) {
+			elem = jrtti_cast< ClassT::value_type >( elemType->createFor( reader.context() ) );
+			elemType->_fromStr( reader, elem, false );
+		}
+		else {
+			const boost::any &mod = elemType->_fromStr( reader, elem );
+			elem = jrtti_cast< typename ClassT::value_type >( mod );
+		}
+	}
+
+#if defined( JRTTI_HAS_THREADS )
+	// Indexes the positions of the elements, then reads them by reader.context().threads() threads
+	// and inserts them in order. Returns false, without reading the elements, if the collection
+	// is too small or the elements hold references, which could point to other elements
+	bool
+	readElementsParallel( JSONReader& reader, ClassT& collection, Metatype * valueType, bool isPolymorphic ) {
+		SerializationContext& context = reader.context();
+		const size_t start = reader.position();
+		std::vector< size_t > offsets;
+		while ( reader.nextElement() ) {
+			offsets.push_back( reader.position() );
+			reader.skipValue();
+		}
+		const size_t count = offsets.size();
+		if ( count < 2 || count < context.minParallelElements() || reader.contains( start, reader.position(), "\"$ref\"" ) ) {
+			return false;
+		}
+
+		const size_t chunkCount = std::min< size_t >( count, context.threads() * 4 );
+		// not a std::vector, as std::vector< bool > can not give references to its elements
+		boost::scoped_array< typename ClassT::value_type > elements( new typename ClassT::value_type[ count ]() );
+		std::vector< Metatype * > types( count );
+		std::vector< boost::shared_ptr< SerializationContext > > contexts;
+		for ( size_t chunk = 0; chunk < chunkCount; ++chunk ) {
+			contexts.push_back( boost::shared_ptr< SerializationContext >( new SerializationContext() ) );
+			contexts.back()->setArena( context.arena() );
+		}
+		try {
+			__parallelFor( chunkCount, context.threads(), [ & ]( size_t chunk ) {
+				SerializationContext::Scope scope( *contexts[ chunk ] );
+				JSONReader chunkReader( reader, *contexts[ chunk ] );
+				std::string typeInfoName;
+				for ( size_t i = count * chunk / chunkCount, last = count * ( chunk + 1 ) / chunkCount; i < last; ++i ) {
+					chunkReader.position( offsets[ i ] );
+					types[ i ] = elementType( chunkReader, valueType, isPolymorphic, typeInfoName );
+					readElement( chunkReader, types[ i ], elements[ i ] );
+				}
+			} );
+		}
+		catch ( ... ) {
+			// the elements created are not in the collection, nor in an arena
+			if ( !context.arena() ) {
+				destroyElements( elements.get(), &types[ 0 ], count );
+			}
+			throw;
+		}
+
+		// objects read with an $id can be referenced after the collection
+		for ( size_t chunk = 0; chunk < chunkCount; ++chunk ) {
+			context.nameRefs().insert( contexts[ chunk ]->nameRefs() );
+		}
+		for ( size_t i = 0; i < count; ++i ) {
+			collection.insert( collection.end(), elements[ i ] );
+		}
+		return true;
+	}
+#endif
+
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & value ) {
+		writer.tag( binCollection );
+		Metatype::_toBinary( writer, value );
+		ClassT& _collection = getReference( value );
+
+		Metatype * valueType = &jrtti::metatype< typename ClassT::value_type >();
+		PropertyMap::iterator typeInfoName = valueType->_properties().find( "__typeInfoName" );
+		bool isPolymorphic = typeInfoName != valueType->_properties().end();
+
+		size_t count = 0;
+		for ( typename ClassT::iterator it = _collection.begin() ; it != _collection.end(); ++it ) {
+			++count;
+		}
+		writer.beginArray( count );
+		for ( typename ClassT::iterator it = _collection.begin() ; it != _collection.end(); ++it ) {
+			Metatype * elemType = valueType;
+			if ( isPolymorphic ) {
+				std::string typeName = typeInfoName->second->get< std::string >( getElementPtr( *it ) );
+				writer.typed( typeName );
+				elemType = &Reflector::instance().metatype( typeName );
+			}
+			elemType->_toBinary( writer, *it );
+		}
+	}
+
+	virtual
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any& instance, bool doCopyFromInstance = true ) {
+		reader.expect( binCollection );
+		Metatype::_fromBinary( reader, instance, false );
+		ClassT& _collection =  getReference( instance );
+		_collection.clear();
+
+		Metatype * valueType = &jrtti::metatype< typename ClassT::value_type >();
+		size_t count = reader.beginArray();
+		for ( size_t i = 0; i < count; ++i ) {
+			Metatype * elemType = valueType;
+			if ( reader.peekTag() == binTyped ) {
+				elemType = &Reflector::instance().metatype( reader.typed() );
 			}
 			typename ClassT::value_type elem;
 			if ( boost::is_pointer< ClassT::value_type >::value ) {
-//				elem = *boost::unsafe_any_cast< ClassT::value_type >( &elemType->create() );
 				elem = jrtti_cast< ClassT::value_type >( elemType->create() );
-				elemType->_fromStr( elem, it->second, false );
+				elemType->_fromBinary( reader, elem, false );
 				_collection.insert( _collection.end(), elem );
 			}
 			else {
-				const boost::any &mod = elemType->_fromStr( elem, it->second );
-				////////// COMPILER ERROR   //// Collections must declare an insert method. See documentation for details.
-//				_collection.insert( _collection.end(), *boost::unsafe_any_cast< typename ClassT::value_type >( &mod ) );
+				const boost::any &mod = elemType->_fromBinary( reader, elem );
 				_collection.insert( _collection.end(), jrtti_cast< typename ClassT::value_type >( mod ) );
 			}
-		}
-		return boost::any();
-	}
-
-	virtual
-	boost::any
-	create() {
-		return new ClassT();
+		}
+		return boost::any();
 	}
-
-	ClassT&
-	getReference( const boost::any value ) {
- 		if ( value.type() == typeid( ClassT ) ) {
-			static ClassT ref = boost::any_cast< ClassT >( value );
-			return ref;
+
+	ClassT&
+	getReference( const boost::any& value ) {
+ 		if ( value.type() == typeid( ClassT ) ) {
+			// the collection held by value, which outlives the call using it
+			return *boost::unsafe_any_cast< ClassT >( const_cast< boost::any * >( &value ) );
 		}
 		if ( value.type() == typeid( ClassT * ) ) {
 			return * boost::any_cast< ClassT * >( value );
 		}
 		if ( value.type() == typeid( boost::reference_wrapper< ClassT > ) ) {
-			return boost::any_cast< boost::reference_wrapper< ClassT > >( value ).get();
-		}
+			return boost::any_cast< boost::reference_wrapper< ClassT > >( value ).get();
+		}
 		else {
 //			return **boost::unsafe_any_cast< ClassT * >( &value );
 			return *jrtti_cast< ClassT * >( value );
 		}
-	}
+	}
+
+//SFINAE destroyElements for pointer elements, destroying the ones created with their metatypes
+	template< typename ElemT >
+	typename boost::enable_if< typename boost::is_pointer< ElemT >::type >::type
+	destroyElements( ElemT * elements, Metatype ** types, size_t count ) {
+		for ( size_t i = 0; i < count; ++i ) {
+			if ( elements[ i ] ) {
+				try {
+					types[ i ]->destroy( elements[ i ] );
+				}
+				catch ( ... ) {
+					// keep the error that stopped the reading
+				}
+			}
+		}
+	}
+
+//SFINAE destroyElements for non-pointer elements, destroyed with their array
+	template< typename ElemT >
+	typename boost::disable_if< typename boost::is_pointer< ElemT >::type >::type
+	destroyElements( ElemT *, Metatype **, size_t ) {}
 
 //SFINAE getElementPtr for pointer elements
 	template< typename ElemT >
 	typename boost::enable_if< typename boost::is_pointer< ElemT >::type, ElemT >::type
 	getElementPtr( ElemT e ){
-		return e;
-	}
+		return e;
+	}
 
 //SFINAE getElementPtr for non-pointer elements
 	template< typename ElemT >
 	typename boost::disable_if< typename boost::is_pointer< ElemT >::type, ElemT * >::type
 	getElementPtr( ElemT& e ){
-		return &e;
-	}
+		return &e;
+	}
 };
-
-
-
-// Interfaces for Metacollection ********************************
-
-
-
-/**
- * \brief Iterator for custom collections
- *
- * You do not need to worry about this if you are using STL containers to implement 
- * your collection. If not, your collection has to expose an iterator wich implements
- * deference, prefix increment and inequality operators. In other words, your iterator
- * should implement an specialization of this template for your collection elements
- * type.
- * \example test_jrtti.h for a use case.
- */
-template< typename T >
+
+
+
+// Interfaces for Metacollection ********************************
+
+
+
+/**
+ * \brief Iterator for custom collections
+ *
+ * You do not need to worry about this if you are using STL containers to implement 
+ * your collection. If not, your collection has to expose an iterator wich implements
+ * deference, prefix increment and inequality operators. In other words, your iterator
+ * should implement an specialization of this template for your collection elements
+ * type.
+ * \example test_jrtti.h for a use case.
+ */
+template< typename T >
 struct jrtti_iterator : public std::iterator< std::forward_iterator_tag, T > {
 	jrtti_iterator( T* x ) : p( x ){}
 	jrtti_iterator( const jrtti_iterator& jit ) : p( jit.p ){}
-	T& operator * () { return *p; };										/// \brief Deference operator
-	jrtti_iterator& operator ++ () { ++p; return *this; }				/// \brief prefix increment operator
+	T& operator * () { return *p; };										/// \brief Deference operator
+	jrtti_iterator& operator ++ () { ++p; return *this; }				/// \brief prefix increment operator
 	bool operator != ( const jrtti_iterator& it ) { return p!= it.p; }	/// \brief inequality operator
 private:
 	T * p;
-};
-
-/**
-* \brief Interface template for native Collection types
-*
-* You do not need to worry about this if you are using STL containers to implement 
-* your collection. If not, your collection has to specialize a jrtti::iterator for 
-* your container types and implement CollectionInterface.
-*/
-template < typename T >
-class CollectionInterface {
-public:
-	typedef jrtti_iterator<T> iterator;
-	typedef T value_type;
-
-	/**
-	* \brief Return iterator to beginning
-	*
-	* Returns an iterator referring to the first element of the collection
-	* \return iterator to the beginning of the sequence
-	*/
-	virtual iterator begin()=0;
-
-	/**
-	* \brief Return iterator to the end
-	*
-	* Returns an iterator referring to the past-the-end element of the collection
-	* \return iterator at the end of the collection
-	*/
-	virtual iterator end() = 0;
-
-	/**
-	* \brief Insert an element
-	*
-	* Insert a new element to the collection
-	* \param position position in the collection where the new element is inserted
-	* \param x value to be used to initialize the inserted element
-	* \return an iterator that points to the newly inserted element
-	*/
-	virtual iterator insert( iterator position, const T& x ) = 0;
-
-	/**
-	* \brief Discards all elements of the collection.
-	*/
-	virtual void clear() = 0;
-};
+};
+
+/**
+* \brief Interface template for native Collection types
+*
+* You do not need to worry about this if you are using STL containers to implement 
+* your collection. If not, your collection has to specialize a jrtti::iterator for 
+* your container types and implement CollectionInterface.
+*/
+template < typename T >
+class CollectionInterface {
+public:
+	typedef jrtti_iterator<T> iterator;
+	typedef T value_type;
+
+	/**
+	* \brief Return iterator to beginning
+	*
+	* Returns an iterator referring to the first element of the collection
+	* \return iterator to the beginning of the sequence
+	*/
+	virtual iterator begin()=0;
+
+	/**
+	* \brief Return iterator to the end
+	*
+	* Returns an iterator referring to the past-the-end element of the collection
+	* \return iterator at the end of the collection
+	*/
+	virtual iterator end() = 0;
+
+	/**
+	* \brief Insert an element
+	*
+	* Insert a new element to the collection
+	* \param position position in the collection where the new element is inserted
+	* \param x value to be used to initialize the inserted element
+	* \return an iterator that points to the newly inserted element
+	*/
+	virtual iterator insert( iterator position, const T& x ) = 0;
+
+	/**
+	* \brief Discards all elements of the collection.
+	*/
+	virtual void clear() = 0;
+};
 
 
 }; // namespace jrtti
@@ -0,0 +1,372 @@
+#ifndef jrtticontextH
+#define jrtticontextH
+
+#include <vector>
+#include <utility>
+#include <cstring>
+#include <boost/shared_ptr.hpp>
+#include "helpers.hpp"
+#include "threads.hpp"
+#include "arena.hpp"
+#include "refmaps.hpp"
+
+namespace jrtti {
+
+/**
+ * \brief State of a serialization
+ *
+ * Holds the bookkeeping of shared objects, $id and $ref, written or read by
+ * toStr and fromStr. Every call to toStr or fromStr uses its own context
+ * unless one is passed explicitly, so serializations running in different
+ * threads, or nested in a StringifyDelegate, do not interfere.
+ * Passing the same context to several calls shares the object ids among
+ * them.
+ * A context can also enable the parallel serialization of large
+ * collections, see setThreads.
+ */
+class SerializationContext {
+public:
+	SerializationContext()
+		:	m_parent( NULL ),
+			m_arena( NULL ),
+			m_idBase( 0 ),
+			m_idCount( 0 ),
+			m_threads( 1 ),
+			m_minParallelElements( 1024 ) {}
+
+	/**
+	 * \brief Retrieves the ids given to the objects written
+	 * \return map from object address to object id
+	 */
+	AddressRefMap&
+	addressRefs() {
+		_compact();
+		return m_addressRefs;
+	}
+
+	/**
+	 * \brief Retrieves the objects read by id
+	 * \return map from object id to object address
+	 */
+	NameRefMap&
+	nameRefs() {
+		return m_nameRefs;
+	}
+
+	/**
+	 * \brief Looks for the id given to a written object
+	 * \param inst the object address
+	 * \param id receives the object id if found
+	 * \return false if the object was not written yet
+	 */
+	bool
+	findId( void * inst, size_t& id ) const {
+		if ( m_addressRefs.find( inst, id ) ) {
+			return true;
+		}
+		for ( size_t i = 0; i < m_adopted.size(); ++i ) {
+			const SerializationContext& chunk = *m_adopted[ i ];
+			if ( chunk.m_addressRefs.find( inst, id ) ) {
+				id = chunk.m_idBase + ( id & ~placeholderId );
+				return true;
+			}
+		}
+		return m_parent && m_parent->findId( inst, id );
+	}
+
+	/**
+	 * \brief Gives the next id to a written object
+	 * \param inst the object address
+	 * \return the object id
+	 */
+	size_t
+	addId( void * inst ) {
+		size_t id;
+		if ( m_parent ) {
+			// placeholder replaced by the final id when the chunk is adopted, see JSONWriter::id
+			id = placeholderId | m_added.size();
+			m_added.push_back( inst );
+		}
+		else {
+			id = m_idCount++;
+		}
+		m_addressRefs.insert( inst, id );
+		return id;
+	}
+
+	/**
+	 * \brief Formats an object id as a JSON string
+	 *
+	 * Ids given while writing a chunk of a collection in parallel are not
+	 * final, and are written by JSONWriter::id instead.
+	 * \param buffer receives the quoted id. Should have room for maxIdLength characters
+	 * \param id the id returned by findId or addId
+	 * \return the length of the text
+	 */
+	static
+	size_t
+	formatId( char * buffer, size_t id ) {
+		size_t length = 0;
+		buffer[ length++ ] = '"';
+		length += formatNumber( buffer + length, id );
+		buffer[ length++ ] = '"';
+		return length;
+	}
+
+	/**
+	 * \brief Maximum length of the text written by formatId
+	 */
+	static const size_t maxIdLength = maxNumberLength + 2;
+
+	/**
+	 * \brief Forgets all objects written and read
+	 */
+	void
+	clear() {
+		m_addressRefs.clear();
+		m_nameRefs.clear();
+		m_added.clear();
+		m_placeholders.clear();
+		m_adopted.clear();
+		m_idCount = 0;
+	}
+
+	/**
+	 * \brief Sets the arena owning the objects created by fromStr
+	 *
+	 * Objects referenced by pointers and elements of collections of
+	 * pointers are then created in the arena instead of on the heap, and
+	 * are destroyed at once by ObjectArena::clear.
+	 * \param arena the arena or NULL to create objects on the heap
+	 */
+	void
+	setArena( ObjectArena * arena ) {
+		m_arena = arena;
+	}
+
+	/**
+	 * \brief Retrieves the arena owning the objects created by fromStr
+	 * \return the arena or NULL if objects are created on the heap
+	 * \sa setArena
+	 */
+	ObjectArena *
+	arena() const {
+		return m_arena;
+	}
+
+	/**
+	 * \brief Sets the number of threads serializing collections
+	 *
+	 * When greater than 1, toStr splits the elements of collections having
+	 * at least minParallelElements elements in chunks written by that many
+	 * threads, and joins the chunks in order. The result is the same as the
+	 * one of a serial serialization, $id and $ref included. Chunks reaching
+	 * objects written by a previous chunk are written again serially, so
+	 * the speedup is better for elements not sharing objects.
+	 * Without JRTTI_HAS_THREADS collections are always written serially.
+	 * \param threads number of threads, the calling one included
+	 */
+	void
+	setThreads( unsigned threads ) {
+		m_threads = threads ? threads : 1;
+	}
+
+	/**
+	 * \brief Retrieves the number of threads serializing collections
+	 * \return number of threads
+	 * \sa setThreads
+	 */
+	unsigned
+	threads() const {
+		return m_threads;
+	}
+
+	/**
+	 * \brief Sets the minimum size of a collection written in parallel
+	 * \param count number of elements
+	 * \sa setThreads
+	 */
+	void
+	setMinParallelElements( size_t count ) {
+		m_minParallelElements = count;
+	}
+
+	/**
+	 * \brief Retrieves the minimum size of a collection written in parallel
+	 * \return number of elements
+	 * \sa setThreads
+	 */
+	size_t
+	minParallelElements() const {
+		return m_minParallelElements;
+	}
+
+	/**
+	 * \brief Retrieves the context of the innermost serialization running in this thread
+	 *
+	 * When no serialization is running, returns a default context local to the
+	 * calling thread. Without JRTTI_HAS_THREADS the default context is shared
+	 * by all threads.
+	 * \return the current context
+	 */
+	static
+	SerializationContext&
+	current() {
+		SerializationContext * context = currentPtr();
+		if ( context ) {
+			return *context;
+		}
+#if defined( JRTTI_HAS_THREADS )
+		static thread_local SerializationContext defaultContext;
+#else
+		static SerializationContext defaultContext;
+#endif
+		return defaultContext;
+	}
+
+	/**
+	 * \brief Makes a context current in this thread while in scope
+	 */
+	class Scope {
+	public:
+		/**
+		 * \brief Constructor
+		 * \param context the context to make current
+		 */
+		Scope( SerializationContext& context )
+			:	m_previous( currentPtr() ) {
+			currentPtr() = &context;
+		}
+
+		~Scope() {
+			currentPtr() = m_previous;
+		}
+
+	private:
+		Scope( const Scope& );
+		Scope& operator = ( const Scope& );
+
+		SerializationContext *	m_previous;
+	};
+
+private:
+	template< typename C > friend class Metacollection;
+	friend class JSONWriter;
+
+	// Context of a chunk of a collection written in parallel. Objects written by parent are looked up in it
+	SerializationContext( const SerializationContext * parent )
+		:	m_parent( parent ),
+			m_arena( NULL ),
+			m_idBase( 0 ),
+			m_idCount( 0 ),
+			m_threads( 1 ),
+			m_minParallelElements( 0 ) {}
+
+	SerializationContext( const SerializationContext& );
+	SerializationContext& operator = ( const SerializationContext& );
+
+	// Ids given by chunks, flagged by the highest bit
+	static const size_t placeholderId = ~( ~size_t( 0 ) >> 1 );
+
+	typedef std::vector< boost::shared_ptr< SerializationContext > > Chunks;
+
+	// Flags in conflicts the chunks having written an object also written by a chunk before them.
+	// Objects are split in parts by address, so parts can be checked in parallel, each one flagging
+	// its own conflicts vector
+	static
+	void
+	_conflicts( const Chunks& chunks, size_t part, size_t parts, std::vector< char >& conflicts ) {
+		AddressRefMap first;
+		size_t chunk;
+		for ( size_t index = 0; index < chunks.size(); ++index ) {
+			const std::vector< void * >& added = chunks[ index ]->m_added;
+			for ( size_t i = 0; i < added.size(); ++i ) {
+				if ( ( ( size_t( added[ i ] ) >> 4 ) * 2654435761u >> 8 ) % parts != part ) {
+					continue;
+				}
+				if ( first.find( added[ i ], chunk ) ) {
+					conflicts[ index ] = true;
+				}
+				else {
+					first.insert( added[ i ], index );
+				}
+			}
+		}
+	}
+
+	// Records that the placeholder id was left out of the text written by this chunk at offset
+	void
+	_placeholder( size_t offset, size_t id ) {
+		m_placeholders.push_back( std::make_pair( offset, id & ~placeholderId ) );
+	}
+
+	// Appends to out the text written by this chunk, inserting the final ids at the offsets of
+	// its placeholders, base being the id of the first object written by the chunk
+	void
+	_resolve( const std::string& text, size_t base, std::string& out ) const {
+		char buffer[ maxNumberLength ];
+		size_t pos = 0;
+		for ( size_t i = 0; i < m_placeholders.size(); ++i ) {
+			out.append( text, pos, m_placeholders[ i ].first - pos );
+			out.append( buffer, formatNumber( buffer, base + m_placeholders[ i ].second ) );
+			pos = m_placeholders[ i ].first;
+		}
+		out.append( text, pos, std::string::npos );
+	}
+
+	// Id of the next object written
+	size_t
+	_nextId() const {
+		return m_idCount;
+	}
+
+	// Takes the objects written by a chunk not conflicting with the ones written before, giving them
+	// consecutive ids from _nextId. The chunk keeps its map and is looked up by findId
+	void
+	_adopt( const boost::shared_ptr< SerializationContext >& chunk ) {
+		chunk->m_idBase = m_idCount;
+		m_idCount += chunk->m_added.size();
+		m_adopted.push_back( chunk );
+		// bounds the maps looked up by findId
+		if ( m_adopted.size() > 32 ) {
+			_compact();
+		}
+	}
+
+	// Moves the objects of the adopted chunks to the map of this context
+	void
+	_compact() {
+		for ( size_t i = 0; i < m_adopted.size(); ++i ) {
+			const SerializationContext& chunk = *m_adopted[ i ];
+			for ( size_t index = 0; index < chunk.m_added.size(); ++index ) {
+				m_addressRefs.insert( chunk.m_added[ index ], chunk.m_idBase + index );
+			}
+		}
+		m_adopted.clear();
+	}
+
+	static
+	SerializationContext *&
+	currentPtr() {
+		static JRTTI_THREAD_LOCAL SerializationContext * context = NULL;
+		return context;
+	}
+
+	AddressRefMap					m_addressRefs;
+	NameRefMap						m_nameRefs;
+	const SerializationContext *	m_parent;
+	ObjectArena *					m_arena;
+	std::vector< void * >			m_added;
+	// offset in the chunk text and index in m_added of every placeholder written, see _resolve
+	std::vector< std::pair< size_t, size_t > >	m_placeholders;
+	// chunks whose objects are looked up in their own map, see _adopt
+	Chunks							m_adopted;
+	size_t							m_idBase;
+	size_t							m_idCount;
+	unsigned						m_threads;
+	size_t							m_minParallelElements;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jrtticontextH
@@ -22,6 +22,57 @@ public:
 #endif
 	}
 
+	virtual
+	boost::any
+	createIn( ObjectArena& arena ) {
+#ifdef BOOST_NO_IS_ABSTRACT
+		return _createIn< IsAbstractT >( arena );
+#else
+		return _createIn< ClassT >( arena );
+#endif
+	}
+
+	virtual
+	void
+	destroy( const boost::any& instance ) {
+#ifdef BOOST_NO_IS_ABSTRACT
+		_destroy< IsAbstractT >( instance );
+#else
+		_destroy< ClassT >( instance );
+#endif
+	}
+
+	virtual
+	void
+	enablePool( size_t batchSize = 64 ) {
+		if ( !isAbstract() ) {
+			m_pool.enable( batchSize );
+		}
+	}
+
+	/**
+	 * \brief Makes create take the instances from an ObjectPool
+	 * \param batchSize number of instances moved at once between the thread lists of the pool
+	 * \return this for chain calls
+	 * \throw Error if instances were already created without the pool
+	 * \sa Metatype::enablePool
+	 */
+	CustomMetaclass&
+	pooled( size_t batchSize = 64 ) {
+		enablePool( batchSize );
+		return *this;
+	}
+
+	/**
+	 * \brief Retrieves the pool of the instances
+	 * \return the pool or NULL if instances are not pooled
+	 * \sa pooled
+	 */
+	ObjectPool< ClassT > *
+	pool() const {
+		return m_pool.pool();
+	}
+
 	bool
 	isAbstract() const {
 #ifdef BOOST_NO_IS_ABSTRACT
@@ -42,13 +93,13 @@ public:
 			typedef R 		result_type;
 			typedef void 	param_type;
 		};
-
-		template < typename R >
-		struct FunctionTypes< R ( ClassT::* )() const >
-		{
-			typedef R 		result_type;
-			typedef void 	param_type;
-		};
+
+		template < typename R >
+		struct FunctionTypes< R ( ClassT::* )() const >
+		{
+			typedef R 		result_type;
+			typedef void 	param_type;
+		};
 	};
 
 	/**
@@ -65,6 +116,7 @@ public:
 		parentMetatype( &parent );
 		PropertyMap& parentProps = parent._properties();
 		_properties().insert( parentProps.begin(), parentProps.end() );
+		invalidateIndexes();
 		MethodMap& parentMeth = parent._methods();
 		_methods().insert( parentMeth.begin(), parentMeth.end() );
 		pointerMetatype()->parentMetatype( parent.pointerMetatype() );
@@ -293,10 +345,10 @@ public:
 	 */
 	template <typename ReturnType, typename Param1, typename Param2>
 	TypedMethod<ClassT,ReturnType, Param1, Param2>&
-	getMethod(std::string name)
+	getMethod( const std::string& name )
 	{
 		typedef TypedMethod< ClassT, ReturnType, Param1, Param2 > ElementType;
-		return * static_cast< ElementType * >( m_methods[name] );
+		return * static_cast< ElementType * >( &method( name ) );
 	}
 
 protected:
@@ -372,9 +424,8 @@ private:
 	typename boost::disable_if< typename __IS_ABSTRACT( AbstT ), void * >::type
 	_get_instance_ptr(const boost::any& content){
 		if ( content.type() == typeid( ClassT ) ) {
-			static ClassT dummy = ClassT();
-			dummy = boost::any_cast< ClassT >(content);
-			return &dummy;
+			// the object held by content, which outlives the call using it
+			return boost::unsafe_any_cast< ClassT >( const_cast< boost::any * >( &content ) );
 		}
 		if ( content.type() == typeid( boost::reference_wrapper< ClassT > ) ) {
 			return boost::any_cast< boost::reference_wrapper< ClassT > >( content ).get_pointer();
@@ -411,7 +462,7 @@ private:
 	typename boost::disable_if< typename __IS_ABSTRACT( AbstT ), boost::any >::type
 	_create()
 	{
-		return new ClassT();
+		return m_pool.create();
 	}
 
 //SFINAE _create for ABSTRACT
@@ -421,6 +472,40 @@ private:
 	{
 		return boost::any();
 	}
+
+//SFINAE _destroy for NON ABSTRACT
+	template< typename AbstT >
+	typename boost::disable_if< typename __IS_ABSTRACT( AbstT ), void >::type
+	_destroy( const boost::any& instance )
+	{
+		m_pool.destroy( jrtti_cast< ClassT * >( instance ) );
+	}
+
+//SFINAE _destroy for ABSTRACT
+	template< typename AbstT >
+	typename boost::enable_if< typename __IS_ABSTRACT( AbstT ), void >::type
+	_destroy( const boost::any& instance )
+	{
+		Metatype::destroy( instance );
+	}
+
+//SFINAE _createIn for NON ABSTRACT
+	template< typename AbstT >
+	typename boost::disable_if< typename __IS_ABSTRACT( AbstT ), boost::any >::type
+	_createIn( ObjectArena& arena )
+	{
+		return arena.create< ClassT >();
+	}
+
+//SFINAE _createIn for ABSTRACT
+	template< typename AbstT >
+	typename boost::enable_if< typename __IS_ABSTRACT( AbstT ), boost::any >::type
+	_createIn( ObjectArena& )
+	{
+		return boost::any();
+	}
+
+	__PoolSlot< ClassT >	m_pool;
 };
 
 }; //namespace jrtti
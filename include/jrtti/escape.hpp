@@ -0,0 +1,234 @@
+#ifndef jrttiescapeH
+#define jrttiescapeH
+
+#include <string>
+#include "exception.hpp"
+#include "simd.hpp"
+
+namespace jrtti {
+	struct __escape {
+		static
+		bool
+		needsEscape( char c ) {
+			return ( (unsigned char)c < 0x20 ) || ( c == '"' ) || ( c == '\\' ) || ( c == '/' );
+		}
+
+		// Length of the prefix of [first, last) without characters needing an escape sequence
+		static
+		size_t
+		cleanLength( const char * first, const char * last ) {
+			const char * p = first;
+#if defined( JRTTI_AVX2 )
+			const __m256i quote32 = _mm256_set1_epi8( '"' );
+			const __m256i backslash32 = _mm256_set1_epi8( '\\' );
+			const __m256i slash32 = _mm256_set1_epi8( '/' );
+			const __m256i control32 = _mm256_set1_epi8( 0x1F );
+			for ( ; last - p >= 32; p += 32 ) {
+				const __m256i v = _mm256_loadu_si256( (const __m256i *)p );
+				const __m256i special = _mm256_or_si256(
+						_mm256_or_si256( _mm256_cmpeq_epi8( _mm256_min_epu8( v, control32 ), v ), _mm256_cmpeq_epi8( v, quote32 ) ),
+						_mm256_or_si256( _mm256_cmpeq_epi8( v, backslash32 ), _mm256_cmpeq_epi8( v, slash32 ) ) );
+				const unsigned mask = unsigned( _mm256_movemask_epi8( special ) );
+				if ( mask ) {
+					return p - first + __simd::firstBit( mask );
+				}
+			}
+#endif
+#if defined( JRTTI_SSE2 )
+			const __m128i quote = _mm_set1_epi8( '"' );
+			const __m128i backslash = _mm_set1_epi8( '\\' );
+			const __m128i slash = _mm_set1_epi8( '/' );
+			const __m128i control = _mm_set1_epi8( 0x1F );
+			for ( ; last - p >= 16; p += 16 ) {
+				const __m128i v = _mm_loadu_si128( (const __m128i *)p );
+				const __m128i special = _mm_or_si128(
+						_mm_or_si128( _mm_cmpeq_epi8( _mm_min_epu8( v, control ), v ), _mm_cmpeq_epi8( v, quote ) ),
+						_mm_or_si128( _mm_cmpeq_epi8( v, backslash ), _mm_cmpeq_epi8( v, slash ) ) );
+				const unsigned mask = unsigned( _mm_movemask_epi8( special ) );
+				if ( mask ) {
+					return p - first + __simd::firstBit( mask );
+				}
+			}
+#endif
+			while ( p < last && !needsEscape( *p ) ) {
+				++p;
+			}
+			return p - first;
+		}
+
+		// Length of the prefix of [first, last) without backslashes
+		static
+		size_t
+		unescapedLength( const char * first, const char * last ) {
+			const char * p = first;
+#if defined( JRTTI_AVX2 )
+			const __m256i backslash32 = _mm256_set1_epi8( '\\' );
+			for ( ; last - p >= 32; p += 32 ) {
+				const __m256i v = _mm256_loadu_si256( (const __m256i *)p );
+				const unsigned mask = unsigned( _mm256_movemask_epi8( _mm256_cmpeq_epi8( v, backslash32 ) ) );
+				if ( mask ) {
+					return p - first + __simd::firstBit( mask );
+				}
+			}
+#endif
+#if defined( JRTTI_SSE2 )
+			const __m128i backslash = _mm_set1_epi8( '\\' );
+			for ( ; last - p >= 16; p += 16 ) {
+				const __m128i v = _mm_loadu_si128( (const __m128i *)p );
+				const unsigned mask = unsigned( _mm_movemask_epi8( _mm_cmpeq_epi8( v, backslash ) ) );
+				if ( mask ) {
+					return p - first + __simd::firstBit( mask );
+				}
+			}
+#endif
+			while ( p < last && *p != '\\' ) {
+				++p;
+			}
+			return p - first;
+		}
+
+		// Value of the four hexadecimal digits at p
+		static
+		unsigned
+		hex4( const char * p, const char * last ) {
+			if ( last - p < 4 ) {
+				throw Error( "Malformed JSON: incomplete unicode escape sequence" );
+			}
+			unsigned value = 0;
+			for ( const char * end = p + 4; p < end; ++p ) {
+				unsigned digit;
+				if ( *p >= '0' && *p <= '9' ) {
+					digit = *p - '0';
+				}
+				else if ( *p >= 'a' && *p <= 'f' ) {
+					digit = *p - 'a' + 10;
+				}
+				else if ( *p >= 'A' && *p <= 'F' ) {
+					digit = *p - 'A' + 10;
+				}
+				else {
+					throw Error( "Malformed JSON: invalid unicode escape sequence" );
+				}
+				value = ( value << 4 ) | digit;
+			}
+			return value;
+		}
+
+		static
+		void
+		appendUtf8( std::string& dest, unsigned codePoint ) {
+			if ( codePoint < 0x80 ) {
+				dest += char( codePoint );
+			}
+			else if ( codePoint < 0x800 ) {
+				dest += char( 0xC0 | ( codePoint >> 6 ) );
+				dest += char( 0x80 | ( codePoint & 0x3F ) );
+			}
+			else if ( codePoint < 0x10000 ) {
+				dest += char( 0xE0 | ( codePoint >> 12 ) );
+				dest += char( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+				dest += char( 0x80 | ( codePoint & 0x3F ) );
+			}
+			else {
+				dest += char( 0xF0 | ( codePoint >> 18 ) );
+				dest += char( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) );
+				dest += char( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+				dest += char( 0x80 | ( codePoint & 0x3F ) );
+			}
+		}
+	};
+
+	/**
+	 * \brief Appends text escaping it as the contents of a JSON string
+	 *
+	 * Quotes, backslashes, slashes and control characters are written as escape
+	 * sequences. Other characters, including UTF-8 multibyte sequences, are
+	 * copied as is. Runs of characters not needing escape are located 16 or
+	 * 32 bytes at a time when SSE2 or AVX2 are available, and copied at once.
+	 * \param dest the string to append to
+	 * \param str pointer to the text to escape
+	 * \param length length of the text
+	 */
+	inline
+	void
+	appendEscaped( std::string& dest, const char * str, size_t length ) {
+		static const char hexDigits[] = "0123456789abcdef";
+		const char * p = str;
+		const char * last = str + length;
+		for ( ;; ) {
+			const size_t clean = __escape::cleanLength( p, last );
+			dest.append( p, clean );
+			p += clean;
+			if ( p == last ) {
+				break;
+			}
+			switch ( *p ) {
+				case '"': dest += "\\\""; break;
+				case '\\': dest += "\\\\"; break;
+				case '/': dest += "\\/"; break;
+				case '\b': dest += "\\b"; break;
+				case '\f': dest += "\\f"; break;
+				case '\n': dest += "\\n"; break;
+				case '\r': dest += "\\r"; break;
+				case '\t': dest += "\\t"; break;
+				default: {
+					const char sequence[] = { '\\', 'u', '0', '0', hexDigits[ ( *p >> 4 ) & 0xF ], hexDigits[ *p & 0xF ] };
+					dest.append( sequence, sizeof( sequence ) );
+				}
+			}
+			++p;
+		}
+	}
+
+	/**
+	 * \brief Appends the contents of a JSON string decoding its escape sequences
+	 *
+	 * \\uXXXX sequences are decoded to UTF-8, joining surrogate pairs.
+	 * Runs of characters without escape sequences are located 16 or 32 bytes
+	 * at a time when SSE2 or AVX2 are available, and copied at once.
+	 * \param dest the string to append to
+	 * \param str pointer to the string contents, without quotes
+	 * \param length length of the string contents
+	 * \throw Error if a unicode escape sequence is malformed
+	 */
+	inline
+	void
+	appendUnescaped( std::string& dest, const char * str, size_t length ) {
+		const char * p = str;
+		const char * last = str + length;
+		for ( ;; ) {
+			const size_t clean = __escape::unescapedLength( p, last );
+			dest.append( p, clean );
+			p += clean;
+			if ( last - p < 2 ) {
+				if ( p < last ) {
+					throw Error( "Malformed JSON: incomplete escape sequence" );
+				}
+				break;
+			}
+			++p;
+			switch ( *p++ ) {
+				case 'b': dest += '\b'; break;
+				case 'f': dest += '\f'; break;
+				case 'n': dest += '\n'; break;
+				case 'r': dest += '\r'; break;
+				case 't': dest += '\t'; break;
+				case 'u': {
+					unsigned codePoint = __escape::hex4( p, last );
+					p += 4;
+					if ( codePoint >= 0xD800 && codePoint < 0xDC00 && last - p >= 6 && p[ 0 ] == '\\' && p[ 1 ] == 'u' ) {
+						const unsigned low = __escape::hex4( p + 2, last );
+						if ( low >= 0xDC00 && low < 0xE000 ) {
+							codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+							p += 6;
+						}
+					}
+					__escape::appendUtf8( dest, codePoint );
+					break;
+				}
+				default: dest += p[ -1 ];
+			}
+		}
+	}
+}; // namespace jrtti
+#endif //jrttiescapeH
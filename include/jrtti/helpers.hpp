@@ -1,151 +1,203 @@
-#ifndef jrttihelpersclassH
+#ifndef jrttihelpersclassH
 #define jrttihelpersclassH
-
-
-#include <sstream>
-#include <boost/any.hpp>
-#include <boost/type_traits/is_fundamental.hpp>
+
+
+#include <sstream>
+#include <boost/any.hpp>
+#include <boost/type_traits/is_fundamental.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include "numconv.hpp"
 
 namespace jrtti {
+	// Arithmetic types but characters, which convert to and from one character strings
+	template< typename T >
+	struct __isNumber
+		:	boost::integral_constant< bool, boost::is_arithmetic< T >::value
+				&& !boost::is_same< T, char >::value
+				&& !boost::is_same< T, signed char >::value
+				&& !boost::is_same< T, unsigned char >::value > {};
+
 	/**
 	 * Converts a number to a string
 	 *
+	 * Arithmetic types are written by formatNumber, without using streams.
+	 * Characters are not numbers, see the streamable overload.
 	 * \param number the number to convert
 	 * \return the string representation of number
+	 * \sa formatNumber
+	 */
+	template <typename T>
+	typename boost::enable_if< __isNumber< T >, std::string >::type
+	numToStr ( T number ) {
+		char buffer[ maxNumberLength ];
+		return std::string( buffer, formatNumber( buffer, number ) );
+	}
+
+	/**
+	 * Converts a streamable value to a string
+	 *
+	 * Characters give a one character string.
+	 * \param number the value to convert
+	 * \return the string representation of number
 	 */
 	template <typename T>
-	std::string
-	numToStr ( T number ) {
-		std::ostringstream ss;
-		ss << number;
-		return ss.str();
-	}
+	typename boost::disable_if< __isNumber< T >, std::string >::type
+	numToStr ( T number ) {
+		std::ostringstream ss;
+		ss << number;
+		return ss.str();
+	}
 
 	/**
 	 * Converts a string to a number
 	 *
+	 * Arithmetic types are read by parseNumber, without using streams. Leading
+	 * blanks are skipped. Characters are not numbers, see the streamable overload.
 	 * \tparam T type to convert
 	 * \param str the string containing a valid number format to convert
-	 * \return the number represented by str
+	 * \return the number represented by str, or 0 if str does not start with a number
+	 * \sa parseNumber
+	 */
+	template <typename T>
+	typename boost::enable_if< __isNumber< T >, T >::type
+	strToNum ( const std::string &str ) {
+		const char * first = str.data();
+		const char * last = first + str.length();
+		while ( first < last && ( *first == ' ' || *first == '\t' || *first == '\n' || *first == '\r' ) ) {
+			++first;
+		}
+		T result = 0;
+		parseNumber( first, last, result );
+		return result;
+	}
+
+	/**
+	 * Converts a string to a streamable value
+	 *
+	 * Characters are read from the first non blank character.
+	 * \tparam T type to convert
+	 * \param str the string containing a valid representation of T
+	 * \return the value represented by str
 	 */
 	template <typename T>
-	T
-	strToNum ( const std::string &str ) {
-		std::istringstream ss( str );
-		T result;
-		return ss >> result ? result : 0;
-	}
-
-	/**
-	 * \brief Type cast from boost::any
-	 *
-	 * This funtion tries to cast the contents of the passed boost::any to the type
-	 * in the template parameter. Accurate conversion is guarantied except when template
-	 * parameter is void *.
-	 * \tparam T type to cast to
-	 * \param value boost::any to cast
-	 * \return the converted type
-	 * \throw BadCast if conversion is not allowed
-	 */
-	template< typename T >
-	T
-	jrtti_cast( const boost::any& value ) {
-		return __detail::__jrtti_cast< T >( value );
-	}
-
-	struct __detail {
-		//jrtti_cast SFINAE for pointers 
-		template< typename T >
-		static
-		typename boost::enable_if< typename boost::is_pointer< T >::type, T >::type
-		__jrtti_cast( const boost::any& value ) {
-			if ( value.empty() ) {
-				return NULL;
-			}
-
-			if ( value.type() == typeid( void * ) ) {
-				return ( T )boost::any_cast< void * >( value );
-			}
-
-			if ( value.type() == typeid( T ) ) {
-				return boost::any_cast< T >( value );
-			}
-
-			if ( ( typeid( T ) == typeid( void * ) ) ) {
-				return (T)*boost::unsafe_any_cast< void * >( &value );
-			}
-
-			Metatype& value_mt = Reflector::instance().metatype( value.type() );
-			Metatype& templT_mt = Reflector::instance().metatype< T >();
-			if ( value_mt.isDerivedFrom( templT_mt ) || templT_mt.isDerivedFrom( value_mt ) ) {
-				return (T)*boost::unsafe_any_cast< void * >( &value );
-			}
-
-			throw BadCast( typeid( T ).name() );
-		}
-
-		//jrtti_cast SFINAE for non-pointers 
-		template< typename T >
-		static
-		typename boost::disable_if< typename boost::is_pointer< T >::type, T >::type
-		__jrtti_cast( const boost::any& value ) {
-			if ( value.type() == typeid( T ) ) {
-				return ( T )boost::any_cast< T >( value );
-			}
-			if ( value.type() == typeid( T * ) ) {
-				return * ( T * )boost::any_cast< T * >( value );
-			}
-			if ( value.type() == typeid( void * ) ) {
-				return * ( T * )boost::any_cast< void * >( value );
-			}
-			if ( boost::is_fundamental< T >::value ) {
-				return tryFundamental< T >( value );
-			}
-			throw BadCast( typeid( T ).name() );
-		}
-
-		// SFINAE for tryFundamental for fundamental types
-		template< typename T >
-		static
-		typename boost::enable_if< typename boost::is_fundamental< T >::type, T>::type
-		tryFundamental( const boost::any& value ) {
-#pragma warning( push )
-#pragma warning( disable:4800 )
-			if ( value.type() == typeid( char ) ) {
-				return static_cast< T >( boost::any_cast< char >( value ) );
-			}
-			if ( value.type() == typeid( bool ) ) {
-				return static_cast< T >( boost::any_cast< bool >( value ) );
-			}
-			if ( value.type() == typeid( short ) ) {
-				return static_cast< T >( boost::any_cast< short >( value ) );
-			}
-			if ( value.type() == typeid( int ) ) {
-				return static_cast< T >( boost::any_cast< int >( value ) );
-			}
-			if ( value.type() == typeid( long ) ) {
-				return static_cast< T >( boost::any_cast< long >( value ) );
-			}
-			if ( value.type() == typeid( float ) ) {
-				return static_cast< T >( boost::any_cast< float >( value ) );
-			}
-			if ( value.type() == typeid( double ) ) {
-				return static_cast< T >( boost::any_cast< double >( value ) );
-			}
-			if ( value.type() == typeid( long double ) ) {
-				return static_cast< T >( boost::any_cast< long double >( value ) );
-			}
-#pragma warning( pop )
-			throw BadCast( typeid( T ).name() );
-		}
-
-		// SFINAE for tryFundamental for fundamental types
-		template< typename T >
-		static
-		typename boost::disable_if< typename boost::is_fundamental< T >::type, T>::type
-		tryFundamental( const boost::any& value ) {
-			throw BadCast( typeid( T ).name() );
-		}
-	};
-}; // namespace jrtti
-#endif //jrttihelpersH
+	typename boost::disable_if< __isNumber< T >, T >::type
+	strToNum ( const std::string &str ) {
+		std::istringstream ss( str );
+		T result;
+		return ss >> result ? result : T();
+	}
+
+	/**
+	 * \brief Type cast from boost::any
+	 *
+	 * This funtion tries to cast the contents of the passed boost::any to the type
+	 * in the template parameter. Accurate conversion is guarantied except when template
+	 * parameter is void *.
+	 * \tparam T type to cast to
+	 * \param value boost::any to cast
+	 * \return the converted type
+	 * \throw BadCast if conversion is not allowed
+	 */
+	template< typename T >
+	T
+	jrtti_cast( const boost::any& value ) {
+		return __detail::__jrtti_cast< T >( value );
+	}
+
+	struct __detail {
+		//jrtti_cast SFINAE for pointers 
+		template< typename T >
+		static
+		typename boost::enable_if< typename boost::is_pointer< T >::type, T >::type
+		__jrtti_cast( const boost::any& value ) {
+			if ( value.empty() ) {
+				return NULL;
+			}
+
+			if ( value.type() == typeid( void * ) ) {
+				return ( T )boost::any_cast< void * >( value );
+			}
+
+			if ( value.type() == typeid( T ) ) {
+				return boost::any_cast< T >( value );
+			}
+
+			if ( ( typeid( T ) == typeid( void * ) ) ) {
+				return (T)*boost::unsafe_any_cast< void * >( &value );
+			}
+
+			Metatype& value_mt = Reflector::instance().metatype( value.type() );
+			Metatype& templT_mt = Reflector::instance().metatype< T >();
+			if ( value_mt.isDerivedFrom( templT_mt ) || templT_mt.isDerivedFrom( value_mt ) ) {
+				return (T)*boost::unsafe_any_cast< void * >( &value );
+			}
+
+			throw BadCast( typeid( T ).name() );
+		}
+
+		//jrtti_cast SFINAE for non-pointers 
+		template< typename T >
+		static
+		typename boost::disable_if< typename boost::is_pointer< T >::type, T >::type
+		__jrtti_cast( const boost::any& value ) {
+			if ( value.type() == typeid( T ) ) {
+				return ( T )boost::any_cast< T >( value );
+			}
+			if ( value.type() == typeid( T * ) ) {
+				return * ( T * )boost::any_cast< T * >( value );
+			}
+			if ( value.type() == typeid( void * ) ) {
+				return * ( T * )boost::any_cast< void * >( value );
+			}
+			if ( boost::is_fundamental< T >::value ) {
+				return tryFundamental< T >( value );
+			}
+			throw BadCast( typeid( T ).name() );
+		}
+
+		// SFINAE for tryFundamental for fundamental types
+		template< typename T >
+		static
+		typename boost::enable_if< typename boost::is_fundamental< T >::type, T>::type
+		tryFundamental( const boost::any& value ) {
+#pragma warning( push )
+#pragma warning( disable:4800 )
+			if ( value.type() == typeid( char ) ) {
+				return static_cast< T >( boost::any_cast< char >( value ) );
+			}
+			if ( value.type() == typeid( bool ) ) {
+				return static_cast< T >( boost::any_cast< bool >( value ) );
+			}
+			if ( value.type() == typeid( short ) ) {
+				return static_cast< T >( boost::any_cast< short >( value ) );
+			}
+			if ( value.type() == typeid( int ) ) {
+				return static_cast< T >( boost::any_cast< int >( value ) );
+			}
+			if ( value.type() == typeid( long ) ) {
+				return static_cast< T >( boost::any_cast< long >( value ) );
+			}
+			if ( value.type() == typeid( float ) ) {
+				return static_cast< T >( boost::any_cast< float >( value ) );
+			}
+			if ( value.type() == typeid( double ) ) {
+				return static_cast< T >( boost::any_cast< double >( value ) );
+			}
+			if ( value.type() == typeid( long double ) ) {
+				return static_cast< T >( boost::any_cast< long double >( value ) );
+			}
+#pragma warning( pop )
+			throw BadCast( typeid( T ).name() );
+		}
+
+		// SFINAE for tryFundamental for fundamental types
+		template< typename T >
+		static
+		typename boost::disable_if< typename boost::is_fundamental< T >::type, T>::type
+		tryFundamental( const boost::any& value ) {
+			throw BadCast( typeid( T ).name() );
+		}
+	};
+}; // namespace jrtti
+#endif //jrttihelpersH
@@ -0,0 +1,256 @@
+#ifndef jrttijsonindexH
+#define jrttijsonindexH
+
+#include <vector>
+#include <cstring>
+#include <stdint.h>
+#include "simd.hpp"
+
+namespace jrtti {
+
+/**
+ * \brief Structural index of a JSON text
+ *
+ * Holds the position of every brace and bracket found outside strings,
+ * each one paired with its match, so a nested object or array is skipped
+ * with a lookup instead of a scan of its contents.
+ * The index is built by a single pass classifying quotes, backslashes,
+ * braces and brackets 64 characters at a time in bitmasks, with SSE2 when
+ * available. Escaped quotes and the characters inside strings are found
+ * with bit arithmetic on the masks, without branching per character.
+ * Texts longer than 4GB, unbalanced or with unterminated strings are not
+ * indexed, see valid.
+ */
+class JSONIndex {
+public:
+	/**
+	 * \brief Constructor
+	 * \param text the JSON text to index
+	 * \param length length of the text
+	 */
+	JSONIndex( const char * text, size_t length )
+		:	m_valid( false ) {
+		if ( length > 0xFFFFFFFFu ) {
+			return;
+		}
+		if ( classify( text, length ) ) {
+			m_valid = match( text );
+		}
+		if ( !m_valid ) {
+			std::vector< uint32_t >().swap( m_positions );
+			std::vector< uint32_t >().swap( m_matches );
+		}
+	}
+
+	/**
+	 * \brief Checks if the text was indexed
+	 * \return false if the text is too long or malformed
+	 */
+	bool
+	valid() const {
+		return m_valid;
+	}
+
+	/**
+	 * \brief Retrieves the number of braces and brackets indexed
+	 * \return the number of indexed characters
+	 */
+	size_t
+	size() const {
+		return m_positions.size();
+	}
+
+	/**
+	 * \brief Looks for the end of the object or array starting at a position
+	 * \param offset offset of the opening brace or bracket
+	 * \param hint entry to start looking at, updated with the entry found. Passing the
+	 * hint returned by the previous lookup makes forward lookups close to constant time
+	 * \param closingOffset receives the offset of the matching closing brace or bracket
+	 * \return false if there is no brace nor bracket at offset outside strings
+	 */
+	bool
+	closing( size_t offset, size_t& hint, size_t& closingOffset ) const {
+		const size_t count = m_positions.size();
+		if ( !count ) {
+			return false;
+		}
+		// exponential search from hint for a range holding the first entry not below offset
+		size_t low = hint < count ? hint : count - 1;
+		size_t high = low;
+		size_t step = 1;
+		if ( m_positions[ low ] < offset ) {
+			low = high = low + 1;
+			while ( high < count && m_positions[ high ] < offset ) {
+				low = high + 1;
+				high = low + step;
+				step *= 2;
+			}
+			if ( high > count ) {
+				high = count;
+			}
+		}
+		else {
+			while ( low > 0 ) {
+				const size_t probe = low > step ? low - step : 0;
+				if ( m_positions[ probe ] < offset ) {
+					low = probe + 1;
+					break;
+				}
+				low = high = probe;
+				step *= 2;
+			}
+		}
+		// binary search in [low, high]
+		while ( low < high ) {
+			const size_t middle = low + ( high - low ) / 2;
+			if ( m_positions[ middle ] < offset ) {
+				low = middle + 1;
+			}
+			else {
+				high = middle;
+			}
+		}
+		if ( low >= count || m_positions[ low ] != offset || m_matches[ low ] < low ) {
+			return false;
+		}
+		hint = m_matches[ low ];
+		closingOffset = m_positions[ hint ];
+		return true;
+	}
+
+private:
+	// Bitmasks of a block of 64 characters, bit i standing for character i
+	struct Block {
+		uint64_t	quotes;
+		uint64_t	backslashes;
+		uint64_t	brackets;
+	};
+
+	static
+	uint64_t
+	evenBits() {
+		return ( uint64_t( 0x55555555u ) << 32 ) | 0x55555555u;
+	}
+
+	static
+	void
+	scan( const char * p, Block& block ) {
+#if defined( JRTTI_SSE2 )
+		const __m128i quote = _mm_set1_epi8( '"' );
+		const __m128i backslash = _mm_set1_epi8( '\\' );
+		const __m128i lowerCase = _mm_set1_epi8( 0x20 );
+		const __m128i open = _mm_set1_epi8( '{' );	// '[' | 0x20 == '{'
+		const __m128i close = _mm_set1_epi8( '}' );	// ']' | 0x20 == '}'
+		block.quotes = block.backslashes = block.brackets = 0;
+		for ( int i = 0; i < 4; ++i ) {
+			const __m128i v = _mm_loadu_si128( (const __m128i *)( p + i * 16 ) );
+			const __m128i folded = _mm_or_si128( v, lowerCase );
+			block.quotes |= uint64_t( unsigned( _mm_movemask_epi8( _mm_cmpeq_epi8( v, quote ) ) ) ) << ( i * 16 );
+			block.backslashes |= uint64_t( unsigned( _mm_movemask_epi8( _mm_cmpeq_epi8( v, backslash ) ) ) ) << ( i * 16 );
+			block.brackets |= uint64_t( unsigned( _mm_movemask_epi8(
+					_mm_or_si128( _mm_cmpeq_epi8( folded, open ), _mm_cmpeq_epi8( folded, close ) ) ) ) ) << ( i * 16 );
+		}
+#else
+		block.quotes = block.backslashes = block.brackets = 0;
+		for ( int i = 0; i < 64; ++i ) {
+			const uint64_t bit = uint64_t( 1 ) << i;
+			switch ( p[ i ] ) {
+				case '"':
+					block.quotes |= bit;
+					break;
+				case '\\':
+					block.backslashes |= bit;
+					break;
+				case '{':
+				case '}':
+				case '[':
+				case ']':
+					block.brackets |= bit;
+					break;
+			}
+		}
+#endif
+	}
+
+	// Mask of the characters escaped by a backslash. escapedCarry tells if the first character
+	// of the block is escaped, and receives if the first character of the next block is
+	static
+	uint64_t
+	escaped( uint64_t backslashes, uint64_t& escapedCarry ) {
+		backslashes &= ~escapedCarry;
+		const uint64_t followsEscape = ( backslashes << 1 ) | escapedCarry;
+		const uint64_t oddStarts = backslashes & ~evenBits() & ~followsEscape;
+		const uint64_t evenStarts = oddStarts + backslashes;
+		escapedCarry = evenStarts < oddStarts ? 1 : 0;
+		return ( evenBits() ^ ( evenStarts << 1 ) ) & followsEscape;
+	}
+
+	// Sets every bit from each set bit up to the next one, excluded
+	static
+	uint64_t
+	prefixXor( uint64_t bits ) {
+		bits ^= bits << 1;
+		bits ^= bits << 2;
+		bits ^= bits << 4;
+		bits ^= bits << 8;
+		bits ^= bits << 16;
+		bits ^= bits << 32;
+		return bits;
+	}
+
+	// Collects the positions of braces and brackets outside strings. Returns false on unterminated strings
+	bool
+	classify( const char * text, size_t length ) {
+		uint64_t escapedCarry = 0;
+		uint64_t inString = 0;
+		char tail[ 64 ];
+		for ( size_t base = 0; base < length; base += 64 ) {
+			const char * p = text + base;
+			if ( length - base < 64 ) {
+				memset( tail, ' ', sizeof( tail ) );
+				memcpy( tail, p, length - base );
+				p = tail;
+			}
+			Block block;
+			scan( p, block );
+			const uint64_t quotes = block.quotes & ~escaped( block.backslashes, escapedCarry );
+			// strings span from their opening quote to their closing one, excluded
+			const uint64_t strings = prefixXor( quotes ) ^ inString;
+			inString = ( strings >> 63 ) ? ~uint64_t( 0 ) : 0;
+			for ( uint64_t brackets = block.brackets & ~strings; brackets; brackets &= brackets - 1 ) {
+				m_positions.push_back( uint32_t( base + __simd::firstBit64( brackets ) ) );
+			}
+		}
+		return !inString;
+	}
+
+	// Pairs every brace and bracket with its match. Returns false if they are not balanced
+	bool
+	match( const char * text ) {
+		m_matches.resize( m_positions.size() );
+		std::vector< uint32_t > open;
+		for ( size_t i = 0; i < m_positions.size(); ++i ) {
+			const char c = text[ m_positions[ i ] ];
+			if ( c == '{' || c == '[' ) {
+				open.push_back( uint32_t( i ) );
+			}
+			else {
+				if ( open.empty() || text[ m_positions[ open.back() ] ] != ( c == '}' ? '{' : '[' ) ) {
+					return false;
+				}
+				m_matches[ open.back() ] = uint32_t( i );
+				m_matches[ i ] = open.back();
+				open.pop_back();
+			}
+		}
+		return open.empty();
+	}
+
+	std::vector< uint32_t >	m_positions;
+	std::vector< uint32_t >	m_matches;
+	bool					m_valid;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jrttijsonindexH
@@ -1,8 +1,9 @@
-#ifndef jsonparserH
+#ifndef jsonparserH
 #define jsonparserH
 
 #include <ctype.h>
 #include "helpers.hpp"
+#include "jsonreader.hpp"
 
 namespace jrtti {
 
@@ -10,144 +11,226 @@ class JSONParser : public std::map< std::string, std::string > {
 public:
 	JSONParser( const std::string& jsonStr ) : std::map< std::string, std::string >() {
 		m_jsonStr = jsonStr;
-		pos = 1;
-		skipSpaces();
-
-		long keyCount = 0;
-		std::string key;
-		while ( pos < m_jsonStr.length() ) {
-			if ( ( m_jsonStr[ 0 ] == '[' ) || keyCount ) {
-				key = numToStr( keyCount++ );
-			}
-			else {
-				key = findKey();
-			}
-			if ( pos >= m_jsonStr.length() ) {
-				return;
-			}
-			std::string value = findValue( keyCount != 0 );
-			insert( std::pair< std::string, std::string >( key, value ) );
-			if ( keyCount && ( m_jsonStr[ pos ] == ',' || m_jsonStr[ pos ] == ']' ) ) {
-				++pos;
-				skipSpaces();
-			}
-			else {
-				moveToEndChar();
-            }
-		}
-	}
-
-private:
-	inline
-	std::string
-	findKey() {
-		moveToNextQuote();
-		if ( pos >= m_jsonStr.length() ) {
-			return "";
-		}
-		size_t start = ++pos;
-		moveToNextQuote();
-		return m_jsonStr.substr( start, pos - start );
-	}
-
-	inline
-	std::string
-	findValue( bool isInsideArray ) {
-		if ( !isInsideArray )
-			moveToValue();
-		skipSpaces();
-
-		size_t start = pos;
-		// is string
-		if ( m_jsonStr[ pos ] == '"' ) {
-			start = ++pos;
-			moveToNextQuote();
-		}
-		else
-		{
-			// is object or array
-			if ( m_jsonStr[ pos ] == '{' || m_jsonStr[ pos ] == '[' ) {
-				moveToClosingSymbolOf( m_jsonStr[ pos ] );
-			}
-			else {
-				// is number
-				while ( ( pos < m_jsonStr.length() ) && ( ( m_jsonStr[ pos ] != '}' && m_jsonStr[ pos ] != ',' && m_jsonStr[ pos ] != ']' ) ) ) {
-					++pos;
-				}
-			}
-		}
-		return m_jsonStr.substr( start, pos - start );
-	}
-
-	void
-	moveToValue() {
-		while ( ( pos < m_jsonStr.length() ) && ( m_jsonStr[ pos ] != ':' ) ) {
-			++pos;
-		}
-		++pos;
-	}
-
-	inline
-	void
-	moveToNextQuote() {
-		while ( ( pos < m_jsonStr.length() ) && ( m_jsonStr[ pos ] != '"' ) ) {
-			if ( m_jsonStr[ pos ] == '\\') { //skip escape chars
-				++pos;
-			}
-			++pos;
-		}
-	}
-
-	inline
-	void
-	moveToClosingSymbolOf( char openSymbol ) {
-		char closeSymbol;
-		if ( openSymbol == '{' ) {
-			closeSymbol = '}';
-		}
-		else {
-			if ( openSymbol == '[' ) {
-				closeSymbol = ']';
-			}
-			else {
-				throw Error( "Unknown closing symbol" );
-			}
-		}
-		int count = 0;
-		while ( ( pos < m_jsonStr.length() ) && ( ( m_jsonStr[ pos ] != closeSymbol ) || ( count != 0) ) ) {
-			if ( m_jsonStr[ pos + 1 ] == openSymbol ) {
-				++count;
-			}
-			if ( count && ( m_jsonStr[ pos ] == closeSymbol) ) {
-				--count;
-			}
-			++pos;
-		}
-		++pos;
-		skipSpaces();
-	}
-
-	inline
-	void
-	skipSpaces() {
-		while ( ( pos < m_jsonStr.length() ) && ( isspace( m_jsonStr[ pos ] ) ) ) {
-			++pos;
-		}
-	}
-
-	inline
-	void
-	moveToEndChar() {
-		while ( ( pos < m_jsonStr.length() ) && ( m_jsonStr[ pos ] != ',' ) && ( m_jsonStr[ pos ] != '}' ) && ( m_jsonStr[ pos ] != ']' ) ) {
-			++pos;
-		}
-	}
-
-
-	std::string	m_jsonStr;
-	size_t	 	pos;
-};
-
+		pos = 1;
+		skipSpaces();
+
+		long keyCount = 0;
+		std::string key;
+		while ( pos < m_jsonStr.length() ) {
+			if ( ( m_jsonStr[ 0 ] == '[' ) || keyCount ) {
+				key = numToStr( keyCount++ );
+			}
+			else {
+				key = findKey();
+			}
+			if ( pos >= m_jsonStr.length() ) {
+				return;
+			}
+			std::string value = findValue( keyCount != 0 );
+			insert( std::pair< std::string, std::string >( key, value ) );
+			if ( keyCount && ( m_jsonStr[ pos ] == ',' || m_jsonStr[ pos ] == ']' ) ) {
+				++pos;
+				skipSpaces();
+			}
+			else {
+				moveToEndChar();
+            }
+		}
+	}
+
+private:
+	inline
+	std::string
+	findKey() {
+		moveToNextQuote();
+		if ( pos >= m_jsonStr.length() ) {
+			return "";
+		}
+		size_t start = ++pos;
+		moveToNextQuote();
+		return m_jsonStr.substr( start, pos - start );
+	}
+
+	inline
+	std::string
+	findValue( bool isInsideArray ) {
+		if ( !isInsideArray )
+			moveToValue();
+		skipSpaces();
+
+		size_t start = pos;
+		// is string
+		if ( m_jsonStr[ pos ] == '"' ) {
+			start = ++pos;
+			moveToNextQuote();
+		}
+		else
+		{
+			// is object or array
+			if ( m_jsonStr[ pos ] == '{' || m_jsonStr[ pos ] == '[' ) {
+				moveToClosingSymbolOf( m_jsonStr[ pos ] );
+			}
+			else {
+				// is number
+				while ( ( pos < m_jsonStr.length() ) && ( ( m_jsonStr[ pos ] != '}' && m_jsonStr[ pos ] != ',' && m_jsonStr[ pos ] != ']' ) ) ) {
+					++pos;
+				}
+			}
+		}
+		return m_jsonStr.substr( start, pos - start );
+	}
+
+	void
+	moveToValue() {
+		while ( ( pos < m_jsonStr.length() ) && ( m_jsonStr[ pos ] != ':' ) ) {
+			++pos;
+		}
+		++pos;
+	}
+
+	inline
+	void
+	moveToNextQuote() {
+		while ( ( pos < m_jsonStr.length() ) && ( m_jsonStr[ pos ] != '"' ) ) {
+			if ( m_jsonStr[ pos ] == '\\') { //skip escape chars
+				++pos;
+			}
+			++pos;
+		}
+	}
+
+	inline
+	void
+	moveToClosingSymbolOf( char openSymbol ) {
+		char closeSymbol;
+		if ( openSymbol == '{' ) {
+			closeSymbol = '}';
+		}
+		else {
+			if ( openSymbol == '[' ) {
+				closeSymbol = ']';
+			}
+			else {
+				throw Error( "Unknown closing symbol" );
+			}
+		}
+		int count = 0;
+		while ( ( pos < m_jsonStr.length() ) && ( ( m_jsonStr[ pos ] != closeSymbol ) || ( count != 0) ) ) {
+			if ( m_jsonStr[ pos + 1 ] == openSymbol ) {
+				++count;
+			}
+			if ( count && ( m_jsonStr[ pos ] == closeSymbol) ) {
+				--count;
+			}
+			++pos;
+		}
+		++pos;
+		skipSpaces();
+	}
+
+	inline
+	void
+	skipSpaces() {
+		while ( ( pos < m_jsonStr.length() ) && ( isspace( m_jsonStr[ pos ] ) ) ) {
+			++pos;
+		}
+	}
+
+	inline
+	void
+	moveToEndChar() {
+		while ( ( pos < m_jsonStr.length() ) && ( m_jsonStr[ pos ] != ',' ) && ( m_jsonStr[ pos ] != '}' ) && ( m_jsonStr[ pos ] != ']' ) ) {
+			++pos;
+		}
+	}
+
+
+	std::string	m_jsonStr;
+	size_t	 	pos;
+};
+
+/**
+ * \brief Zero-copy parser for JSON objects and arrays
+ *
+ * Enumerates the members of a JSON object or the elements of a JSON array in
+ * document order. Keys and values are returned as JSONSpan views into the
+ * parsed text, so no memory is allocated per member. As with JSONParser,
+ * spans of string values do not include the quotes and spans of nested objects
+ * or arrays include their full text. Array elements have an empty key.
+ * The parsed text should outlive the parser.
+ */
+class JSONSpanParser {
+public:
+	/**
+	 * \brief A member of the parsed object or array
+	 */
+	struct Member {
+		JSONSpan	key;
+		JSONSpan	value;
+	};
+
+	/**
+	 * \brief Constructor
+	 * \param jsonStr the JSON object or array to parse
+	 */
+	JSONSpanParser( const std::string& jsonStr )
+		:	m_reader( jsonStr ),
+			m_isArray( m_reader.peek() == '[' )
+	{
+		if ( m_isArray ) {
+			m_reader.beginArray();
+		}
+		else {
+			m_reader.beginObject();
+		}
+	}
+
+	/**
+	 * \brief Moves to the next member
+	 * \param member receives the spans of the member key and value
+	 * \return false if there are no more members
+	 */
+	bool
+	next( Member& member ) {
+		if ( m_isArray ) {
+			if ( !m_reader.nextElement() ) {
+				return false;
+			}
+			member.key = JSONSpan( m_reader.position(), 0 );
+		}
+		else if ( !m_reader.nextMember( member.key ) ) {
+			return false;
+		}
+		member.value = m_reader.rawSpan();
+		return true;
+	}
+
+	/**
+	 * \brief Copies the text pointed by a span
+	 * \param span the span
+	 * \return the copied text
+	 */
+	std::string
+	str( const JSONSpan& span ) const {
+		return m_reader.str( span );
+	}
+
+	/**
+	 * \brief Compares the text pointed by a span with a literal
+	 * \param span the span
+	 * \param literal null terminated text to compare with
+	 * \return true if both are equal
+	 */
+	bool
+	equals( const JSONSpan& span, const char * literal ) const {
+		return m_reader.equals( span, literal );
+	}
+
+private:
+	JSONReader	m_reader;
+	bool		m_isArray;
+};
+
 //------------------------------------------------------------------------------
 }; //namespace jrtti
 #endif  //jsonparserH
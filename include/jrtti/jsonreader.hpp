@@ -0,0 +1,579 @@
+#ifndef jsonreaderH
+#define jsonreaderH
+
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <boost/shared_ptr.hpp>
+#include "exception.hpp"
+#include "helpers.hpp"
+#include "escape.hpp"
+#include "context.hpp"
+#include "jsonindex.hpp"
+
+namespace jrtti {
+
+/**
+ * \brief Location of a JSON token in the input text
+ *
+ * A span is a view into the original buffer given as an offset from its
+ * beginning and a length. It is used to inspect keys and values without
+ * copying them.
+ */
+struct JSONSpan {
+	JSONSpan( size_t spanOffset = 0, size_t spanLength = 0 )
+		:	offset( spanOffset ),
+			length( spanLength ) {}
+
+	size_t	offset;
+	size_t	length;
+};
+
+/**
+ * \brief Cursor over a JSON representation
+ *
+ * Metatypes read their JSON representation through a JSONReader while
+ * filling an object graph. The reader walks the input once, from the
+ * beginning to the end, and every nested value is consumed in place by the
+ * metatype it belongs to, so no value is copied or tokenized again by the
+ * enclosing levels.
+ * Values skipped without being read, as unknown members or values looked
+ * ahead by findMember, are scanned for their end. Once the skipped objects
+ * and arrays add up to a good part of the input, a JSONIndex of the input
+ * is built and later ones are skipped through it.
+ * The reader keeps a pointer to the input text, which should outlive it.
+ */
+class JSONReader {
+public:
+	/**
+	 * \brief Constructor
+	 * \param jsonStr the JSON text to read
+	 */
+	JSONReader( const std::string& jsonStr )
+		:	m_begin( jsonStr.data() ),
+			m_end( jsonStr.data() + jsonStr.length() ),
+			m_pos( jsonStr.data() ),
+			m_context( &m_ownContext ),
+			m_indexHint( 0 ),
+			m_scanned( 0 ) {}
+
+	/**
+	 * \brief Constructor
+	 * \param jsonStr pointer to the JSON text to read
+	 * \param length length of the JSON text
+	 */
+	JSONReader( const char * jsonStr, size_t length )
+		:	m_begin( jsonStr ),
+			m_end( jsonStr + length ),
+			m_pos( jsonStr ),
+			m_context( &m_ownContext ),
+			m_indexHint( 0 ),
+			m_scanned( 0 ) {}
+
+	/**
+	 * \brief Constructor
+	 * \param jsonStr the JSON text to read
+	 * \param context the serialization context to record read objects in
+	 */
+	JSONReader( const std::string& jsonStr, SerializationContext& context )
+		:	m_begin( jsonStr.data() ),
+			m_end( jsonStr.data() + jsonStr.length() ),
+			m_pos( jsonStr.data() ),
+			m_context( &context ),
+			m_indexHint( 0 ),
+			m_scanned( 0 ) {}
+
+	/**
+	 * \brief Constructor
+	 *
+	 * Creates a reader over the same text as another one, at its position,
+	 * so parts of the text can be read independently. The structural index
+	 * of source, if already built, is shared.
+	 * \param source the reader giving the text and the position
+	 * \param context the serialization context to record read objects in
+	 */
+	JSONReader( const JSONReader& source, SerializationContext& context )
+		:	m_begin( source.m_begin ),
+			m_end( source.m_end ),
+			m_pos( source.m_pos ),
+			m_context( &context ),
+			m_index( source.m_index ),
+			m_indexHint( source.m_indexHint ),
+			m_scanned( 0 ) {}
+
+	/**
+	 * \brief Retrieves the serialization context
+	 * \return the context recording the objects read
+	 */
+	SerializationContext&
+	context() {
+		return *m_context;
+	}
+
+	/**
+	 * \brief Returns the next significant character without consuming it
+	 * \return the next non blank character or 0 at the end of input
+	 */
+	char
+	peek() {
+		skipSpaces();
+		return ( m_pos < m_end ) ? *m_pos : 0;
+	}
+
+	/**
+	 * \brief Consumes the opening brace of an object
+	 * \throw Error if next value is not an object
+	 */
+	void
+	beginObject() {
+		expect( '{' );
+	}
+
+	/**
+	 * \brief Moves to the next member of the current object
+	 *
+	 * Consumes the member name and the colon separator, leaving the reader
+	 * at the member value. When there are no more members, the closing brace
+	 * is consumed.
+	 * \param key receives the member name
+	 * \return false if the end of the object was reached
+	 */
+	bool
+	nextMember( JSONSpan& key ) {
+		if ( !nextItem( '}' ) ) {
+			return false;
+		}
+		key = stringSpan();
+		expect( ':' );
+		return true;
+	}
+
+	/**
+	 * \brief Moves to the next member of the current object
+	 * \param key receives a copy of the member name
+	 * \return false if the end of the object was reached
+	 * \sa nextMember( JSONSpan& key )
+	 */
+	bool
+	nextMember( std::string& key ) {
+		JSONSpan span;
+		if ( !nextMember( span ) ) {
+			return false;
+		}
+		assign( span, key );
+		return true;
+	}
+
+	/**
+	 * \brief Skips the remaining members of the current object
+	 */
+	void
+	endObject() {
+		JSONSpan key;
+		while ( nextMember( key ) ) {
+			skipValue();
+		}
+	}
+
+	/**
+	 * \brief Consumes the opening bracket of an array
+	 * \throw Error if next value is not an array
+	 */
+	void
+	beginArray() {
+		expect( '[' );
+	}
+
+	/**
+	 * \brief Moves to the next element of the current array
+	 *
+	 * When there are no more elements, the closing bracket is consumed.
+	 * \return false if the end of the array was reached
+	 */
+	bool
+	nextElement() {
+		return nextItem( ']' );
+	}
+
+	/**
+	 * \brief Reads a JSON string
+	 * \return the span of the string contents without quotes. Escape sequences are not processed
+	 * \throw Error if next value is not a string
+	 */
+	JSONSpan
+	stringSpan() {
+		expect( '"' );
+		const char * start = m_pos;
+		skipStringContents();
+		return span( start, m_pos++ );
+	}
+
+	/**
+	 * \brief Reads a JSON string
+	 * \return a copy of the string contents without quotes. Escape sequences are not processed
+	 * \sa stringSpan
+	 */
+	std::string
+	stringValue() {
+		return str( stringSpan() );
+	}
+
+	/**
+	 * \brief Reads a JSON string decoding its escape sequences
+	 * \return the decoded string contents
+	 * \throw Error if next value is not a string
+	 * \sa appendUnescaped
+	 */
+	std::string
+	string() {
+		const JSONSpan sp = stringSpan();
+		std::string result;
+		appendUnescaped( result, data( sp ), sp.length );
+		return result;
+	}
+
+	/**
+	 * \brief Reads a number or a literal
+	 * \return the span of the number or literal
+	 * \throw Error if there is no value at reader position
+	 */
+	JSONSpan
+	scalarSpan() {
+		skipSpaces();
+		const char * start = m_pos;
+		skipScalar();
+		if ( start == m_pos ) {
+			error( "value expected" );
+		}
+		return span( start, m_pos );
+	}
+
+	/**
+	 * \brief Reads a number or a literal
+	 * \return a copy of the text of the number or literal
+	 * \sa scalarSpan
+	 */
+	std::string
+	scalar() {
+		return str( scalarSpan() );
+	}
+
+	/**
+	 * \brief Reads a number
+	 *
+	 * The number is parsed in place, without copying its text.
+	 * \return the number
+	 * \throw Error if there is no number of type T at reader position
+	 * \sa parseNumber
+	 */
+	template< typename T >
+	T
+	number() {
+		skipSpaces();
+		T value;
+		const size_t length = parseNumber( m_pos, m_end, value );
+		if ( !length ) {
+			error( "number expected" );
+		}
+		m_pos += length;
+		return value;
+	}
+
+	/**
+	 * \brief Reads any value
+	 *
+	 * Spans of strings do not include the quotes and spans of objects or
+	 * arrays include their full text, with braces or brackets.
+	 * \return the value span
+	 */
+	JSONSpan
+	rawSpan() {
+		switch ( peek() ) {
+			case '"':
+				return stringSpan();
+			case '{':
+			case '[': {
+				const char * start = m_pos;
+				skipContainer();
+				return span( start, m_pos );
+			}
+			default:
+				return scalarSpan();
+		}
+	}
+
+	/**
+	 * \brief Reads any value as text
+	 * \return a copy of the value text
+	 * \sa rawSpan
+	 */
+	std::string
+	rawValue() {
+		return str( rawSpan() );
+	}
+
+	/**
+	 * \brief Retrieves the text pointed by a span
+	 * \param sp the span
+	 * \return pointer to the first character of the span in the input text
+	 */
+	const char *
+	data( const JSONSpan& sp ) const {
+		return m_begin + sp.offset;
+	}
+
+	/**
+	 * \brief Compares the text pointed by a span with a literal
+	 * \param sp the span
+	 * \param literal null terminated text to compare with
+	 * \return true if both are equal
+	 */
+	bool
+	equals( const JSONSpan& sp, const char * literal ) const {
+		const char * p = data( sp );
+		for ( size_t i = 0; i < sp.length; ++i ) {
+			if ( p[ i ] != literal[ i ] ) {
+				return false;
+			}
+		}
+		return literal[ sp.length ] == 0;
+	}
+
+	/**
+	 * \brief Copies the text pointed by a span
+	 * \param sp the span
+	 * \return the copied text
+	 */
+	std::string
+	str( const JSONSpan& sp ) const {
+		return std::string( data( sp ), sp.length );
+	}
+
+	/**
+	 * \brief Copies the text pointed by a span reusing the storage of a string
+	 * \param sp the span
+	 * \param dest the string receiving the text
+	 */
+	void
+	assign( const JSONSpan& sp, std::string& dest ) const {
+		dest.assign( data( sp ), sp.length );
+	}
+
+	/**
+	 * \brief Skips the value at reader position
+	 */
+	void
+	skipValue() {
+		switch ( peek() ) {
+			case '"':
+				++m_pos;
+				skipStringContents();
+				++m_pos;
+				break;
+			case '{':
+			case '[':
+				skipContainer();
+				break;
+			default:
+				skipScalar();
+		}
+	}
+
+	/**
+	 * \brief Looks ahead for a member of the object at reader position
+	 *
+	 * The reader position is not modified.
+	 * \param name the member name to look for
+	 * \param value receives the raw value of the member, if found
+	 * \return true if the member was found
+	 */
+	bool
+	findMember( const char * name, std::string& value ) {
+		const char * mark = m_pos;
+		bool found = false;
+		if ( peek() == '{' ) {
+			beginObject();
+			JSONSpan key;
+			while ( !found && nextMember( key ) ) {
+				if ( equals( key, name ) ) {
+					assign( rawSpan(), value );
+					found = true;
+				}
+				else {
+					skipValue();
+				}
+			}
+		}
+		m_pos = mark;
+		return found;
+	}
+
+	/**
+	 * \brief Looks for a text between two positions
+	 * \param first the offset to start looking at
+	 * \param last the offset to stop looking at
+	 * \param text null terminated text to look for
+	 * \return true if the text was found
+	 */
+	bool
+	contains( size_t first, size_t last, const char * text ) const {
+		const size_t length = strlen( text );
+		const char * end = m_begin + last;
+		for ( const char * p = m_begin + first; end - p >= (ptrdiff_t)length; ++p ) {
+			p = (const char *)memchr( p, text[ 0 ], end - p );
+			if ( !p || end - p < (ptrdiff_t)length ) {
+				return false;
+			}
+			if ( !memcmp( p, text, length ) ) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * \brief Retrieves the reader position
+	 * \return the offset of the reader from the beginning of the input
+	 */
+	size_t
+	position() const {
+		return m_pos - m_begin;
+	}
+
+	/**
+	 * \brief Moves the reader to a previously retrieved position
+	 * \param offset the offset from the beginning of the input
+	 */
+	void
+	position( size_t offset ) {
+		m_pos = m_begin + offset;
+	}
+
+private:
+	// m_context may point to m_ownContext
+	JSONReader( const JSONReader& );
+	JSONReader& operator = ( const JSONReader& );
+
+	JSONSpan
+	span( const char * start, const char * end ) const {
+		return JSONSpan( start - m_begin, end - start );
+	}
+
+	bool
+	nextItem( char closeSymbol ) {
+		char c = peek();
+		if ( c == closeSymbol ) {
+			++m_pos;
+			return false;
+		}
+		if ( c == ',' ) {
+			++m_pos;
+			c = peek();
+		}
+		if ( !c ) {
+			error( std::string( "'" ) + closeSymbol + "' expected" );
+		}
+		return true;
+	}
+
+	void
+	expect( char symbol ) {
+		if ( peek() != symbol ) {
+			error( std::string( "'" ) + symbol + "' expected" );
+		}
+		++m_pos;
+	}
+
+	inline
+	void
+	skipSpaces() {
+		while ( ( m_pos < m_end ) && ( *m_pos == ' ' || *m_pos == '\t' || *m_pos == '\n' || *m_pos == '\r' ) ) {
+			++m_pos;
+		}
+	}
+
+	inline
+	void
+	skipStringContents() {
+		while ( m_pos < m_end ) {
+			m_pos += __escape::cleanLength( m_pos, m_end );
+			if ( m_pos >= m_end || *m_pos == '"' ) {
+				break;
+			}
+			if ( *m_pos == '\\' ) { //skip escape chars
+				++m_pos;
+			}
+			++m_pos;
+		}
+		if ( m_pos >= m_end ) {
+			error( "unterminated string" );
+		}
+	}
+
+	inline
+	void
+	skipScalar() {
+		while ( ( m_pos < m_end ) && ( *m_pos != ',' ) && ( *m_pos != '}' ) && ( *m_pos != ']' )
+				&& ( *m_pos != ' ' ) && ( *m_pos != '\t' ) && ( *m_pos != '\n' ) && ( *m_pos != '\r' ) ) {
+			++m_pos;
+		}
+	}
+
+	void
+	skipContainer() {
+		size_t closing;
+		if ( m_index && m_index->closing( position(), m_indexHint, closing ) ) {
+			m_pos = m_begin + closing + 1;
+			return;
+		}
+		// not indexed yet, or the input is malformed or too long
+		const char * start = m_pos;
+		int depth = 0;
+		do {
+			switch ( *m_pos ) {
+				case '"':
+					++m_pos;
+					skipStringContents();
+					break;
+				case '{':
+				case '[':
+					++depth;
+					break;
+				case '}':
+				case ']':
+					--depth;
+					break;
+			}
+			++m_pos;
+		} while ( depth && ( m_pos < m_end ) );
+		if ( depth ) {
+			error( "unterminated object or array" );
+		}
+		// building the index costs a scan of the whole input, so only once as much was scanned to skip values
+		m_scanned += m_pos - start;
+		if ( !m_index && m_scanned >= minIndexedScan && m_scanned >= size_t( m_end - m_begin ) / 8 ) {
+			m_index.reset( new JSONIndex( m_begin, m_end - m_begin ) );
+		}
+	}
+
+	static const size_t minIndexedScan = 65536;
+
+	void
+	error( const std::string& message ) {
+		throw Error( "Malformed JSON: " + message + " at position " + numToStr( position() ) );
+	}
+
+	const char *	m_begin;
+	const char *	m_end;
+	const char *	m_pos;
+	SerializationContext	m_ownContext;
+	SerializationContext *	m_context;
+	boost::shared_ptr< JSONIndex >	m_index;
+	size_t					m_indexHint;
+	// bytes scanned by skipContainer without the index
+	size_t					m_scanned;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jsonreaderH
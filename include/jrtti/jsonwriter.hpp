@@ -0,0 +1,288 @@
+#ifndef jsonwriterH
+#define jsonwriterH
+
+#include <string>
+#include "helpers.hpp"
+#include "escape.hpp"
+#include "context.hpp"
+
+namespace jrtti {
+
+/**
+ * \brief Output sink for JSON representations
+ *
+ * Metatypes append their JSON representation straight into the buffer of a
+ * JSONWriter while traversing an object graph. Indentation is kept as writer
+ * state, so nested objects are written once at their final position instead
+ * of being built as temporary strings and re-indented by every enclosing level.
+ */
+class JSONWriter {
+public:
+	/**
+	 * \brief Constructor
+	 * \param minified if true, no indentation nor new lines are written
+	 * \param level initial indentation level
+	 */
+	JSONWriter( bool minified = false, int level = 0 )
+		:	m_context( &m_ownContext ),
+			m_level( level ),
+			m_minified( minified ) {}
+
+	/**
+	 * \brief Constructor
+	 * \param context the serialization context to record written objects in
+	 * \param minified if true, no indentation nor new lines are written
+	 * \param level initial indentation level
+	 */
+	JSONWriter( SerializationContext& context, bool minified = false, int level = 0 )
+		:	m_context( &context ),
+			m_level( level ),
+			m_minified( minified ) {}
+
+	/**
+	 * \brief Retrieves the serialization context
+	 * \return the context recording the objects written
+	 */
+	SerializationContext&
+	context() {
+		return *m_context;
+	}
+
+	/**
+	 * \brief Retrieves the current indentation level
+	 * \return the indentation level
+	 */
+	int
+	level() const {
+		return m_level;
+	}
+
+	/**
+	 * \brief Checks if the writer indents its output
+	 * \return true if no indentation nor new lines are written
+	 */
+	bool
+	minified() const {
+		return m_minified;
+	}
+
+	/**
+	 * \brief Retrieves the written buffer
+	 * \return the JSON text written so far
+	 */
+	std::string&
+	str() {
+		return m_buffer;
+	}
+
+	/**
+	 * \brief Writes an opening brace and starts a new line
+	 */
+	void
+	openObject() {
+		m_buffer += '{';
+		newLine();
+	}
+
+	/**
+	 * \brief Starts a new line and writes a closing brace
+	 */
+	void
+	closeObject() {
+		newLine();
+		m_buffer += '}';
+	}
+
+	/**
+	 * \brief Writes an opening bracket and starts a new line
+	 */
+	void
+	openArray() {
+		m_buffer += '[';
+		newLine();
+	}
+
+	/**
+	 * \brief Starts a new line and writes a closing bracket
+	 */
+	void
+	closeArray() {
+		newLine();
+		m_buffer += ']';
+	}
+
+	/**
+	 * \brief Writes the separator between members or elements
+	 */
+	void
+	separator() {
+		m_buffer += ',';
+		newLine();
+	}
+
+	/**
+	 * \brief Writes the name of an object member
+	 *
+	 * Increases the indentation level for the member value. Every call
+	 * should be paired with a call to endMember once the value is written.
+	 * \param name the member name
+	 */
+	void
+	beginMember( const std::string& name ) {
+		beginElement();
+		m_buffer += '"';
+		m_buffer += name;
+		m_buffer += m_minified ? "\":" : "\": ";
+	}
+
+	/**
+	 * \brief Restores the indentation level after a member value
+	 */
+	void
+	endMember() {
+		endElement();
+	}
+
+	/**
+	 * \brief Starts an array element
+	 *
+	 * Increases the indentation level for the element value. Every call
+	 * should be paired with a call to endElement once the value is written.
+	 */
+	void
+	beginElement() {
+		++m_level;
+		if ( !m_minified ) {
+			m_buffer += '\t';
+		}
+	}
+
+	/**
+	 * \brief Restores the indentation level after an array element
+	 */
+	void
+	endElement() {
+		--m_level;
+	}
+
+	/**
+	 * \brief Appends text as is
+	 * \param str the text to append
+	 */
+	void
+	raw( const std::string& str ) {
+		m_buffer += str;
+	}
+
+	/**
+	 * \brief Appends a character as is
+	 * \param c the character to append
+	 */
+	void
+	raw( char c ) {
+		m_buffer += c;
+	}
+
+	/**
+	 * \brief Appends text as is
+	 * \param text the text to append
+	 * \param length length of text
+	 */
+	void
+	raw( const char * text, size_t length ) {
+		m_buffer.append( text, length );
+	}
+
+	/**
+	 * \brief Writes an object id as a JSON string
+	 *
+	 * Ids given while writing a chunk of a collection in parallel are recorded
+	 * in the context and written when the chunk is joined.
+	 * \param id the id returned by findId or addId of the context
+	 * \sa SerializationContext::formatId
+	 */
+	void
+	id( size_t id ) {
+		if ( id & SerializationContext::placeholderId ) {
+			m_buffer += '"';
+			m_context->_placeholder( m_buffer.length(), id );
+			m_buffer += '"';
+		}
+		else {
+			char text[ SerializationContext::maxIdLength ];
+			m_buffer.append( text, SerializationContext::formatId( text, id ) );
+		}
+	}
+
+	/**
+	 * \brief Writes a string value, quoted and escaped
+	 * \param str the string to write
+	 * \sa appendEscaped
+	 */
+	void
+	string( const std::string& str ) {
+		m_buffer += '"';
+		appendEscaped( m_buffer, str.data(), str.length() );
+		m_buffer += '"';
+	}
+
+	/**
+	 * \brief Appends text indenting its inner lines to the current level
+	 *
+	 * Used for text not produced through this writer, as the one returned
+	 * by a StringifyDelegate.
+	 * \param str the text to append
+	 */
+	void
+	rawIndented( const std::string& str ) {
+		if ( m_minified ) {
+			m_buffer += str;
+			return;
+		}
+		size_t start = 0;
+		size_t pos;
+		while ( ( pos = str.find( '\n', start ) ) != std::string::npos ) {
+			m_buffer.append( str, start, pos - start );
+			newLine();
+			start = pos + 1;
+		}
+		m_buffer.append( str, start, std::string::npos );
+	}
+
+	/**
+	 * \brief Appends a number
+	 *
+	 * The number is formatted straight into the buffer.
+	 * \param number the number to append
+	 * \sa formatNumber
+	 */
+	template< typename T >
+	void
+	number( T number ) {
+		char buffer[ maxNumberLength ];
+		m_buffer.append( buffer, formatNumber( buffer, number ) );
+	}
+
+private:
+	// m_context may point to m_ownContext
+	JSONWriter( const JSONWriter& );
+	JSONWriter& operator = ( const JSONWriter& );
+
+	void
+	newLine() {
+		if ( !m_minified ) {
+			m_buffer += '\n';
+			m_buffer.append( m_level, '\t' );
+		}
+	}
+
+	std::string	m_buffer;
+	SerializationContext	m_ownContext;
+	SerializationContext *	m_context;
+	int			m_level;
+	bool		m_minified;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jsonwriterH
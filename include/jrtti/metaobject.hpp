@@ -46,6 +46,16 @@ public:
 		m_metatype->apply( m_instance, name, value );
 	}
 
+	/**
+	 * \brief Set the value of a pre-resolved full categorized property
+	 * \param path the property path, resolved against the associated Metatype
+	 * \param value property value to set
+	 */
+	void
+	set( const PropertyPath& path, const boost::any& value ) {
+		m_metatype->apply( m_instance, path, value );
+	}
+
 	/**
 	 * \brief Returns the value of property
 	 *
@@ -73,6 +83,28 @@ public:
  		return m_metatype->eval( m_instance, name );
 	}
 
+	/**
+	 * \brief Returns the value of a pre-resolved full categorized property
+	 * \tparam the expected type of the property
+	 * \param path the property path, resolved against the associated Metatype
+	 * \return the property value
+	 */
+	template< typename T >
+	T
+	get( const PropertyPath& path ) const {
+		return m_metatype->eval<T>( m_instance, path );
+	}
+
+	/**
+	 * \brief Returns the boost::any value of a pre-resolved full categorized property
+	 * \param path the property path, resolved against the associated Metatype
+	 * \return the property value
+	 */
+	boost::any
+	get( const PropertyPath& path ) const {
+		return m_metatype->eval( m_instance, path );
+	}
+
 	/**
 	 * \brief Retrieves a string representation of the metaobject
 	 *
@@ -2,6 +2,7 @@
 #define jrttimetatypeH
 
 #include <map>
+#include <vector>
 #include <boost/function.hpp>
 #include <boost/bind.hpp>
 #include <boost/type_traits/remove_pointer.hpp>
@@ -9,7 +10,14 @@
 #include "helpers.hpp"
 #include "property.hpp"
 #include "method.hpp"
+#include "nameindex.hpp"
+#include "propertypath.hpp"
+#include "threads.hpp"
+#include "pool.hpp"
 #include "jsonparser.hpp"
+#include "jsonreader.hpp"
+#include "jsonwriter.hpp"
+#include "binary.hpp"
 
 namespace jrtti {
 
@@ -25,6 +33,7 @@ public:
 	typedef std::map< std::string, Property * > PropertyMap;
 	typedef std::map< std::string, Method * >	MethodMap;
 
+	virtual
 	~Metatype() {
 		for (PropertyMap::iterator it = m_ownedProperties.begin(); it != m_ownedProperties.end(); ++it) {
 			delete it->second;
@@ -53,13 +62,61 @@ public:
 	boost::any
 	create() = 0;
 
+	/**
+	 * Creates a new instance of the associated class owned by an arena
+	 *
+	 * Metatypes not supporting arenas create the instance on the heap.
+	 * \param arena the arena owning the instance
+	 * \return a pointer to the created object in a boost::any container
+	 * \sa ObjectArena
+	 */
+	virtual
+	boost::any
+	createIn( ObjectArena& ) {
+		return create();
+	}
+
+	/**
+	 * Destroys an instance created by create
+	 * \param instance a pointer to the instance in a boost::any container, as returned by create
+	 * \throw Error if the Metatype can not destroy instances
+	 */
+	virtual
+	void
+	destroy( const boost::any& ) {
+		throw Error( "Instances of " + name() + " can not be destroyed" );
+	}
+
+	/**
+	 * Makes create take the instances from an ObjectPool
+	 *
+	 * Instances should then be destroyed with destroy, not deleted. Enable
+	 * the pool before creating any instance, as when declaring the type.
+	 * Abstract types have no pool.
+	 * \param batchSize number of instances moved at once between the thread lists of the pool
+	 * \throw Error if instances were already created without the pool
+	 * \sa ObjectPool
+	 */
+	virtual
+	void
+	enablePool( size_t = 64 ) {}
+
 	/**
 	 * Return the demangled type name of this Metatype
+	 *
+	 * The name is demangled on the first call and cached
 	 * \return the type name
 	 */
-	std::string
+	const std::string&
 	name()	const {
-		return demangle( m_type_info.name() );
+		if ( !m_nameValid.load() ) {
+			__LockGuard guard( m_cacheMutex );
+			if ( !m_nameValid.load() ) {
+				m_name = demangle( m_type_info.name() );
+				m_nameValid.store( true );
+			}
+		}
+		return m_name;
 	}
 
 	/**
@@ -189,11 +246,48 @@ public:
 	virtual
 	Property&
 	property( const std::string& name) {
-		PropertyMap::iterator it = _properties().find(name);
-		if ( it == _properties().end() ) {
-			throw Error( "Property '" + name + "' not declared in '" + Metatype::name() + "' metaclass" );
+		return property( name.data(), name.length() );
+	}
+
+	/**
+	 * \brief Returns a property abstraction
+	 *
+	 * Looks for a property of this class by name, given as a part of a string
+	 * \param name pointer to the name of the property to look for, not null terminated
+	 * \param length length of the name
+	 * \return the found property abstraction
+	 * \throw Error if property not found
+	 */
+	Property&
+	property( const char * name, size_t length ) {
+		Property * prop = findProperty( name, length );
+		if ( !prop ) {
+			throw Error( "Property '" + std::string( name, length ) + "' not declared in '" + Metatype::name() + "' metaclass" );
 		}
-		return *it->second;
+		return *prop;
+	}
+
+	/**
+	 * \brief Looks for a property abstraction
+	 *
+	 * Properties are looked up in a hash index of this class properties
+	 * \param name pointer to the name of the property to look for, not null terminated
+	 * \param length length of the name
+	 * \return the found property abstraction or NULL if not found
+	 */
+	Property *
+	findProperty( const char * name, size_t length ) {
+		return _propertyIndex().find( name, length );
+	}
+
+	/**
+	 * \brief Looks for a property abstraction
+	 * \param name the name of the property to look for
+	 * \return the found property abstraction or NULL if not found
+	 */
+	Property *
+	findProperty( const std::string& name ) {
+		return findProperty( name.data(), name.length() );
 	}
 
 	/**
@@ -202,14 +296,38 @@ public:
 	 * Looks for a method of this class by name
 	 * \param name the name of the method to look for
 	 * \return the found method abstraction
+	 * \throw Error if method not found
 	 */
 	Method&
-	method(std::string name) {
-		MethodMap::iterator it = _methods().find(name);
-		if ( it == _methods().end() ) {
+	method( const std::string& name ) {
+		Method * meth = findMethod( name );
+		if ( !meth ) {
 			throw Error( "Method '" + name + "' not declared in '" + Metatype::name() + "' metaclass" );
 		}
-		return *it->second;
+		return *meth;
+	}
+
+	/**
+	 * \brief Looks for a method abstraction
+	 *
+	 * Methods are looked up in a hash index of this class methods
+	 * \param name pointer to the name of the method to look for, not null terminated
+	 * \param length length of the name
+	 * \return the found method abstraction or NULL if not found
+	 */
+	Method *
+	findMethod( const char * name, size_t length ) {
+		return _methodIndex().find( name, length );
+	}
+
+	/**
+	 * \brief Looks for a method abstraction
+	 * \param name the name of the method to look for
+	 * \return the found method abstraction or NULL if not found
+	 */
+	Method *
+	findMethod( const std::string& name ) {
+		return findMethod( name.data(), name.length() );
 	}
 
 	/**
@@ -225,10 +343,10 @@ public:
 	 */
 	template < class ReturnT, class ClassT >
 	ReturnT
-	call ( std::string methodName, ClassT * instance ) {
+	call ( const std::string& methodName, ClassT * instance ) {
 		typedef TypedMethod< boost::remove_pointer< ClassT >::type, ReturnT > MethodType;
 
-		MethodType * ptr = static_cast< MethodType * >( _methods()[methodName] );
+		MethodType * ptr = static_cast< MethodType * >( findMethod( methodName ) );
 		if (!ptr) {
 			throw Error("Method '" + methodName + "' not found in '" + name() + "' metaclass");
 		}
@@ -250,10 +368,10 @@ public:
 	 */
 	template <class ReturnT, class ClassT, class Param1>
 	ReturnT
-	call ( std::string methodName, ClassT * instance, Param1 p1 ) {
+	call ( const std::string& methodName, ClassT * instance, Param1 p1 ) {
 		typedef TypedMethod< ClassT, ReturnT, Param1 > MethodType;
 
-		MethodType * ptr = static_cast< MethodType * >( m_methods[methodName] );
+		MethodType * ptr = static_cast< MethodType * >( findMethod( methodName ) );
 		if (!ptr) {
 			throw Error("Method '" + methodName + "' not found in '" + name() + "' metaclass");
 		}
@@ -277,10 +395,10 @@ public:
 	 */
 	template <class ReturnT, class ClassT, class Param1, class Param2>
 	ReturnT
-	call ( std::string methodName, ClassT * instance, Param1 p1, Param2 p2 ) {
+	call ( const std::string& methodName, ClassT * instance, Param1 p1, Param2 p2 ) {
 		typedef TypedMethod< ClassT, ReturnT, Param1, Param2 > MethodType;
 
-		MethodType * ptr = static_cast< MethodType * >( m_methods[methodName] );
+		MethodType * ptr = static_cast< MethodType * >( findMethod( methodName ) );
 		if (!ptr) {
 			throw Error("Method '" + methodName + "' not found in '" + name() + "' metaclass");
 		}
@@ -299,8 +417,7 @@ public:
 	boost::any
 	eval( const boost::any & instance, std::string path) {
 		size_t pos = path.find_first_of(".");
-		std::string name = path.substr( 0, pos );
-		Property& prop = property(name);
+		Property& prop = property( path.data(), pos == std::string::npos ? path.length() : pos );
 
 		void * inst = get_instance_ptr(instance);
 		if ( !inst )
@@ -324,7 +441,75 @@ public:
 	template < typename PropT >
 	PropT
 	eval( const boost::any & instance, std::string path) {
-		return boost::any_cast< PropT >( eval( instance, path ) );
+		size_t pos = path.find_first_of(".");
+		Property& prop = property( path.data(), pos == std::string::npos ? path.length() : pos );
+
+		void * inst = get_instance_ptr(instance);
+		if ( !inst )
+        	throw NullPtrError( path );
+		if (pos == std::string::npos) {
+			if ( prop.memberKind() != Property::memberNone && prop.memberKind() == __memberKind< PropT >::value ) {
+				return *static_cast< PropT * >( prop.memberAddress( inst ) );
+			}
+			return boost::any_cast< PropT >( prop.get( inst ) );
+		}
+		else {
+			return prop.metatype().eval< PropT >( prop.get( inst ), path.substr( pos + 1 ));
+		}
+	}
+
+	/**
+	 * \brief Evaluates a pre-resolved full categorized property
+	 *
+	 * Returns the value of a full categorized property in a boost::any
+	 * container. Intermediate objects held in data members are reached
+	 * through their address, without copying them.
+	 * \param instance the object instance from where to retrieve the property value
+	 * \param path the property path, resolved against this Metatype
+	 * \return the property value
+	 * \throw NullPtrError if an intermediate object is a null pointer
+	 */
+	boost::any
+	eval( const boost::any & instance, const PropertyPath& path ) {
+		boost::any holder;
+		return path.leaf().get( pathInstance( instance, path, holder ) );
+	}
+
+	/**
+	 * \brief Evaluates a pre-resolved full categorized property
+	 *
+	 * Returns the value of a full categorized property as type PropT.
+	 * \tparam the expected type of the property
+	 * \param instance the object instance from where to retrieve the property value
+	 * \param path the property path, resolved against this Metatype
+	 * \return the property value
+	 * \throw NullPtrError if an intermediate object is a null pointer
+	 */
+	template < typename PropT >
+	PropT
+	eval( const boost::any & instance, const PropertyPath& path ) {
+		boost::any holder;
+		void * inst = pathInstance( instance, path, holder );
+		Property& prop = path.leaf();
+		if ( prop.memberKind() != Property::memberNone && prop.memberKind() == __memberKind< PropT >::value ) {
+			return *static_cast< PropT * >( prop.memberAddress( inst ) );
+		}
+		return boost::any_cast< PropT >( prop.get( inst ) );
+	}
+
+	/**
+	 * \brief Set the value of a pre-resolved full categorized property
+	 *
+	 * Intermediate objects held in data members are modified in place.
+	 * Intermediate objects retrieved by value are modified and set back.
+	 * \param instance the object instance from where to set the property value
+	 * \param path the property path, resolved against this Metatype
+	 * \param value property value to set
+	 * \throw NullPtrError if an intermediate object is a null pointer
+	 */
+	void
+	apply( const boost::any& instance, const PropertyPath& path, const boost::any& value ) {
+		applyPath( get_instance_ptr( instance ), path, 0, value );
 	}
 
 	/**
@@ -339,8 +524,7 @@ public:
 	boost::any
 	apply( const boost::any& instance, std::string path, const boost::any& value, bool doCopyFromInstance = false ) {
 		size_t pos = path.find_first_of(".");
-		std::string name = path.substr( 0, pos );
-		Property& prop = property(name);
+		Property& prop = property( path.data(), pos == std::string::npos ? path.length() : pos );
 
 		void * inst = get_instance_ptr(instance);
 		if (pos == std::string::npos) {
@@ -367,12 +551,35 @@ public:
 	 * \param instance the object instance to retrieve
 	 * \param formatForStreaming if true, formats the string to be passed to a stream.
 	 * In this case, the property is checked to see if it has the PropertyCategory::nonstreamable
+	 * \param minified if true, the representation is written without indentation nor new lines
+	 * \return the string representation
+	 */
+	std::string
+	toStr(const boost::any & instance, bool formatForStreaming = false, bool minified = false ) {
+		JSONWriter writer( minified );
+		SerializationContext::Scope scope( writer.context() );
+		_toStr( writer, instance, formatForStreaming );
+		return writer.str();
+	}
+
+	/**
+	 * \brief Retrieves a string representation of object contens
+	 *
+	 * Retrieves a string representation of the object contens in a JSON format,
+	 * recording written objects in context. Objects already written with the
+	 * same context are written as references.
+	 * \param instance the object instance to retrieve
+	 * \param context the serialization context
+	 * \param formatForStreaming if true, formats the string to be passed to a stream.
+	 * \param minified if true, the representation is written without indentation nor new lines
 	 * \return the string representation
 	 */
 	std::string
-	toStr(const boost::any & instance, bool formatForStreaming = false ) {
-		_addressRefMap().clear();
-		return _toStr( instance, formatForStreaming );
+	toStr( const boost::any & instance, SerializationContext& context, bool formatForStreaming = false, bool minified = false ) {
+		JSONWriter writer( context, minified );
+		SerializationContext::Scope scope( context );
+		_toStr( writer, instance, formatForStreaming );
+		return writer.str();
 	}
 
 	/**
@@ -385,8 +592,57 @@ public:
 	 */
 	void
 	fromStr( const boost::any & instance, const std::string& str ) {
-		_nameRefMap().clear();
-		_fromStr( instance, str, false );
+		JSONReader reader( str );
+		SerializationContext::Scope scope( reader.context() );
+		_fromStr( reader, instance, false );
+	}
+
+	/**
+	 * \brief Fills an object from a string representation
+	 *
+	 * Fills the object pointer by instance from a JSON string representation
+	 * of the object, resolving references to objects read before with the
+	 * same context.
+	 * \param instance the object instance to fill
+	 * \param str a JSON formated string with data to fill the object
+	 * \param context the serialization context
+	 */
+	void
+	fromStr( const boost::any & instance, const std::string& str, SerializationContext& context ) {
+		JSONReader reader( str, context );
+		SerializationContext::Scope scope( context );
+		_fromStr( reader, instance, false );
+	}
+
+	/**
+	 * \brief Retrieves a binary representation of object contens
+	 *
+	 * Retrieves a compact binary representation of the object contens. It
+	 * holds the same data as the string representation formated for streaming,
+	 * shared objects included, and is read back with fromBinary.
+	 * \param instance the object instance to retrieve
+	 * \return the binary representation
+	 * \sa BinaryTag
+	 */
+	std::string
+	toBinary( const boost::any & instance ) {
+		BinaryWriter writer;
+		_toBinary( writer, instance );
+		return writer.str();
+	}
+
+	/**
+	 * \brief Fills an object from a binary representation
+	 *
+	 * Fills the object pointer by instance from a binary representation
+	 * produced by toBinary.
+	 * \param instance the object instance to fill
+	 * \param data the binary representation
+	 */
+	void
+	fromBinary( const boost::any & instance, const std::string& data ) {
+		BinaryReader reader( data );
+		_fromBinary( reader, instance, false );
 	}
 
 	const PropertyMap &
@@ -426,6 +682,7 @@ public:
 	addProperty( std::string name, Property * prop) {
 		_properties()[name] = prop;
 		m_ownedProperties[ name ] = prop;
+		invalidateIndexes();
 	}
 
 	/**
@@ -439,6 +696,7 @@ public:
 			_properties().erase( name );
 			delete elem->second;
 			m_ownedProperties.erase( elem );
+			invalidateIndexes();
 		}
 	}
 
@@ -451,6 +709,7 @@ public:
 	addMethod( std::string name, Method * meth) {
 		m_methods[name] = meth;
 		m_ownedMethods[ name ] = meth;
+		invalidateIndexes();
 	}
 
 	/**
@@ -464,6 +723,7 @@ public:
 			_methods().erase( name );
 			delete elem->second;
 			m_ownedMethods.erase( elem );
+			invalidateIndexes();
 		}
 	}
 
@@ -473,10 +733,175 @@ protected:
 	template< typename C > friend class Metacollection;
 	template< typename C, typename A > friend class CustomMetaclass;
 
+	/**
+	 * \brief Kinds of serialization steps
+	 */
+	enum FieldOpKind {
+		opValue,		///< the value is serialized by the property Metatype
+		opDelegate,		///< the value is serialized by a StringifyDelegate annotation
+		opMember		///< the value is a data member read and written directly in memory
+	};
+
+	/**
+	 * \brief Flags of serialization steps
+	 */
+	enum FieldOpFlags {
+		opReadable = 1,		///< the property is readable
+		opLoadable = 2,		///< the property is writable or annotated with ForceStreamLoadable
+		opStreamable = 4	///< the property is not annotated with NoStreamable
+	};
+
+	/**
+	 * \brief Serialization step for a property
+	 *
+	 * Holds what the serialization of a property needs, resolved once per
+	 * Metatype instead of once per serialized object.
+	 */
+	struct FieldOp {
+		std::string				name;
+		Property *				property;
+		Metatype *				metatype;	///< NULL while the property type is not declared
+		StringifyDelegateBase *	delegate;
+		FieldOpKind				kind;
+		int						flags;
+
+		Metatype&
+		fieldMetatype() const {
+			return metatype ? *metatype : property->metatype();
+		}
+	};
+
+	/**
+	 * \brief Serialization steps for all properties, sorted by name
+	 */
+	typedef std::vector< FieldOp > SerializationPlan;
+
+	/**
+	 * \brief Creates an instance for a load
+	 * \param context the context of the load
+	 * \return the instance, owned by the arena of the context if there is one
+	 */
+	boost::any
+	createFor( SerializationContext& context ) {
+		return context.arena() ? createIn( *context.arena() ) : create();
+	}
+
+	/**
+	 * \brief Checks if an instance is a copy held by value
+	 *
+	 * The address of a copy only lives while the boost::any holding it, so it
+	 * is not recorded to write references to the object.
+	 * \param instance the instance
+	 * \return true if instance holds an object of this Metatype by value
+	 */
+	bool
+	holdsValue( const boost::any & instance ) const {
+		return !isPointer() && instance.type() == m_type_info;
+	}
+
 	Metatype( const std::type_info& typeinfo, const Annotations& annotations = Annotations() )
 		:	m_type_info( typeinfo ),
 			m_annotations( annotations ),
-			m_parentMetatype( NULL ) {}
+			m_parentMetatype( NULL ),
+			m_nameValid( false ),
+			m_planValid( false ),
+			m_planVersion( 0 ),
+			m_indexesValid( false ) {}
+
+	/**
+	 * \brief Retrieves the serialization plan
+	 *
+	 * The plan is compiled on first use and compiled again after the
+	 * properties or any annotations are modified.
+	 * \return the serialization plan
+	 */
+	virtual
+	const SerializationPlan&
+	_plan() {
+		if ( !m_planValid.load() || m_planVersion.load() != Annotations::version() ) {
+			__LockGuard guard( m_cacheMutex );
+			if ( !m_planValid.load() || m_planVersion.load() != Annotations::version() ) {
+				compilePlan();
+			}
+		}
+		return m_plan;
+	}
+
+	/**
+	 * \brief Retrieves the hash index of properties
+	 * \return the property index
+	 */
+	virtual
+	const NameIndex< Property >&
+	_propertyIndex() {
+		if ( !m_indexesValid.load() ) {
+			__LockGuard guard( m_cacheMutex );
+			if ( !m_indexesValid.load() ) {
+				buildIndexes();
+			}
+		}
+		return m_propertyIndex;
+	}
+
+	/**
+	 * \brief Retrieves the hash index of methods
+	 * \return the method index
+	 */
+	virtual
+	const NameIndex< Method >&
+	_methodIndex() {
+		if ( !m_indexesValid.load() ) {
+			__LockGuard guard( m_cacheMutex );
+			if ( !m_indexesValid.load() ) {
+				buildIndexes();
+			}
+		}
+		return m_methodIndex;
+	}
+
+	/**
+	 * \brief Marks the name indexes and the serialization plan to be built again
+	 *
+	 * Should be called after modifying the property or method maps. Metatypes
+	 * should not be modified while used from other threads.
+	 */
+	void
+	invalidateIndexes() {
+		m_planValid.store( false );
+		m_indexesValid.store( false );
+	}
+
+	/**
+	 * \brief Looks for the serialization step of a property
+	 * \param plan the serialization plan
+	 * \param name pointer to the property name, not null terminated
+	 * \param length length of the property name
+	 * \return the serialization step or NULL if not found
+	 */
+	static
+	const FieldOp *
+	findFieldOp( const SerializationPlan& plan, const char * name, size_t length ) {
+		size_t first = 0;
+		size_t last = plan.size();
+		while ( first < last ) {
+			const size_t middle = ( first + last ) / 2;
+			const std::string& opName = plan[ middle ].name;
+			int cmp = opName.compare( 0, length, name, length );
+			if ( !cmp && opName.length() > length ) {
+				cmp = 1;
+			}
+			if ( !cmp ) {
+				return &plan[ middle ];
+			}
+			if ( cmp < 0 ) {
+				first = middle + 1;
+			}
+			else {
+				last = middle;
+			}
+		}
+		return NULL;
+	}
 
 	virtual
 	PropertyMap &
@@ -507,74 +932,86 @@ protected:
 	}
 
 	virtual
-	std::string
-	_toStr( const boost::any & instance, bool formatForStreaming ) {
+	void
+	_toStr( JSONWriter& writer, const boost::any & instance, bool formatForStreaming ) {
 		void * inst = get_instance_ptr(instance);
-		std::string result = "{\n";
+		writer.openObject();
 		bool need_nl = false;
 
-		AddressRefMap::iterator it = _addressRefMap().find( inst );
-		if ( it == _addressRefMap().end() ) {
-			std::string idStr = numToStr<int>( _addressRefMap().size() );
-			_addressRefMap()[ inst ] = idStr;
+		SerializationContext& context = writer.context();
+		// a copy held by value can not be referenced, its address is reused by other copies
+		size_t id;
+		if ( !holdsValue( instance ) && !context.findId( inst, id ) ) {
+			id = context.addId( inst );
 			if ( formatForStreaming ) {
 				need_nl = true;
-				result += "\t\"$id\": \"" + idStr + "\"";
+				writer.beginMember( "$id" );
+				writer.id( id );
+				writer.endMember();
 			}
 		}
 
-		for( PropertyMap::iterator it = _properties().begin(); it != _properties().end(); ++it) {
-			Property * prop = it->second;
-			if ( prop && prop->isReadable() ) {
-				if ( !( formatForStreaming && prop->annotations().has< NoStreamable >() ) ) {
-					if (need_nl) result += ",\n";
-					need_nl = true;
-
-					std::string addToResult;
-					StringifyDelegateBase * stringifyDelegate = prop->annotations().getFirst< StringifyDelegateBase >();
-					if ( stringifyDelegate ) {
-						addToResult = stringifyDelegate->toStr( inst );
-					}
-					else {
-						addToResult = prop->metatype()._toStr( prop->get(inst), formatForStreaming );
-					}
-					result += ident( "\"" + prop->name() + "\"" + ": " + addToResult );
+		const SerializationPlan& plan = _plan();
+		for( SerializationPlan::const_iterator op = plan.begin(); op != plan.end(); ++op ) {
+			if ( ( op->flags & opReadable ) && ( !formatForStreaming || ( op->flags & opStreamable ) ) ) {
+				if (need_nl) writer.separator();
+				need_nl = true;
+
+				writer.beginMember( op->name );
+				if ( op->kind == opMember ) {
+					memberToStr( writer, *op->property, inst );
+				}
+				else if ( op->kind == opDelegate ) {
+					writer.rawIndented( op->delegate->toStr( inst ) );
+				}
+				else {
+					op->fieldMetatype()._toStr( writer, op->property->get(inst), formatForStreaming );
 				}
+				writer.endMember();
 			}
 		}
-		return result += "\n}";
+		writer.closeObject();
 	}
 
 	virtual
 	boost::any
-	_fromStr( const boost::any & instance, const std::string& str, bool doCopyFromInstance = true ) {
+	_fromStr( JSONReader& reader, const boost::any & instance, bool doCopyFromInstance = true ) {
 		void * inst = get_instance_ptr(instance);
-		JSONParser parser( str );
+		const SerializationPlan& plan = _plan();
+		JSONSpan key;
 
-		for( JSONParser::iterator it = parser.begin(); it != parser.end(); ++it) {
-			if ( it->first == "$ref" ) {
-				return copyFromInstance( _nameRefMap()[ it->second ] );
+		reader.beginObject();
+		while ( reader.nextMember( key ) ) {
+			if ( reader.equals( key, "$ref" ) ) {
+				const JSONSpan id = reader.stringSpan();
+				void * ref = reader.context().nameRefs().find( reader.data( id ), id.length );
+				reader.endObject();
+				return copyFromInstance( ref );
 			}
-			if ( it->first == "$id" ) {
-				_nameRefMap()[ it->second ] = inst;
+			if ( reader.equals( key, "$id" ) ) {
+				const JSONSpan id = reader.stringSpan();
+				reader.context().nameRefs().insert( reader.data( id ), id.length, inst );
 			}
 			else
 			{
-				Property * prop = _properties()[ it->first ];
-				if ( prop ) {
-					if ( prop->isWritable() || prop->annotations().has< ForceStreamLoadable >() ) {
-						StringifyDelegateBase * stringifyDelegate = prop->annotations().getFirst< StringifyDelegateBase >();
-						if ( stringifyDelegate ) {
-							stringifyDelegate->fromStr( inst, it->second );
-						}
-						else {
-							const boost::any &mod = prop->metatype()._fromStr( prop->get( inst ), it->second );
-							if ( !mod.empty() ) {
-								prop->set( inst, mod );
-							}
+				const FieldOp * op = findFieldOp( plan, reader.data( key ), key.length );
+				if ( op && ( op->flags & opLoadable ) ) {
+					if ( op->kind == opMember ) {
+						memberFromStr( reader, *op->property, inst );
+					}
+					else if ( op->kind == opDelegate ) {
+						op->delegate->fromStr( inst, reader.rawValue() );
+					}
+					else {
+						const boost::any &mod = op->fieldMetatype()._fromStr( reader, op->property->get( inst ) );
+						if ( !mod.empty() ) {
+							op->property->set( inst, mod );
 						}
 					}
 				}
+				else {
+					reader.skipValue();
+				}
 			}
 		}
 		if ( doCopyFromInstance )
@@ -583,17 +1020,68 @@ protected:
 			return boost::any();
 	}
 
-	std::string
-	ident( std::string str ) {
-		std::string result = "\t";
-		for (std::string::iterator it = str.begin(); it !=str.end() ; ++it) {
-			if ( *it == '\n' ) {
-				result += "\n\t";
+	virtual
+	void
+	_toBinary( BinaryWriter& writer, const boost::any & instance ) {
+		void * inst = get_instance_ptr(instance);
+		writer.beginObject( holdsValue( instance ) ? NULL : inst );
+
+		const SerializationPlan& plan = _plan();
+		for( SerializationPlan::const_iterator op = plan.begin(); op != plan.end(); ++op ) {
+			if ( ( op->flags & opReadable ) && ( op->flags & opStreamable ) ) {
+				writer.member( op->name );
+				if ( op->kind == opMember ) {
+					memberToBinary( writer, *op->property, inst );
+				}
+				else if ( op->kind == opDelegate ) {
+					std::string str = op->delegate->toStr( inst );
+					JSONReader reader( str );
+					writer.string( reader.rawValue() );
+				}
+				else {
+					op->fieldMetatype()._toBinary( writer, op->property->get(inst) );
+				}
+			}
+		}
+		writer.endObject();
+	}
+
+	virtual
+	boost::any
+	_fromBinary( BinaryReader& reader, const boost::any & instance, bool doCopyFromInstance = true ) {
+		if ( reader.peekTag() == binRef ) {
+			return copyFromInstance( reader.ref() );
+		}
+
+		void * inst = get_instance_ptr(instance);
+		const SerializationPlan& plan = _plan();
+		std::string name;
+
+		reader.beginObject( inst );
+		while ( reader.nextMember( name ) ) {
+			const FieldOp * op = findFieldOp( plan, name.data(), name.length() );
+			if ( op && ( op->flags & opLoadable ) ) {
+				if ( op->kind == opMember ) {
+					memberFromBinary( reader, *op->property, inst );
+				}
+				else if ( op->kind == opDelegate ) {
+					op->delegate->fromStr( inst, reader.string() );
+				}
+				else {
+					const boost::any &mod = op->fieldMetatype()._fromBinary( reader, op->property->get( inst ) );
+					if ( !mod.empty() ) {
+						op->property->set( inst, mod );
+					}
+				}
+			}
+			else {
+				reader.skipValue();
 			}
-			else
-				result += *it;
 		}
-		return result;
+		if ( doCopyFromInstance )
+			return copyFromInstance( inst );
+		else
+			return boost::any();
 	}
 
 	virtual
@@ -603,6 +1091,165 @@ protected:
 	}
 
 private:
+	// Address of the object holding the last property of path
+	void *
+	pathInstance( const boost::any& instance, const PropertyPath& path, boost::any& holder ) {
+		void * inst = get_instance_ptr( instance );
+		for ( size_t i = 0; i + 1 < path.size(); ++i ) {
+			if ( !inst ) {
+				throw NullPtrError( path.str() );
+			}
+			Property& prop = path[ i ];
+			if ( prop.isDataMember() ) {
+				inst = prop.memberAddress( inst );
+				if ( prop.metatype().isPointer() ) {
+					inst = *static_cast< void ** >( inst );
+				}
+			}
+			else {
+				holder = prop.get( inst );
+				inst = prop.metatype().get_instance_ptr( holder );
+			}
+		}
+		if ( !inst ) {
+			throw NullPtrError( path.str() );
+		}
+		return inst;
+	}
+
+	void
+	applyPath( void * inst, const PropertyPath& path, size_t index, const boost::any& value ) {
+		if ( !inst ) {
+			throw NullPtrError( path.str() );
+		}
+		Property& prop = path[ index ];
+		if ( index + 1 == path.size() ) {
+			prop.set( inst, value );
+			return;
+		}
+		Metatype& mt = prop.metatype();
+		if ( prop.isDataMember() ) {
+			void * member = prop.memberAddress( inst );
+			applyPath( mt.isPointer() ? *static_cast< void ** >( member ) : member, path, index + 1, value );
+		}
+		else {
+			boost::any current = prop.get( inst );
+			void * child = mt.get_instance_ptr( current );
+			applyPath( child, path, index + 1, value );
+			if ( !mt.isPointer() ) {
+				prop.set( inst, mt.copyFromInstance( child ) );
+			}
+		}
+	}
+
+	// Direct memory counterparts of the fundamental and std::string metatypes serialization
+
+	static
+	void
+	memberToStr( JSONWriter& writer, Property& prop, void * inst ) {
+		void * member = prop.memberAddress( inst );
+		switch ( prop.memberKind() ) {
+			case Property::memberBool: writer.raw( *static_cast< bool * >( member ) ? "true" : "false" ); break;
+			case Property::memberChar: writer.raw( *static_cast< char * >( member ) ); break;
+			case Property::memberShort: writer.number( *static_cast< short * >( member ) ); break;
+			case Property::memberInt: writer.number( *static_cast< int * >( member ) ); break;
+			case Property::memberLong: writer.number( *static_cast< long * >( member ) ); break;
+			case Property::memberFloat: writer.number( *static_cast< float * >( member ) ); break;
+			case Property::memberDouble: writer.number( *static_cast< double * >( member ) ); break;
+			case Property::memberLongDouble: writer.number( *static_cast< long double * >( member ) ); break;
+			case Property::memberWchar: writer.number( (int)*static_cast< wchar_t * >( member ) ); break;
+			case Property::memberString: writer.string( *static_cast< std::string * >( member ) ); break;
+			default: break;
+		}
+	}
+
+	static
+	void
+	memberFromStr( JSONReader& reader, Property& prop, void * inst ) {
+		void * member = prop.memberAddress( inst );
+		switch ( prop.memberKind() ) {
+			case Property::memberBool: *static_cast< bool * >( member ) = reader.scalar()[0] == 't'; break;
+			case Property::memberChar: *static_cast< char * >( member ) = strToNum< char >( reader.scalar() ); break;
+			case Property::memberShort: *static_cast< short * >( member ) = reader.number< short >(); break;
+			case Property::memberInt: *static_cast< int * >( member ) = reader.number< int >(); break;
+			case Property::memberLong: *static_cast< long * >( member ) = reader.number< long >(); break;
+			case Property::memberFloat: *static_cast< float * >( member ) = reader.number< float >(); break;
+			case Property::memberDouble: *static_cast< double * >( member ) = reader.number< double >(); break;
+			case Property::memberLongDouble: *static_cast< long double * >( member ) = reader.number< long double >(); break;
+			case Property::memberWchar: *static_cast< wchar_t * >( member ) = (wchar_t)reader.number< int >(); break;
+			case Property::memberString: *static_cast< std::string * >( member ) = reader.string(); break;
+			default: reader.skipValue();
+		}
+	}
+
+	static
+	void
+	memberToBinary( BinaryWriter& writer, Property& prop, void * inst ) {
+		void * member = prop.memberAddress( inst );
+		switch ( prop.memberKind() ) {
+			case Property::memberBool: writer.boolean( *static_cast< bool * >( member ) ); break;
+			case Property::memberChar: writer.integer( *static_cast< char * >( member ) ); break;
+			case Property::memberShort: writer.integer( *static_cast< short * >( member ) ); break;
+			case Property::memberInt: writer.integer( *static_cast< int * >( member ) ); break;
+			case Property::memberLong: writer.integer( *static_cast< long * >( member ) ); break;
+			case Property::memberFloat: writer.real( *static_cast< float * >( member ) ); break;
+			case Property::memberDouble: writer.real( *static_cast< double * >( member ) ); break;
+			case Property::memberLongDouble: writer.real( *static_cast< long double * >( member ) ); break;
+			case Property::memberWchar: writer.integer( *static_cast< wchar_t * >( member ) ); break;
+			case Property::memberString: writer.string( *static_cast< std::string * >( member ) ); break;
+			default: break;
+		}
+	}
+
+	static
+	void
+	memberFromBinary( BinaryReader& reader, Property& prop, void * inst ) {
+		void * member = prop.memberAddress( inst );
+		switch ( prop.memberKind() ) {
+			case Property::memberBool: *static_cast< bool * >( member ) = reader.boolean(); break;
+			case Property::memberChar: *static_cast< char * >( member ) = reader.number< char >(); break;
+			case Property::memberShort: *static_cast< short * >( member ) = reader.number< short >(); break;
+			case Property::memberInt: *static_cast< int * >( member ) = reader.number< int >(); break;
+			case Property::memberLong: *static_cast< long * >( member ) = reader.number< long >(); break;
+			case Property::memberFloat: *static_cast< float * >( member ) = reader.number< float >(); break;
+			case Property::memberDouble: *static_cast< double * >( member ) = reader.number< double >(); break;
+			case Property::memberLongDouble: *static_cast< long double * >( member ) = reader.number< long double >(); break;
+			case Property::memberWchar: *static_cast< wchar_t * >( member ) = reader.number< wchar_t >(); break;
+			case Property::memberString: *static_cast< std::string * >( member ) = reader.string(); break;
+			default: reader.skipValue();
+		}
+	}
+
+	void
+	compilePlan() {
+		m_plan.clear();
+		for( PropertyMap::iterator it = _properties().begin(); it != _properties().end(); ++it) {
+			Property * prop = it->second;
+			if ( prop ) {
+				FieldOp op;
+				op.name = it->first;
+				op.property = prop;
+				op.metatype = prop->hasMetatype() ? &prop->metatype() : NULL;
+				const unsigned annotated = prop->annotations().flags();
+				op.delegate = prop->annotations().stringifyDelegate();
+				op.kind = op.delegate ? opDelegate : ( prop->memberKind() != Property::memberNone ? opMember : opValue );
+				op.flags = ( prop->isReadable() ? opReadable : 0 )
+						 | ( ( prop->isWritable() || ( annotated & Annotations::hasForceStreamLoadable ) ) ? opLoadable : 0 )
+						 | ( ( annotated & Annotations::hasNoStreamable ) ? 0 : opStreamable );
+				m_plan.push_back( op );
+			}
+		}
+		m_planVersion.store( Annotations::version() );
+		m_planValid.store( true );
+	}
+
+	void
+	buildIndexes() {
+		m_propertyIndex.build( _properties() );
+		m_methodIndex.build( _methods() );
+		m_indexesValid.store( true );
+	}
+
 	const std::type_info&	m_type_info;
 	MethodMap		m_methods;
 	MethodMap		m_ownedMethods;
@@ -611,8 +1258,40 @@ private:
 	Annotations 	m_annotations;
 	Metatype *		m_parentMetatype;
 	Metatype *		m_pointerMetatype;
+	mutable std::string	m_name;
+	mutable __Atomic< bool >	m_nameValid;
+	mutable __Mutex	m_cacheMutex;
+	SerializationPlan	m_plan;
+	__Atomic< bool >	m_planValid;
+	// Annotations::version when the plan was compiled
+	__Atomic< unsigned >	m_planVersion;
+	NameIndex< Property >	m_propertyIndex;
+	NameIndex< Method >		m_methodIndex;
+	__Atomic< bool >	m_indexesValid;
 };
 
+inline
+PropertyPath::PropertyPath( Metatype& root, const std::string& path )
+	:	m_root( &root ),
+		m_path( path )
+{
+	Metatype * mt = &root;
+	size_t start = 0;
+	for (;;) {
+		size_t pos = path.find( '.', start );
+		Property& prop = mt->property( path.data() + start, ( pos == std::string::npos ? path.length() : pos ) - start );
+		m_properties.push_back( &prop );
+		if ( pos == std::string::npos ) {
+			break;
+		}
+		if ( !prop.hasMetatype() ) {
+			throw Error( "Type of property '" + prop.name() + "' not declared in path '" + path + "'" );
+		}
+		mt = &prop.metatype();
+		start = pos + 1;
+	}
+}
+
 //------------------------------------------------------------------------------
 }; //namespace jrtti
 #endif  //jrttimetatypeH
@@ -0,0 +1,103 @@
+#ifndef jrttinameindexH
+#define jrttinameindexH
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace jrtti {
+
+/**
+ * \brief Hash index over a map of names
+ *
+ * Open addressing hash table indexing the elements of a std::map keyed by
+ * name. Lookups take the name as a pointer and a length, so names that are
+ * part of a bigger string, as a dotted path or a JSON text, are resolved
+ * without copying them.
+ * The index keeps pointers to the map keys, so it should be built again
+ * whenever the map is modified.
+ * \tparam T the type of the indexed elements
+ */
+template< typename T >
+class NameIndex {
+public:
+	NameIndex()
+		:	m_mask( 0 ) {}
+
+	/**
+	 * \brief Indexes the contents of a map
+	 * \param map the map to index
+	 */
+	template< typename MapT >
+	void
+	build( const MapT& map ) {
+		size_t capacity = 8;
+		while ( capacity < map.size() * 2 ) {
+			capacity *= 2;
+		}
+		m_slots.assign( capacity, Slot() );
+		m_mask = capacity - 1;
+		for ( typename MapT::const_iterator it = map.begin(); it != map.end(); ++it ) {
+			const size_t hashValue = hash( it->first.data(), it->first.length() );
+			size_t i = hashValue & m_mask;
+			while ( m_slots[ i ].name ) {
+				i = ( i + 1 ) & m_mask;
+			}
+			m_slots[ i ].hash = hashValue;
+			m_slots[ i ].name = &it->first;
+			m_slots[ i ].value = it->second;
+		}
+	}
+
+	/**
+	 * \brief Looks for an element by name
+	 * \param name pointer to the name, not null terminated
+	 * \param length length of the name
+	 * \return the element or NULL if not found
+	 */
+	T *
+	find( const char * name, size_t length ) const {
+		if ( m_slots.empty() ) {
+			return NULL;
+		}
+		const size_t hashValue = hash( name, length );
+		for ( size_t i = hashValue & m_mask; m_slots[ i ].name; i = ( i + 1 ) & m_mask ) {
+			const Slot& slot = m_slots[ i ];
+			if ( slot.hash == hashValue && slot.name->length() == length
+					&& !memcmp( slot.name->data(), name, length ) ) {
+				return slot.value;
+			}
+		}
+		return NULL;
+	}
+
+private:
+	struct Slot {
+		Slot()
+			:	hash( 0 ),
+				name( NULL ),
+				value( NULL ) {}
+
+		size_t				hash;
+		const std::string *	name;
+		T *					value;
+	};
+
+	// FNV-1a
+	static
+	size_t
+	hash( const char * name, size_t length ) {
+		unsigned hashValue = 2166136261u;
+		for ( const char * end = name + length; name < end; ++name ) {
+			hashValue = ( hashValue ^ (unsigned char)*name ) * 16777619u;
+		}
+		return hashValue;
+	}
+
+	std::vector< Slot >	m_slots;
+	size_t				m_mask;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jrttinameindexH
@@ -0,0 +1,1541 @@
+#ifndef jrttinumconvH
+#define jrttinumconvH
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <locale.h>
+#include <stdint.h>
+#include <limits>
+#include <string>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+namespace jrtti {
+	/**
+	 * Size of a buffer large enough to hold any number written by formatNumber
+	 */
+	const size_t maxNumberLength = 48;
+
+	struct __numconv {
+		// Floating point number with a 64 bit significand
+		struct DiyFp {
+			DiyFp( uint64_t significand = 0, int exponent = 0 )
+				:	f( significand ),
+					e( exponent ) {}
+
+			uint64_t	f;
+			int			e;
+		};
+
+		// Cached power of ten: f * 2^e approximates 10^k
+		struct CachedPower {
+			uint32_t	hi;
+			uint32_t	lo;
+			int			e;
+			int			k;
+		};
+
+		static
+		DiyFp
+		sub( const DiyFp& x, const DiyFp& y ) {
+			return DiyFp( x.f - y.f, x.e );
+		}
+
+		// Upper 64 bits of the 128 bit product, rounded
+		static
+		DiyFp
+		mul( const DiyFp& x, const DiyFp& y ) {
+			const uint64_t xLo = x.f & 0xFFFFFFFFu;
+			const uint64_t xHi = x.f >> 32;
+			const uint64_t yLo = y.f & 0xFFFFFFFFu;
+			const uint64_t yHi = y.f >> 32;
+
+			const uint64_t p0 = xLo * yLo;
+			const uint64_t p1 = xLo * yHi;
+			const uint64_t p2 = xHi * yLo;
+			const uint64_t p3 = xHi * yHi;
+
+			uint64_t q = ( p0 >> 32 ) + ( p1 & 0xFFFFFFFFu ) + ( p2 & 0xFFFFFFFFu );
+			q += uint64_t( 1 ) << 31;
+			return DiyFp( p3 + ( p1 >> 32 ) + ( p2 >> 32 ) + ( q >> 32 ), x.e + y.e + 64 );
+		}
+
+		static
+		DiyFp
+		normalize( DiyFp x ) {
+			while ( !( x.f >> 63 ) ) {
+				x.f <<= 1;
+				--x.e;
+			}
+			return x;
+		}
+
+		static
+		DiyFp
+		normalizeTo( const DiyFp& x, int exponent ) {
+			return DiyFp( x.f << ( x.e - exponent ), exponent );
+		}
+
+		// Computes the normalized value and its normalized boundaries m- and m+,
+		// using the precision of FloatType. Bits is an unsigned integer of the same size.
+		template< typename FloatType, typename Bits >
+		static
+		void
+		boundaries( FloatType value, DiyFp& w, DiyFp& minus, DiyFp& plus ) {
+			const int precision = std::numeric_limits< FloatType >::digits;
+			const int bias = std::numeric_limits< FloatType >::max_exponent - 1 + ( precision - 1 );
+			const int minExp = 1 - bias;
+			const uint64_t hiddenBit = uint64_t( 1 ) << ( precision - 1 );
+
+			Bits bits;
+			memcpy( &bits, &value, sizeof( bits ) );
+			const uint64_t exponentBits = uint64_t( bits ) >> ( precision - 1 );
+			const uint64_t fraction = uint64_t( bits ) & ( hiddenBit - 1 );
+			const int exponent = int( exponentBits & ( ( uint64_t( 1 ) << ( sizeof( Bits ) * 8 - precision ) ) - 1 ) );
+
+			const DiyFp v = exponent ? DiyFp( fraction + hiddenBit, exponent - bias )
+									 : DiyFp( fraction, minExp );
+			const bool lowerIsCloser = ( fraction == 0 ) && ( exponent > 1 );
+			plus = normalize( DiyFp( ( v.f << 1 ) + 1, v.e - 1 ) );
+			minus = normalizeTo( lowerIsCloser ? DiyFp( ( v.f << 2 ) - 1, v.e - 2 )
+											   : DiyFp( ( v.f << 1 ) - 1, v.e - 1 ), plus.e );
+			w = normalize( v );
+		}
+
+		// Returns c = 10^-k such that the binary exponent of c * 2^e lies in [-60, -32]
+		static
+		const CachedPower&
+		cachedPower( int e ) {
+			static const CachedPower powers[] = {
+				{ 0xAB70FE17, 0xC79AC6CA, -1060, -300 },
+				{ 0xFF77B1FC, 0xBEBCDC4F, -1034, -292 },
+				{ 0xBE5691EF, 0x416BD60C, -1007, -284 },
+				{ 0x8DD01FAD, 0x907FFC3C,  -980, -276 },
+				{ 0xD3515C28, 0x31559A83,  -954, -268 },
+				{ 0x9D71AC8F, 0xADA6C9B5,  -927, -260 },
+				{ 0xEA9C2277, 0x23EE8BCB,  -901, -252 },
+				{ 0xAECC4991, 0x4078536D,  -874, -244 },
+				{ 0x823C1279, 0x5DB6CE57,  -847, -236 },
+				{ 0xC2109436, 0x4DFB5637,  -821, -228 },
+				{ 0x9096EA6F, 0x3848984F,  -794, -220 },
+				{ 0xD77485CB, 0x25823AC7,  -768, -212 },
+				{ 0xA086CFCD, 0x97BF97F4,  -741, -204 },
+				{ 0xEF340A98, 0x172AACE5,  -715, -196 },
+				{ 0xB23867FB, 0x2A35B28E,  -688, -188 },
+				{ 0x84C8D4DF, 0xD2C63F3B,  -661, -180 },
+				{ 0xC5DD4427, 0x1AD3CDBA,  -635, -172 },
+				{ 0x936B9FCE, 0xBB25C996,  -608, -164 },
+				{ 0xDBAC6C24, 0x7D62A584,  -582, -156 },
+				{ 0xA3AB6658, 0x0D5FDAF6,  -555, -148 },
+				{ 0xF3E2F893, 0xDEC3F126,  -529, -140 },
+				{ 0xB5B5ADA8, 0xAAFF80B8,  -502, -132 },
+				{ 0x87625F05, 0x6C7C4A8B,  -475, -124 },
+				{ 0xC9BCFF60, 0x34C13053,  -449, -116 },
+				{ 0x964E858C, 0x91BA2655,  -422, -108 },
+				{ 0xDFF97724, 0x70297EBD,  -396, -100 },
+				{ 0xA6DFBD9F, 0xB8E5B88F,  -369,  -92 },
+				{ 0xF8A95FCF, 0x88747D94,  -343,  -84 },
+				{ 0xB9447093, 0x8FA89BCF,  -316,  -76 },
+				{ 0x8A08F0F8, 0xBF0F156B,  -289,  -68 },
+				{ 0xCDB02555, 0x653131B6,  -263,  -60 },
+				{ 0x993FE2C6, 0xD07B7FAC,  -236,  -52 },
+				{ 0xE45C10C4, 0x2A2B3B06,  -210,  -44 },
+				{ 0xAA242499, 0x697392D3,  -183,  -36 },
+				{ 0xFD87B5F2, 0x8300CA0E,  -157,  -28 },
+				{ 0xBCE50864, 0x92111AEB,  -130,  -20 },
+				{ 0x8CBCCC09, 0x6F5088CC,  -103,  -12 },
+				{ 0xD1B71758, 0xE219652C,   -77,   -4 },
+				{ 0x9C400000, 0x00000000,   -50,    4 },
+				{ 0xE8D4A510, 0x00000000,   -24,   12 },
+				{ 0xAD78EBC5, 0xAC620000,     3,   20 },
+				{ 0x813F3978, 0xF8940984,    30,   28 },
+				{ 0xC097CE7B, 0xC90715B3,    56,   36 },
+				{ 0x8F7E32CE, 0x7BEA5C70,    83,   44 },
+				{ 0xD5D238A4, 0xABE98068,   109,   52 },
+				{ 0x9F4F2726, 0x179A2245,   136,   60 },
+				{ 0xED63A231, 0xD4C4FB27,   162,   68 },
+				{ 0xB0DE6538, 0x8CC8ADA8,   189,   76 },
+				{ 0x83C7088E, 0x1AAB65DB,   216,   84 },
+				{ 0xC45D1DF9, 0x42711D9A,   242,   92 },
+				{ 0x924D692C, 0xA61BE758,   269,  100 },
+				{ 0xDA01EE64, 0x1A708DEA,   295,  108 },
+				{ 0xA26DA399, 0x9AEF774A,   322,  116 },
+				{ 0xF209787B, 0xB47D6B85,   348,  124 },
+				{ 0xB454E4A1, 0x79DD1877,   375,  132 },
+				{ 0x865B8692, 0x5B9BC5C2,   402,  140 },
+				{ 0xC83553C5, 0xC8965D3D,   428,  148 },
+				{ 0x952AB45C, 0xFA97A0B3,   455,  156 },
+				{ 0xDE469FBD, 0x99A05FE3,   481,  164 },
+				{ 0xA59BC234, 0xDB398C25,   508,  172 },
+				{ 0xF6C69A72, 0xA3989F5C,   534,  180 },
+				{ 0xB7DCBF53, 0x54E9BECE,   561,  188 },
+				{ 0x88FCF317, 0xF22241E2,   588,  196 },
+				{ 0xCC20CE9B, 0xD35C78A5,   614,  204 },
+				{ 0x98165AF3, 0x7B2153DF,   641,  212 },
+				{ 0xE2A0B5DC, 0x971F303A,   667,  220 },
+				{ 0xA8D9D153, 0x5CE3B396,   694,  228 },
+				{ 0xFB9B7CD9, 0xA4A7443C,   720,  236 },
+				{ 0xBB764C4C, 0xA7A44410,   747,  244 },
+				{ 0x8BAB8EEF, 0xB6409C1A,   774,  252 },
+				{ 0xD01FEF10, 0xA657842C,   800,  260 },
+				{ 0x9B10A4E5, 0xE9913129,   827,  268 },
+				{ 0xE7109BFB, 0xA19C0C9D,   853,  276 },
+				{ 0xAC2820D9, 0x623BF429,   880,  284 },
+				{ 0x80444B5E, 0x7AA7CF85,   907,  292 },
+				{ 0xBF21E440, 0x03ACDD2D,   933,  300 },
+				{ 0x8E679C2F, 0x5E44FF8F,   960,  308 },
+				{ 0xD433179D, 0x9C8CB841,   986,  316 },
+				{ 0x9E19DB92, 0xB4E31BA9,  1013,  324 },
+				{ 0xEB96BF6E, 0xBADF77D9,  1039,  332 },
+				{ 0xAF87023B, 0x9BF0EE6B,  1066,  340 },
+			};
+			const int minDecimalExp = -300;
+			const int decimalStep = 8;
+			const int alpha = -60;
+
+			const int f = alpha - e - 1;
+			const int k = ( f * 78913 ) / ( 1 << 18 ) + ( f > 0 );
+			return powers[ ( -minDecimalExp + k + ( decimalStep - 1 ) ) / decimalStep ];
+		}
+
+		static
+		int
+		largestPow10( uint32_t n, uint32_t& pow10 ) {
+			static const uint32_t powers[] = { 1, 10, 100, 1000, 10000, 100000, 1000000,
+											   10000000, 100000000, 1000000000 };
+			int digits = 10;
+			while ( digits > 1 && n < powers[ digits - 1 ] ) {
+				--digits;
+			}
+			pow10 = powers[ digits - 1 ];
+			return digits;
+		}
+
+		// Moves the last digit towards w while the result stays inside the boundaries
+		static
+		void
+		roundWeed( char * buffer, int length, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK ) {
+			while ( rest < dist && delta - rest >= tenK
+					&& ( rest + tenK < dist || dist - rest > rest + tenK - dist ) ) {
+				--buffer[ length - 1 ];
+				rest += tenK;
+			}
+		}
+
+		// Generates digits of a number in the interval [mMinus, mPlus], usually the shortest ones
+		static
+		void
+		generateDigits( char * buffer, int& length, int& decimalExponent, const DiyFp& mMinus, const DiyFp& w, const DiyFp& mPlus ) {
+			uint64_t delta = sub( mPlus, mMinus ).f;
+			uint64_t dist = sub( mPlus, w ).f;
+
+			const int shift = -mPlus.e;
+			const uint64_t one = uint64_t( 1 ) << shift;
+			uint32_t p1 = uint32_t( mPlus.f >> shift );
+			uint64_t p2 = mPlus.f & ( one - 1 );
+
+			uint32_t pow10;
+			int n = largestPow10( p1, pow10 );
+			while ( n > 0 ) {
+				const uint32_t d = p1 / pow10;
+				p1 %= pow10;
+				buffer[ length++ ] = char( '0' + d );
+				--n;
+				const uint64_t rest = ( uint64_t( p1 ) << shift ) + p2;
+				if ( rest <= delta ) {
+					decimalExponent += n;
+					roundWeed( buffer, length, dist, delta, rest, uint64_t( pow10 ) << shift );
+					return;
+				}
+				pow10 /= 10;
+			}
+
+			int m = 0;
+			for ( ;; ) {
+				p2 *= 10;
+				buffer[ length++ ] = char( '0' + ( p2 >> shift ) );
+				p2 &= one - 1;
+				++m;
+				delta *= 10;
+				dist *= 10;
+				if ( p2 <= delta ) {
+					break;
+				}
+			}
+			decimalExponent -= m;
+			roundWeed( buffer, length, dist, delta, p2, one );
+		}
+
+		// Grisu2: writes digits d1...dn such that d1...dn * 10^decimalExponent reads back
+		// as value. They are usually the shortest ones, but not always, as Grisu2 has no
+		// fallback for the few values where its approximation misses the shortest digits
+		template< typename FloatType, typename Bits >
+		static
+		int
+		grisu2( char * buffer, int& decimalExponent, FloatType value ) {
+			DiyFp w, mMinus, mPlus;
+			boundaries< FloatType, Bits >( value, w, mMinus, mPlus );
+
+			const CachedPower& cached = cachedPower( mPlus.e );
+			const DiyFp c( ( uint64_t( cached.hi ) << 32 ) | cached.lo, cached.e );
+			const DiyFp wMinus = mul( mMinus, c );
+			const DiyFp wPlus = mul( mPlus, c );
+
+			int length = 0;
+			decimalExponent = -cached.k;
+			generateDigits( buffer, length, decimalExponent,
+							DiyFp( wMinus.f + 1, wMinus.e ), mul( w, c ), DiyFp( wPlus.f - 1, wPlus.e ) );
+			return length;
+		}
+
+		// Lays out length digits with the given decimal exponent as a fixed or
+		// scientific notation number, in place. Returns the end of the number
+		static
+		char *
+		layout( char * buffer, int length, int decimalExponent ) {
+			const int point = length + decimalExponent;
+
+			if ( length <= point && point <= 15 ) {
+				memset( buffer + length, '0', point - length );
+				return buffer + point;
+			}
+			if ( 0 < point && point <= 15 ) {
+				memmove( buffer + point + 1, buffer + point, length - point );
+				buffer[ point ] = '.';
+				return buffer + length + 1;
+			}
+			if ( -4 < point && point <= 0 ) {
+				memmove( buffer + 2 - point, buffer, length );
+				buffer[ 0 ] = '0';
+				buffer[ 1 ] = '.';
+				memset( buffer + 2, '0', -point );
+				return buffer + 2 - point + length;
+			}
+
+			if ( length > 1 ) {
+				memmove( buffer + 2, buffer + 1, length - 1 );
+				buffer[ 1 ] = '.';
+				buffer += length + 1;
+			}
+			else {
+				++buffer;
+			}
+			int exponent = point - 1;
+			*buffer++ = 'e';
+			*buffer++ = exponent < 0 ? '-' : '+';
+			if ( exponent < 0 ) {
+				exponent = -exponent;
+			}
+			if ( exponent >= 100 ) {
+				*buffer++ = char( '0' + exponent / 100 );
+				exponent %= 100;
+			}
+			*buffer++ = char( '0' + exponent / 10 );
+			*buffer++ = char( '0' + exponent % 10 );
+			return buffer;
+		}
+
+		template< typename FloatType, typename Bits >
+		static
+		size_t
+		formatReal( char * buffer, FloatType value ) {
+			char * p = buffer;
+			Bits bits;
+			memcpy( &bits, &value, sizeof( bits ) );
+			if ( value != value ) {
+				memcpy( p, "nan", 3 );
+				return 3;
+			}
+			if ( bits >> ( sizeof( Bits ) * 8 - 1 ) ) {
+				*p++ = '-';
+				value = -value;
+			}
+			if ( value == 0 ) {
+				*p++ = '0';
+			}
+			else if ( value > std::numeric_limits< FloatType >::max() ) {
+				memcpy( p, "inf", 3 );
+				p += 3;
+			}
+			else {
+				int decimalExponent;
+				const int length = grisu2< FloatType, Bits >( p, decimalExponent, value );
+				p = layout( p, length, decimalExponent );
+			}
+			return p - buffer;
+		}
+
+		static
+		size_t
+		formatUnsigned( char * buffer, uintmax_t value ) {
+			static const char digitPairs[] =
+				"0001020304050607080910111213141516171819"
+				"2021222324252627282930313233343536373839"
+				"4041424344454647484950515253545556575859"
+				"6061626364656667686970717273747576777879"
+				"8081828384858687888990919293949596979899";
+			char digits[ 24 ];
+			char * end = digits + sizeof( digits );
+			char * p = end;
+			while ( value >= 100 ) {
+				const size_t pair = size_t( value % 100 ) * 2;
+				value /= 100;
+				*--p = digitPairs[ pair + 1 ];
+				*--p = digitPairs[ pair ];
+			}
+			if ( value >= 10 ) {
+				*--p = digitPairs[ value * 2 + 1 ];
+				*--p = digitPairs[ value * 2 ];
+			}
+			else {
+				*--p = char( '0' + value );
+			}
+			memcpy( buffer, p, end - p );
+			return end - p;
+		}
+
+		// Full 128 bit product of two 64 bit numbers
+		static
+		void
+		mulFull( uint64_t x, uint64_t y, uint64_t& hi, uint64_t& lo ) {
+			const uint64_t xLo = x & 0xFFFFFFFFu;
+			const uint64_t xHi = x >> 32;
+			const uint64_t yLo = y & 0xFFFFFFFFu;
+			const uint64_t yHi = y >> 32;
+
+			const uint64_t p0 = xLo * yLo;
+			const uint64_t p1 = xLo * yHi;
+			const uint64_t p2 = xHi * yLo;
+			const uint64_t p3 = xHi * yHi;
+
+			const uint64_t middle = ( p0 >> 32 ) + ( p1 & 0xFFFFFFFFu ) + ( p2 & 0xFFFFFFFFu );
+			lo = ( middle << 32 ) | ( p0 & 0xFFFFFFFFu );
+			hi = p3 + ( p1 >> 32 ) + ( p2 >> 32 ) + ( middle >> 32 );
+		}
+
+		static
+		int
+		leadingZeros( uint64_t x ) {
+			int n = 0;
+			if ( !( x >> 32 ) ) { n += 32; x <<= 32; }
+			if ( !( x >> 48 ) ) { n += 16; x <<= 16; }
+			if ( !( x >> 56 ) ) { n += 8; x <<= 8; }
+			if ( !( x >> 60 ) ) { n += 4; x <<= 4; }
+			if ( !( x >> 62 ) ) { n += 2; x <<= 2; }
+			if ( !( x >> 63 ) ) { n += 1; }
+			return n;
+		}
+
+		// Truncated 128 bit significand of 10^exp10, as four 32 bit words from the most significant
+		static
+		const uint32_t *
+		powerOfTen128( int exp10 ) {
+			static const uint32_t powers[][ 4 ] = {
+				{ 0xFA8FD5A0, 0x081C0288, 0x1732C869, 0xCD60E453 },
+				{ 0x9C99E584, 0x05118195, 0x0E7FBD42, 0x205C8EB4 },
+				{ 0xC3C05EE5, 0x0655E1FA, 0x521FAC92, 0xA873B261 },
+				{ 0xF4B0769E, 0x47EB5A78, 0xE6A797B7, 0x52909EF9 },
+				{ 0x98EE4A22, 0xECF3188B, 0x9028BED2, 0x939A635C },
+				{ 0xBF29DCAB, 0xA82FDEAE, 0x7432EE87, 0x3880FC33 },
+				{ 0xEEF453D6, 0x923BD65A, 0x113FAA29, 0x06A13B3F },
+				{ 0x9558B466, 0x1B6565F8, 0x4AC7CA59, 0xA424C507 },
+				{ 0xBAAEE17F, 0xA23EBF76, 0x5D79BCF0, 0x0D2DF649 },
+				{ 0xE95A99DF, 0x8ACE6F53, 0xF4D82C2C, 0x107973DC },
+				{ 0x91D8A02B, 0xB6C10594, 0x79071B9B, 0x8A4BE869 },
+				{ 0xB64EC836, 0xA47146F9, 0x9748E282, 0x6CDEE284 },
+				{ 0xE3E27A44, 0x4D8D98B7, 0xFD1B1B23, 0x08169B25 },
+				{ 0x8E6D8C6A, 0xB0787F72, 0xFE30F0F5, 0xE50E20F7 },
+				{ 0xB208EF85, 0x5C969F4F, 0xBDBD2D33, 0x5E51A935 },
+				{ 0xDE8B2B66, 0xB3BC4723, 0xAD2C7880, 0x35E61382 },
+				{ 0x8B16FB20, 0x3055AC76, 0x4C3BCB50, 0x21AFCC31 },
+				{ 0xADDCB9E8, 0x3C6B1793, 0xDF4ABE24, 0x2A1BBF3D },
+				{ 0xD953E862, 0x4B85DD78, 0xD71D6DAD, 0x34A2AF0D },
+				{ 0x87D4713D, 0x6F33AA6B, 0x8672648C, 0x40E5AD68 },
+				{ 0xA9C98D8C, 0xCB009506, 0x680EFDAF, 0x511F18C2 },
+				{ 0xD43BF0EF, 0xFDC0BA48, 0x0212BD1B, 0x2566DEF2 },
+				{ 0x84A57695, 0xFE98746D, 0x014BB630, 0xF7604B57 },
+				{ 0xA5CED43B, 0x7E3E9188, 0x419EA3BD, 0x35385E2D },
+				{ 0xCF42894A, 0x5DCE35EA, 0x52064CAC, 0x828675B9 },
+				{ 0x818995CE, 0x7AA0E1B2, 0x7343EFEB, 0xD1940993 },
+				{ 0xA1EBFB42, 0x19491A1F, 0x1014EBE6, 0xC5F90BF8 },
+				{ 0xCA66FA12, 0x9F9B60A6, 0xD41A26E0, 0x77774EF6 },
+				{ 0xFD00B897, 0x478238D0, 0x8920B098, 0x955522B4 },
+				{ 0x9E20735E, 0x8CB16382, 0x55B46E5F, 0x5D5535B0 },
+				{ 0xC5A89036, 0x2FDDBC62, 0xEB2189F7, 0x34AA831D },
+				{ 0xF712B443, 0xBBD52B7B, 0xA5E9EC75, 0x01D523E4 },
+				{ 0x9A6BB0AA, 0x55653B2D, 0x47B233C9, 0x2125366E },
+				{ 0xC1069CD4, 0xEABE89F8, 0x999EC0BB, 0x696E840A },
+				{ 0xF148440A, 0x256E2C76, 0xC00670EA, 0x43CA250D },
+				{ 0x96CD2A86, 0x5764DBCA, 0x38040692, 0x6A5E5728 },
+				{ 0xBC807527, 0xED3E12BC, 0xC6050837, 0x04F5ECF2 },
+				{ 0xEBA09271, 0xE88D976B, 0xF7864A44, 0xC633682E },
+				{ 0x93445B87, 0x31587EA3, 0x7AB3EE6A, 0xFBE0211D },
+				{ 0xB8157268, 0xFDAE9E4C, 0x5960EA05, 0xBAD82964 },
+				{ 0xE61ACF03, 0x3D1A45DF, 0x6FB92487, 0x298E33BD },
+				{ 0x8FD0C162, 0x06306BAB, 0xA5D3B6D4, 0x79F8E056 },
+				{ 0xB3C4F1BA, 0x87BC8696, 0x8F48A489, 0x9877186C },
+				{ 0xE0B62E29, 0x29ABA83C, 0x331ACDAB, 0xFE94DE87 },
+				{ 0x8C71DCD9, 0xBA0B4925, 0x9FF0C08B, 0x7F1D0B14 },
+				{ 0xAF8E5410, 0x288E1B6F, 0x07ECF0AE, 0x5EE44DD9 },
+				{ 0xDB71E914, 0x32B1A24A, 0xC9E82CD9, 0xF69D6150 },
+				{ 0x892731AC, 0x9FAF056E, 0xBE311C08, 0x3A225CD2 },
+				{ 0xAB70FE17, 0xC79AC6CA, 0x6DBD630A, 0x48AAF406 },
+				{ 0xD64D3D9D, 0xB981787D, 0x092CBBCC, 0xDAD5B108 },
+				{ 0x85F04682, 0x93F0EB4E, 0x25BBF560, 0x08C58EA5 },
+				{ 0xA76C5823, 0x38ED2621, 0xAF2AF2B8, 0x0AF6F24E },
+				{ 0xD1476E2C, 0x07286FAA, 0x1AF5AF66, 0x0DB4AEE1 },
+				{ 0x82CCA4DB, 0x847945CA, 0x50D98D9F, 0xC890ED4D },
+				{ 0xA37FCE12, 0x6597973C, 0xE50FF107, 0xBAB528A0 },
+				{ 0xCC5FC196, 0xFEFD7D0C, 0x1E53ED49, 0xA96272C8 },
+				{ 0xFF77B1FC, 0xBEBCDC4F, 0x25E8E89C, 0x13BB0F7A },
+				{ 0x9FAACF3D, 0xF73609B1, 0x77B19161, 0x8C54E9AC },
+				{ 0xC795830D, 0x75038C1D, 0xD59DF5B9, 0xEF6A2417 },
+				{ 0xF97AE3D0, 0xD2446F25, 0x4B057328, 0x6B44AD1D },
+				{ 0x9BECCE62, 0x836AC577, 0x4EE367F9, 0x430AEC32 },
+				{ 0xC2E801FB, 0x244576D5, 0x229C41F7, 0x93CDA73F },
+				{ 0xF3A20279, 0xED56D48A, 0x6B435275, 0x78C1110F },
+				{ 0x9845418C, 0x345644D6, 0x830A1389, 0x6B78AAA9 },
+				{ 0xBE5691EF, 0x416BD60C, 0x23CC986B, 0xC656D553 },
+				{ 0xEDEC366B, 0x11C6CB8F, 0x2CBFBE86, 0xB7EC8AA8 },
+				{ 0x94B3A202, 0xEB1C3F39, 0x7BF7D714, 0x32F3D6A9 },
+				{ 0xB9E08A83, 0xA5E34F07, 0xDAF5CCD9, 0x3FB0CC53 },
+				{ 0xE858AD24, 0x8F5C22C9, 0xD1B3400F, 0x8F9CFF68 },
+				{ 0x91376C36, 0xD99995BE, 0x23100809, 0xB9C21FA1 },
+				{ 0xB5854744, 0x8FFFFB2D, 0xABD40A0C, 0x2832A78A },
+				{ 0xE2E69915, 0xB3FFF9F9, 0x16C90C8F, 0x323F516C },
+				{ 0x8DD01FAD, 0x907FFC3B, 0xAE3DA7D9, 0x7F6792E3 },
+				{ 0xB1442798, 0xF49FFB4A, 0x99CD11CF, 0xDF41779C },
+				{ 0xDD95317F, 0x31C7FA1D, 0x40405643, 0xD711D583 },
+				{ 0x8A7D3EEF, 0x7F1CFC52, 0x482835EA, 0x666B2572 },
+				{ 0xAD1C8EAB, 0x5EE43B66, 0xDA324365, 0x0005EECF },
+				{ 0xD863B256, 0x369D4A40, 0x90BED43E, 0x40076A82 },
+				{ 0x873E4F75, 0xE2224E68, 0x5A7744A6, 0xE804A291 },
+				{ 0xA90DE353, 0x5AAAE202, 0x711515D0, 0xA205CB36 },
+				{ 0xD3515C28, 0x31559A83, 0x0D5A5B44, 0xCA873E03 },
+				{ 0x8412D999, 0x1ED58091, 0xE858790A, 0xFE9486C2 },
+				{ 0xA5178FFF, 0x668AE0B6, 0x626E974D, 0xBE39A872 },
+				{ 0xCE5D73FF, 0x402D98E3, 0xFB0A3D21, 0x2DC8128F },
+				{ 0x80FA687F, 0x881C7F8E, 0x7CE66634, 0xBC9D0B99 },
+				{ 0xA139029F, 0x6A239F72, 0x1C1FFFC1, 0xEBC44E80 },
+				{ 0xC9874347, 0x44AC874E, 0xA327FFB2, 0x66B56220 },
+				{ 0xFBE91419, 0x15D7A922, 0x4BF1FF9F, 0x0062BAA8 },
+				{ 0x9D71AC8F, 0xADA6C9B5, 0x6F773FC3, 0x603DB4A9 },
+				{ 0xC4CE17B3, 0x99107C22, 0xCB550FB4, 0x384D21D3 },
+				{ 0xF6019DA0, 0x7F549B2B, 0x7E2A53A1, 0x46606A48 },
+				{ 0x99C10284, 0x4F94E0FB, 0x2EDA7444, 0xCBFC426D },
+				{ 0xC0314325, 0x637A1939, 0xFA911155, 0xFEFB5308 },
+				{ 0xF03D93EE, 0xBC589F88, 0x793555AB, 0x7EBA27CA },
+				{ 0x96267C75, 0x35B763B5, 0x4BC1558B, 0x2F3458DE },
+				{ 0xBBB01B92, 0x83253CA2, 0x9EB1AAED, 0xFB016F16 },
+				{ 0xEA9C2277, 0x23EE8BCB, 0x465E15A9, 0x79C1CADC },
+				{ 0x92A1958A, 0x7675175F, 0x0BFACD89, 0xEC191EC9 },
+				{ 0xB749FAED, 0x14125D36, 0xCEF980EC, 0x671F667B },
+				{ 0xE51C79A8, 0x5916F484, 0x82B7E127, 0x80E7401A },
+				{ 0x8F31CC09, 0x37AE58D2, 0xD1B2ECB8, 0xB0908810 },
+				{ 0xB2FE3F0B, 0x8599EF07, 0x861FA7E6, 0xDCB4AA15 },
+				{ 0xDFBDCECE, 0x67006AC9, 0x67A791E0, 0x93E1D49A },
+				{ 0x8BD6A141, 0x006042BD, 0xE0C8BB2C, 0x5C6D24E0 },
+				{ 0xAECC4991, 0x4078536D, 0x58FAE9F7, 0x73886E18 },
+				{ 0xDA7F5BF5, 0x90966848, 0xAF39A475, 0x506A899E },
+				{ 0x888F9979, 0x7A5E012D, 0x6D8406C9, 0x52429603 },
+				{ 0xAAB37FD7, 0xD8F58178, 0xC8E5087B, 0xA6D33B83 },
+				{ 0xD5605FCD, 0xCF32E1D6, 0xFB1E4A9A, 0x90880A64 },
+				{ 0x855C3BE0, 0xA17FCD26, 0x5CF2EEA0, 0x9A55067F },
+				{ 0xA6B34AD8, 0xC9DFC06F, 0xF42FAA48, 0xC0EA481E },
+				{ 0xD0601D8E, 0xFC57B08B, 0xF13B94DA, 0xF124DA26 },
+				{ 0x823C1279, 0x5DB6CE57, 0x76C53D08, 0xD6B70858 },
+				{ 0xA2CB1717, 0xB52481ED, 0x54768C4B, 0x0C64CA6E },
+				{ 0xCB7DDCDD, 0xA26DA268, 0xA9942F5D, 0xCF7DFD09 },
+				{ 0xFE5D5415, 0x0B090B02, 0xD3F93B35, 0x435D7C4C },
+				{ 0x9EFA548D, 0x26E5A6E1, 0xC47BC501, 0x4A1A6DAF },
+				{ 0xC6B8E9B0, 0x709F109A, 0x359AB641, 0x9CA1091B },
+				{ 0xF867241C, 0x8CC6D4C0, 0xC30163D2, 0x03C94B62 },
+				{ 0x9B407691, 0xD7FC44F8, 0x79E0DE63, 0x425DCF1D },
+				{ 0xC2109436, 0x4DFB5636, 0x985915FC, 0x12F542E4 },
+				{ 0xF294B943, 0xE17A2BC4, 0x3E6F5B7B, 0x17B2939D },
+				{ 0x979CF3CA, 0x6CEC5B5A, 0xA705992C, 0xEECF9C42 },
+				{ 0xBD8430BD, 0x08277231, 0x50C6FF78, 0x2A838353 },
+				{ 0xECE53CEC, 0x4A314EBD, 0xA4F8BF56, 0x35246428 },
+				{ 0x940F4613, 0xAE5ED136, 0x871B7795, 0xE136BE99 },
+				{ 0xB9131798, 0x99F68584, 0x28E2557B, 0x59846E3F },
+				{ 0xE757DD7E, 0xC07426E5, 0x331AEADA, 0x2FE589CF },
+				{ 0x9096EA6F, 0x3848984F, 0x3FF0D2C8, 0x5DEF7621 },
+				{ 0xB4BCA50B, 0x065ABE63, 0x0FED077A, 0x756B53A9 },
+				{ 0xE1EBCE4D, 0xC7F16DFB, 0xD3E84959, 0x12C62894 },
+				{ 0x8D3360F0, 0x9CF6E4BD, 0x64712DD7, 0xABBBD95C },
+				{ 0xB080392C, 0xC4349DEC, 0xBD8D794D, 0x96AACFB3 },
+				{ 0xDCA04777, 0xF541C567, 0xECF0D7A0, 0xFC5583A0 },
+				{ 0x89E42CAA, 0xF9491B60, 0xF41686C4, 0x9DB57244 },
+				{ 0xAC5D37D5, 0xB79B6239, 0x311C2875, 0xC522CED5 },
+				{ 0xD77485CB, 0x25823AC7, 0x7D633293, 0x366B828B },
+				{ 0x86A8D39E, 0xF77164BC, 0xAE5DFF9C, 0x02033197 },
+				{ 0xA8530886, 0xB54DBDEB, 0xD9F57F83, 0x0283FDFC },
+				{ 0xD267CAA8, 0x62A12D66, 0xD072DF63, 0xC324FD7B },
+				{ 0x8380DEA9, 0x3DA4BC60, 0x4247CB9E, 0x59F71E6D },
+				{ 0xA4611653, 0x8D0DEB78, 0x52D9BE85, 0xF074E608 },
+				{ 0xCD795BE8, 0x70516656, 0x67902E27, 0x6C921F8B },
+				{ 0x806BD971, 0x4632DFF6, 0x00BA1CD8, 0xA3DB53B6 },
+				{ 0xA086CFCD, 0x97BF97F3, 0x80E8A40E, 0xCCD228A4 },
+				{ 0xC8A883C0, 0xFDAF7DF0, 0x6122CD12, 0x8006B2CD },
+				{ 0xFAD2A4B1, 0x3D1B5D6C, 0x796B8057, 0x20085F81 },
+				{ 0x9CC3A6EE, 0xC6311A63, 0xCBE33036, 0x74053BB0 },
+				{ 0xC3F490AA, 0x77BD60FC, 0xBEDBFC44, 0x11068A9C },
+				{ 0xF4F1B4D5, 0x15ACB93B, 0xEE92FB55, 0x15482D44 },
+				{ 0x99171105, 0x2D8BF3C5, 0x751BDD15, 0x2D4D1C4A },
+				{ 0xBF5CD546, 0x78EEF0B6, 0xD262D45A, 0x78A0635D },
+				{ 0xEF340A98, 0x172AACE4, 0x86FB8971, 0x16C87C34 },
+				{ 0x9580869F, 0x0E7AAC0E, 0xD45D35E6, 0xAE3D4DA0 },
+				{ 0xBAE0A846, 0xD2195712, 0x89748360, 0x59CCA109 },
+				{ 0xE998D258, 0x869FACD7, 0x2BD1A438, 0x703FC94B },
+				{ 0x91FF8377, 0x5423CC06, 0x7B6306A3, 0x4627DDCF },
+				{ 0xB67F6455, 0x292CBF08, 0x1A3BC84C, 0x17B1D542 },
+				{ 0xE41F3D6A, 0x7377EECA, 0x20CABA5F, 0x1D9E4A93 },
+				{ 0x8E938662, 0x882AF53E, 0x547EB47B, 0x7282EE9C },
+				{ 0xB23867FB, 0x2A35B28D, 0xE99E619A, 0x4F23AA43 },
+				{ 0xDEC681F9, 0xF4C31F31, 0x6405FA00, 0xE2EC94D4 },
+				{ 0x8B3C113C, 0x38F9F37E, 0xDE83BC40, 0x8DD3DD04 },
+				{ 0xAE0B158B, 0x4738705E, 0x9624AB50, 0xB148D445 },
+				{ 0xD98DDAEE, 0x19068C76, 0x3BADD624, 0xDD9B0957 },
+				{ 0x87F8A8D4, 0xCFA417C9, 0xE54CA5D7, 0x0A80E5D6 },
+				{ 0xA9F6D30A, 0x038D1DBC, 0x5E9FCF4C, 0xCD211F4C },
+				{ 0xD47487CC, 0x8470652B, 0x7647C320, 0x0069671F },
+				{ 0x84C8D4DF, 0xD2C63F3B, 0x29ECD9F4, 0x0041E073 },
+				{ 0xA5FB0A17, 0xC777CF09, 0xF4681071, 0x00525890 },
+				{ 0xCF79CC9D, 0xB955C2CC, 0x7182148D, 0x4066EEB4 },
+				{ 0x81AC1FE2, 0x93D599BF, 0xC6F14CD8, 0x48405530 },
+				{ 0xA21727DB, 0x38CB002F, 0xB8ADA00E, 0x5A506A7C },
+				{ 0xCA9CF1D2, 0x06FDC03B, 0xA6D90811, 0xF0E4851C },
+				{ 0xFD442E46, 0x88BD304A, 0x908F4A16, 0x6D1DA663 },
+				{ 0x9E4A9CEC, 0x15763E2E, 0x9A598E4E, 0x043287FE },
+				{ 0xC5DD4427, 0x1AD3CDBA, 0x40EFF1E1, 0x853F29FD },
+				{ 0xF7549530, 0xE188C128, 0xD12BEE59, 0xE68EF47C },
+				{ 0x9A94DD3E, 0x8CF578B9, 0x82BB74F8, 0x301958CE },
+				{ 0xC13A148E, 0x3032D6E7, 0xE36A5236, 0x3C1FAF01 },
+				{ 0xF18899B1, 0xBC3F8CA1, 0xDC44E6C3, 0xCB279AC1 },
+				{ 0x96F5600F, 0x15A7B7E5, 0x29AB103A, 0x5EF8C0B9 },
+				{ 0xBCB2B812, 0xDB11A5DE, 0x7415D448, 0xF6B6F0E7 },
+				{ 0xEBDF6617, 0x91D60F56, 0x111B495B, 0x3464AD21 },
+				{ 0x936B9FCE, 0xBB25C995, 0xCAB10DD9, 0x00BEEC34 },
+				{ 0xB84687C2, 0x69EF3BFB, 0x3D5D514F, 0x40EEA742 },
+				{ 0xE65829B3, 0x046B0AFA, 0x0CB4A5A3, 0x112A5112 },
+				{ 0x8FF71A0F, 0xE2C2E6DC, 0x47F0E785, 0xEABA72AB },
+				{ 0xB3F4E093, 0xDB73A093, 0x59ED2167, 0x65690F56 },
+				{ 0xE0F218B8, 0xD25088B8, 0x306869C1, 0x3EC3532C },
+				{ 0x8C974F73, 0x83725573, 0x1E414218, 0xC73A13FB },
+				{ 0xAFBD2350, 0x644EEACF, 0xE5D1929E, 0xF90898FA },
+				{ 0xDBAC6C24, 0x7D62A583, 0xDF45F746, 0xB74ABF39 },
+				{ 0x894BC396, 0xCE5DA772, 0x6B8BBA8C, 0x328EB783 },
+				{ 0xAB9EB47C, 0x81F5114F, 0x066EA92F, 0x3F326564 },
+				{ 0xD686619B, 0xA27255A2, 0xC80A537B, 0x0EFEFEBD },
+				{ 0x8613FD01, 0x45877585, 0xBD06742C, 0xE95F5F36 },
+				{ 0xA798FC41, 0x96E952E7, 0x2C481138, 0x23B73704 },
+				{ 0xD17F3B51, 0xFCA3A7A0, 0xF75A1586, 0x2CA504C5 },
+				{ 0x82EF8513, 0x3DE648C4, 0x9A984D73, 0xDBE722FB },
+				{ 0xA3AB6658, 0x0D5FDAF5, 0xC13E60D0, 0xD2E0EBBA },
+				{ 0xCC963FEE, 0x10B7D1B3, 0x318DF905, 0x079926A8 },
+				{ 0xFFBBCFE9, 0x94E5C61F, 0xFDF17746, 0x497F7052 },
+				{ 0x9FD561F1, 0xFD0F9BD3, 0xFEB6EA8B, 0xEDEFA633 },
+				{ 0xC7CABA6E, 0x7C5382C8, 0xFE64A52E, 0xE96B8FC0 },
+				{ 0xF9BD690A, 0x1B68637B, 0x3DFDCE7A, 0xA3C673B0 },
+				{ 0x9C1661A6, 0x51213E2D, 0x06BEA10C, 0xA65C084E },
+				{ 0xC31BFA0F, 0xE5698DB8, 0x486E494F, 0xCFF30A62 },
+				{ 0xF3E2F893, 0xDEC3F126, 0x5A89DBA3, 0xC3EFCCFA },
+				{ 0x986DDB5C, 0x6B3A76B7, 0xF8962946, 0x5A75E01C },
+				{ 0xBE895233, 0x86091465, 0xF6BBB397, 0xF1135823 },
+				{ 0xEE2BA6C0, 0x678B597F, 0x746AA07D, 0xED582E2C },
+				{ 0x94DB4838, 0x40B717EF, 0xA8C2A44E, 0xB4571CDC },
+				{ 0xBA121A46, 0x50E4DDEB, 0x92F34D62, 0x616CE413 },
+				{ 0xE896A0D7, 0xE51E1566, 0x77B020BA, 0xF9C81D17 },
+				{ 0x915E2486, 0xEF32CD60, 0x0ACE1474, 0xDC1D122E },
+				{ 0xB5B5ADA8, 0xAAFF80B8, 0x0D819992, 0x132456BA },
+				{ 0xE3231912, 0xD5BF60E6, 0x10E1FFF6, 0x97ED6C69 },
+				{ 0x8DF5EFAB, 0xC5979C8F, 0xCA8D3FFA, 0x1EF463C1 },
+				{ 0xB1736B96, 0xB6FD83B3, 0xBD308FF8, 0xA6B17CB2 },
+				{ 0xDDD0467C, 0x64BCE4A0, 0xAC7CB3F6, 0xD05DDBDE },
+				{ 0x8AA22C0D, 0xBEF60EE4, 0x6BCDF07A, 0x423AA96B },
+				{ 0xAD4AB711, 0x2EB3929D, 0x86C16C98, 0xD2C953C6 },
+				{ 0xD89D64D5, 0x7A607744, 0xE871C7BF, 0x077BA8B7 },
+				{ 0x87625F05, 0x6C7C4A8B, 0x11471CD7, 0x64AD4972 },
+				{ 0xA93AF6C6, 0xC79B5D2D, 0xD598E40D, 0x3DD89BCF },
+				{ 0xD389B478, 0x79823479, 0x4AFF1D10, 0x8D4EC2C3 },
+				{ 0x843610CB, 0x4BF160CB, 0xCEDF722A, 0x585139BA },
+				{ 0xA54394FE, 0x1EEDB8FE, 0xC2974EB4, 0xEE658828 },
+				{ 0xCE947A3D, 0xA6A9273E, 0x733D2262, 0x29FEEA32 },
+				{ 0x811CCC66, 0x8829B887, 0x0806357D, 0x5A3F525F },
+				{ 0xA163FF80, 0x2A3426A8, 0xCA07C2DC, 0xB0CF26F7 },
+				{ 0xC9BCFF60, 0x34C13052, 0xFC89B393, 0xDD02F0B5 },
+				{ 0xFC2C3F38, 0x41F17C67, 0xBBAC2078, 0xD443ACE2 },
+				{ 0x9D9BA783, 0x2936EDC0, 0xD54B944B, 0x84AA4C0D },
+				{ 0xC5029163, 0xF384A931, 0x0A9E795E, 0x65D4DF11 },
+				{ 0xF64335BC, 0xF065D37D, 0x4D4617B5, 0xFF4A16D5 },
+				{ 0x99EA0196, 0x163FA42E, 0x504BCED1, 0xBF8E4E45 },
+				{ 0xC06481FB, 0x9BCF8D39, 0xE45EC286, 0x2F71E1D6 },
+				{ 0xF07DA27A, 0x82C37088, 0x5D767327, 0xBB4E5A4C },
+				{ 0x964E858C, 0x91BA2655, 0x3A6A07F8, 0xD510F86F },
+				{ 0xBBE226EF, 0xB628AFEA, 0x890489F7, 0x0A55368B },
+				{ 0xEADAB0AB, 0xA3B2DBE5, 0x2B45AC74, 0xCCEA842E },
+				{ 0x92C8AE6B, 0x464FC96F, 0x3B0B8BC9, 0x0012929D },
+				{ 0xB77ADA06, 0x17E3BBCB, 0x09CE6EBB, 0x40173744 },
+				{ 0xE5599087, 0x9DDCAABD, 0xCC420A6A, 0x101D0515 },
+				{ 0x8F57FA54, 0xC2A9EAB6, 0x9FA94682, 0x4A12232D },
+				{ 0xB32DF8E9, 0xF3546564, 0x47939822, 0xDC96ABF9 },
+				{ 0xDFF97724, 0x70297EBD, 0x59787E2B, 0x93BC56F7 },
+				{ 0x8BFBEA76, 0xC619EF36, 0x57EB4EDB, 0x3C55B65A },
+				{ 0xAEFAE514, 0x77A06B03, 0xEDE62292, 0x0B6B23F1 },
+				{ 0xDAB99E59, 0x958885C4, 0xE95FAB36, 0x8E45ECED },
+				{ 0x88B402F7, 0xFD75539B, 0x11DBCB02, 0x18EBB414 },
+				{ 0xAAE103B5, 0xFCD2A881, 0xD652BDC2, 0x9F26A119 },
+				{ 0xD59944A3, 0x7C0752A2, 0x4BE76D33, 0x46F0495F },
+				{ 0x857FCAE6, 0x2D8493A5, 0x6F70A440, 0x0C562DDB },
+				{ 0xA6DFBD9F, 0xB8E5B88E, 0xCB4CCD50, 0x0F6BB952 },
+				{ 0xD097AD07, 0xA71F26B2, 0x7E2000A4, 0x1346A7A7 },
+				{ 0x825ECC24, 0xC873782F, 0x8ED40066, 0x8C0C28C8 },
+				{ 0xA2F67F2D, 0xFA90563B, 0x72890080, 0x2F0F32FA },
+				{ 0xCBB41EF9, 0x79346BCA, 0x4F2B40A0, 0x3AD2FFB9 },
+				{ 0xFEA126B7, 0xD78186BC, 0xE2F610C8, 0x4987BFA8 },
+				{ 0x9F24B832, 0xE6B0F436, 0x0DD9CA7D, 0x2DF4D7C9 },
+				{ 0xC6EDE63F, 0xA05D3143, 0x91503D1C, 0x79720DBB },
+				{ 0xF8A95FCF, 0x88747D94, 0x75A44C63, 0x97CE912A },
+				{ 0x9B69DBE1, 0xB548CE7C, 0xC986AFBE, 0x3EE11ABA },
+				{ 0xC24452DA, 0x229B021B, 0xFBE85BAD, 0xCE996168 },
+				{ 0xF2D56790, 0xAB41C2A2, 0xFAE27299, 0x423FB9C3 },
+				{ 0x97C560BA, 0x6B0919A5, 0xDCCD879F, 0xC967D41A },
+				{ 0xBDB6B8E9, 0x05CB600F, 0x5400E987, 0xBBC1C920 },
+				{ 0xED246723, 0x473E3813, 0x290123E9, 0xAAB23B68 },
+				{ 0x9436C076, 0x0C86E30B, 0xF9A0B672, 0x0AAF6521 },
+				{ 0xB9447093, 0x8FA89BCE, 0xF808E40E, 0x8D5B3E69 },
+				{ 0xE7958CB8, 0x7392C2C2, 0xB60B1D12, 0x30B20E04 },
+				{ 0x90BD77F3, 0x483BB9B9, 0xB1C6F22B, 0x5E6F48C2 },
+				{ 0xB4ECD5F0, 0x1A4AA828, 0x1E38AEB6, 0x360B1AF3 },
+				{ 0xE2280B6C, 0x20DD5232, 0x25C6DA63, 0xC38DE1B0 },
+				{ 0x8D590723, 0x948A535F, 0x579C487E, 0x5A38AD0E },
+				{ 0xB0AF48EC, 0x79ACE837, 0x2D835A9D, 0xF0C6D851 },
+				{ 0xDCDB1B27, 0x98182244, 0xF8E43145, 0x6CF88E65 },
+				{ 0x8A08F0F8, 0xBF0F156B, 0x1B8E9ECB, 0x641B58FF },
+				{ 0xAC8B2D36, 0xEED2DAC5, 0xE272467E, 0x3D222F3F },
+				{ 0xD7ADF884, 0xAA879177, 0x5B0ED81D, 0xCC6ABB0F },
+				{ 0x86CCBB52, 0xEA94BAEA, 0x98E94712, 0x9FC2B4E9 },
+				{ 0xA87FEA27, 0xA539E9A5, 0x3F2398D7, 0x47B36224 },
+				{ 0xD29FE4B1, 0x8E88640E, 0x8EEC7F0D, 0x19A03AAD },
+				{ 0x83A3EEEE, 0xF9153E89, 0x1953CF68, 0x300424AC },
+				{ 0xA48CEAAA, 0xB75A8E2B, 0x5FA8C342, 0x3C052DD7 },
+				{ 0xCDB02555, 0x653131B6, 0x3792F412, 0xCB06794D },
+				{ 0x808E1755, 0x5F3EBF11, 0xE2BBD88B, 0xBEE40BD0 },
+				{ 0xA0B19D2A, 0xB70E6ED6, 0x5B6ACEAE, 0xAE9D0EC4 },
+				{ 0xC8DE0475, 0x64D20A8B, 0xF245825A, 0x5A445275 },
+				{ 0xFB158592, 0xBE068D2E, 0xEED6E2F0, 0xF0D56712 },
+				{ 0x9CED737B, 0xB6C4183D, 0x55464DD6, 0x9685606B },
+				{ 0xC428D05A, 0xA4751E4C, 0xAA97E14C, 0x3C26B886 },
+				{ 0xF5330471, 0x4D9265DF, 0xD53DD99F, 0x4B3066A8 },
+				{ 0x993FE2C6, 0xD07B7FAB, 0xE546A803, 0x8EFE4029 },
+				{ 0xBF8FDB78, 0x849A5F96, 0xDE985204, 0x72BDD033 },
+				{ 0xEF73D256, 0xA5C0F77C, 0x963E6685, 0x8F6D4440 },
+				{ 0x95A86376, 0x27989AAD, 0xDDE70013, 0x79A44AA8 },
+				{ 0xBB127C53, 0xB17EC159, 0x5560C018, 0x580D5D52 },
+				{ 0xE9D71B68, 0x9DDE71AF, 0xAAB8F01E, 0x6E10B4A6 },
+				{ 0x92267121, 0x62AB070D, 0xCAB39613, 0x04CA70E8 },
+				{ 0xB6B00D69, 0xBB55C8D1, 0x3D607B97, 0xC5FD0D22 },
+				{ 0xE45C10C4, 0x2A2B3B05, 0x8CB89A7D, 0xB77C506A },
+				{ 0x8EB98A7A, 0x9A5B04E3, 0x77F3608E, 0x92ADB242 },
+				{ 0xB267ED19, 0x40F1C61C, 0x55F038B2, 0x37591ED3 },
+				{ 0xDF01E85F, 0x912E37A3, 0x6B6C46DE, 0xC52F6688 },
+				{ 0x8B61313B, 0xBABCE2C6, 0x2323AC4B, 0x3B3DA015 },
+				{ 0xAE397D8A, 0xA96C1B77, 0xABEC975E, 0x0A0D081A },
+				{ 0xD9C7DCED, 0x53C72255, 0x96E7BD35, 0x8C904A21 },
+				{ 0x881CEA14, 0x545C7575, 0x7E50D641, 0x77DA2E54 },
+				{ 0xAA242499, 0x697392D2, 0xDDE50BD1, 0xD5D0B9E9 },
+				{ 0xD4AD2DBF, 0xC3D07787, 0x955E4EC6, 0x4B44E864 },
+				{ 0x84EC3C97, 0xDA624AB4, 0xBD5AF13B, 0xEF0B113E },
+				{ 0xA6274BBD, 0xD0FADD61, 0xECB1AD8A, 0xEACDD58E },
+				{ 0xCFB11EAD, 0x453994BA, 0x67DE18ED, 0xA5814AF2 },
+				{ 0x81CEB32C, 0x4B43FCF4, 0x80EACF94, 0x8770CED7 },
+				{ 0xA2425FF7, 0x5E14FC31, 0xA1258379, 0xA94D028D },
+				{ 0xCAD2F7F5, 0x359A3B3E, 0x096EE458, 0x13A04330 },
+				{ 0xFD87B5F2, 0x8300CA0D, 0x8BCA9D6E, 0x188853FC },
+				{ 0x9E74D1B7, 0x91E07E48, 0x775EA264, 0xCF55347D },
+				{ 0xC6120625, 0x76589DDA, 0x95364AFE, 0x032A819D },
+				{ 0xF79687AE, 0xD3EEC551, 0x3A83DDBD, 0x83F52204 },
+				{ 0x9ABE14CD, 0x44753B52, 0xC4926A96, 0x72793542 },
+				{ 0xC16D9A00, 0x95928A27, 0x75B7053C, 0x0F178293 },
+				{ 0xF1C90080, 0xBAF72CB1, 0x5324C68B, 0x12DD6338 },
+				{ 0x971DA050, 0x74DA7BEE, 0xD3F6FC16, 0xEBCA5E03 },
+				{ 0xBCE50864, 0x92111AEA, 0x88F4BB1C, 0xA6BCF584 },
+				{ 0xEC1E4A7D, 0xB69561A5, 0x2B31E9E3, 0xD06C32E5 },
+				{ 0x9392EE8E, 0x921D5D07, 0x3AFF322E, 0x62439FCF },
+				{ 0xB877AA32, 0x36A4B449, 0x09BEFEB9, 0xFAD487C2 },
+				{ 0xE69594BE, 0xC44DE15B, 0x4C2EBE68, 0x7989A9B3 },
+				{ 0x901D7CF7, 0x3AB0ACD9, 0x0F9D3701, 0x4BF60A10 },
+				{ 0xB424DC35, 0x095CD80F, 0x538484C1, 0x9EF38C94 },
+				{ 0xE12E1342, 0x4BB40E13, 0x2865A5F2, 0x06B06FB9 },
+				{ 0x8CBCCC09, 0x6F5088CB, 0xF93F87B7, 0x442E45D3 },
+				{ 0xAFEBFF0B, 0xCB24AAFE, 0xF78F69A5, 0x1539D748 },
+				{ 0xDBE6FECE, 0xBDEDD5BE, 0xB573440E, 0x5A884D1B },
+				{ 0x89705F41, 0x36B4A597, 0x31680A88, 0xF8953030 },
+				{ 0xABCC7711, 0x8461CEFC, 0xFDC20D2B, 0x36BA7C3D },
+				{ 0xD6BF94D5, 0xE57A42BC, 0x3D329076, 0x04691B4C },
+				{ 0x8637BD05, 0xAF6C69B5, 0xA63F9A49, 0xC2C1B10F },
+				{ 0xA7C5AC47, 0x1B478423, 0x0FCF80DC, 0x33721D53 },
+				{ 0xD1B71758, 0xE219652B, 0xD3C36113, 0x404EA4A8 },
+				{ 0x83126E97, 0x8D4FDF3B, 0x645A1CAC, 0x083126E9 },
+				{ 0xA3D70A3D, 0x70A3D70A, 0x3D70A3D7, 0x0A3D70A3 },
+				{ 0xCCCCCCCC, 0xCCCCCCCC, 0xCCCCCCCC, 0xCCCCCCCC },
+				{ 0x80000000, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xA0000000, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xC8000000, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xFA000000, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0x9C400000, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xC3500000, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xF4240000, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0x98968000, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xBEBC2000, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xEE6B2800, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0x9502F900, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xBA43B740, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xE8D4A510, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0x9184E72A, 0x00000000, 0x00000000, 0x00000000 },
+				{ 0xB5E620F4, 0x80000000, 0x00000000, 0x00000000 },
+				{ 0xE35FA931, 0xA0000000, 0x00000000, 0x00000000 },
+				{ 0x8E1BC9BF, 0x04000000, 0x00000000, 0x00000000 },
+				{ 0xB1A2BC2E, 0xC5000000, 0x00000000, 0x00000000 },
+				{ 0xDE0B6B3A, 0x76400000, 0x00000000, 0x00000000 },
+				{ 0x8AC72304, 0x89E80000, 0x00000000, 0x00000000 },
+				{ 0xAD78EBC5, 0xAC620000, 0x00000000, 0x00000000 },
+				{ 0xD8D726B7, 0x177A8000, 0x00000000, 0x00000000 },
+				{ 0x87867832, 0x6EAC9000, 0x00000000, 0x00000000 },
+				{ 0xA968163F, 0x0A57B400, 0x00000000, 0x00000000 },
+				{ 0xD3C21BCE, 0xCCEDA100, 0x00000000, 0x00000000 },
+				{ 0x84595161, 0x401484A0, 0x00000000, 0x00000000 },
+				{ 0xA56FA5B9, 0x9019A5C8, 0x00000000, 0x00000000 },
+				{ 0xCECB8F27, 0xF4200F3A, 0x00000000, 0x00000000 },
+				{ 0x813F3978, 0xF8940984, 0x40000000, 0x00000000 },
+				{ 0xA18F07D7, 0x36B90BE5, 0x50000000, 0x00000000 },
+				{ 0xC9F2C9CD, 0x04674EDE, 0xA4000000, 0x00000000 },
+				{ 0xFC6F7C40, 0x45812296, 0x4D000000, 0x00000000 },
+				{ 0x9DC5ADA8, 0x2B70B59D, 0xF0200000, 0x00000000 },
+				{ 0xC5371912, 0x364CE305, 0x6C280000, 0x00000000 },
+				{ 0xF684DF56, 0xC3E01BC6, 0xC7320000, 0x00000000 },
+				{ 0x9A130B96, 0x3A6C115C, 0x3C7F4000, 0x00000000 },
+				{ 0xC097CE7B, 0xC90715B3, 0x4B9F1000, 0x00000000 },
+				{ 0xF0BDC21A, 0xBB48DB20, 0x1E86D400, 0x00000000 },
+				{ 0x96769950, 0xB50D88F4, 0x13144480, 0x00000000 },
+				{ 0xBC143FA4, 0xE250EB31, 0x17D955A0, 0x00000000 },
+				{ 0xEB194F8E, 0x1AE525FD, 0x5DCFAB08, 0x00000000 },
+				{ 0x92EFD1B8, 0xD0CF37BE, 0x5AA1CAE5, 0x00000000 },
+				{ 0xB7ABC627, 0x050305AD, 0xF14A3D9E, 0x40000000 },
+				{ 0xE596B7B0, 0xC643C719, 0x6D9CCD05, 0xD0000000 },
+				{ 0x8F7E32CE, 0x7BEA5C6F, 0xE4820023, 0xA2000000 },
+				{ 0xB35DBF82, 0x1AE4F38B, 0xDDA2802C, 0x8A800000 },
+				{ 0xE0352F62, 0xA19E306E, 0xD50B2037, 0xAD200000 },
+				{ 0x8C213D9D, 0xA502DE45, 0x4526F422, 0xCC340000 },
+				{ 0xAF298D05, 0x0E4395D6, 0x9670B12B, 0x7F410000 },
+				{ 0xDAF3F046, 0x51D47B4C, 0x3C0CDD76, 0x5F114000 },
+				{ 0x88D8762B, 0xF324CD0F, 0xA5880A69, 0xFB6AC800 },
+				{ 0xAB0E93B6, 0xEFEE0053, 0x8EEA0D04, 0x7A457A00 },
+				{ 0xD5D238A4, 0xABE98068, 0x72A49045, 0x98D6D880 },
+				{ 0x85A36366, 0xEB71F041, 0x47A6DA2B, 0x7F864750 },
+				{ 0xA70C3C40, 0xA64E6C51, 0x999090B6, 0x5F67D924 },
+				{ 0xD0CF4B50, 0xCFE20765, 0xFFF4B4E3, 0xF741CF6D },
+				{ 0x82818F12, 0x81ED449F, 0xBFF8F10E, 0x7A8921A4 },
+				{ 0xA321F2D7, 0x226895C7, 0xAFF72D52, 0x192B6A0D },
+				{ 0xCBEA6F8C, 0xEB02BB39, 0x9BF4F8A6, 0x9F764490 },
+				{ 0xFEE50B70, 0x25C36A08, 0x02F236D0, 0x4753D5B4 },
+				{ 0x9F4F2726, 0x179A2245, 0x01D76242, 0x2C946590 },
+				{ 0xC722F0EF, 0x9D80AAD6, 0x424D3AD2, 0xB7B97EF5 },
+				{ 0xF8EBAD2B, 0x84E0D58B, 0xD2E08987, 0x65A7DEB2 },
+				{ 0x9B934C3B, 0x330C8577, 0x63CC55F4, 0x9F88EB2F },
+				{ 0xC2781F49, 0xFFCFA6D5, 0x3CBF6B71, 0xC76B25FB },
+				{ 0xF316271C, 0x7FC3908A, 0x8BEF464E, 0x3945EF7A },
+				{ 0x97EDD871, 0xCFDA3A56, 0x97758BF0, 0xE3CBB5AC },
+				{ 0xBDE94E8E, 0x43D0C8EC, 0x3D52EEED, 0x1CBEA317 },
+				{ 0xED63A231, 0xD4C4FB27, 0x4CA7AAA8, 0x63EE4BDD },
+				{ 0x945E455F, 0x24FB1CF8, 0x8FE8CAA9, 0x3E74EF6A },
+				{ 0xB975D6B6, 0xEE39E436, 0xB3E2FD53, 0x8E122B44 },
+				{ 0xE7D34C64, 0xA9C85D44, 0x60DBBCA8, 0x7196B616 },
+				{ 0x90E40FBE, 0xEA1D3A4A, 0xBC8955E9, 0x46FE31CD },
+				{ 0xB51D13AE, 0xA4A488DD, 0x6BABAB63, 0x98BDBE41 },
+				{ 0xE264589A, 0x4DCDAB14, 0xC696963C, 0x7EED2DD1 },
+				{ 0x8D7EB760, 0x70A08AEC, 0xFC1E1DE5, 0xCF543CA2 },
+				{ 0xB0DE6538, 0x8CC8ADA8, 0x3B25A55F, 0x43294BCB },
+				{ 0xDD15FE86, 0xAFFAD912, 0x49EF0EB7, 0x13F39EBE },
+				{ 0x8A2DBF14, 0x2DFCC7AB, 0x6E356932, 0x6C784337 },
+				{ 0xACB92ED9, 0x397BF996, 0x49C2C37F, 0x07965404 },
+				{ 0xD7E77A8F, 0x87DAF7FB, 0xDC33745E, 0xC97BE906 },
+				{ 0x86F0AC99, 0xB4E8DAFD, 0x69A028BB, 0x3DED71A3 },
+				{ 0xA8ACD7C0, 0x222311BC, 0xC40832EA, 0x0D68CE0C },
+				{ 0xD2D80DB0, 0x2AABD62B, 0xF50A3FA4, 0x90C30190 },
+				{ 0x83C7088E, 0x1AAB65DB, 0x792667C6, 0xDA79E0FA },
+				{ 0xA4B8CAB1, 0xA1563F52, 0x577001B8, 0x91185938 },
+				{ 0xCDE6FD5E, 0x09ABCF26, 0xED4C0226, 0xB55E6F86 },
+				{ 0x80B05E5A, 0xC60B6178, 0x544F8158, 0x315B05B4 },
+				{ 0xA0DC75F1, 0x778E39D6, 0x696361AE, 0x3DB1C721 },
+				{ 0xC913936D, 0xD571C84C, 0x03BC3A19, 0xCD1E38E9 },
+				{ 0xFB587849, 0x4ACE3A5F, 0x04AB48A0, 0x4065C723 },
+				{ 0x9D174B2D, 0xCEC0E47B, 0x62EB0D64, 0x283F9C76 },
+				{ 0xC45D1DF9, 0x42711D9A, 0x3BA5D0BD, 0x324F8394 },
+				{ 0xF5746577, 0x930D6500, 0xCA8F44EC, 0x7EE36479 },
+				{ 0x9968BF6A, 0xBBE85F20, 0x7E998B13, 0xCF4E1ECB },
+				{ 0xBFC2EF45, 0x6AE276E8, 0x9E3FEDD8, 0xC321A67E },
+				{ 0xEFB3AB16, 0xC59B14A2, 0xC5CFE94E, 0xF3EA101E },
+				{ 0x95D04AEE, 0x3B80ECE5, 0xBBA1F1D1, 0x58724A12 },
+				{ 0xBB445DA9, 0xCA61281F, 0x2A8A6E45, 0xAE8EDC97 },
+				{ 0xEA157514, 0x3CF97226, 0xF52D09D7, 0x1A3293BD },
+				{ 0x924D692C, 0xA61BE758, 0x593C2626, 0x705F9C56 },
+				{ 0xB6E0C377, 0xCFA2E12E, 0x6F8B2FB0, 0x0C77836C },
+				{ 0xE498F455, 0xC38B997A, 0x0B6DFB9C, 0x0F956447 },
+				{ 0x8EDF98B5, 0x9A373FEC, 0x4724BD41, 0x89BD5EAC },
+				{ 0xB2977EE3, 0x00C50FE7, 0x58EDEC91, 0xEC2CB657 },
+				{ 0xDF3D5E9B, 0xC0F653E1, 0x2F2967B6, 0x6737E3ED },
+				{ 0x8B865B21, 0x5899F46C, 0xBD79E0D2, 0x0082EE74 },
+				{ 0xAE67F1E9, 0xAEC07187, 0xECD85906, 0x80A3AA11 },
+				{ 0xDA01EE64, 0x1A708DE9, 0xE80E6F48, 0x20CC9495 },
+				{ 0x884134FE, 0x908658B2, 0x3109058D, 0x147FDCDD },
+				{ 0xAA51823E, 0x34A7EEDE, 0xBD4B46F0, 0x599FD415 },
+				{ 0xD4E5E2CD, 0xC1D1EA96, 0x6C9E18AC, 0x7007C91A },
+				{ 0x850FADC0, 0x9923329E, 0x03E2CF6B, 0xC604DDB0 },
+				{ 0xA6539930, 0xBF6BFF45, 0x84DB8346, 0xB786151C },
+				{ 0xCFE87F7C, 0xEF46FF16, 0xE6126418, 0x65679A63 },
+				{ 0x81F14FAE, 0x158C5F6E, 0x4FCB7E8F, 0x3F60C07E },
+				{ 0xA26DA399, 0x9AEF7749, 0xE3BE5E33, 0x0F38F09D },
+				{ 0xCB090C80, 0x01AB551C, 0x5CADF5BF, 0xD3072CC5 },
+				{ 0xFDCB4FA0, 0x02162A63, 0x73D9732F, 0xC7C8F7F6 },
+				{ 0x9E9F11C4, 0x014DDA7E, 0x2867E7FD, 0xDCDD9AFA },
+				{ 0xC646D635, 0x01A1511D, 0xB281E1FD, 0x541501B8 },
+				{ 0xF7D88BC2, 0x4209A565, 0x1F225A7C, 0xA91A4226 },
+				{ 0x9AE75759, 0x6946075F, 0x3375788D, 0xE9B06958 },
+				{ 0xC1A12D2F, 0xC3978937, 0x0052D6B1, 0x641C83AE },
+				{ 0xF209787B, 0xB47D6B84, 0xC0678C5D, 0xBD23A49A },
+				{ 0x9745EB4D, 0x50CE6332, 0xF840B7BA, 0x963646E0 },
+				{ 0xBD176620, 0xA501FBFF, 0xB650E5A9, 0x3BC3D898 },
+				{ 0xEC5D3FA8, 0xCE427AFF, 0xA3E51F13, 0x8AB4CEBE },
+				{ 0x93BA47C9, 0x80E98CDF, 0xC66F336C, 0x36B10137 },
+				{ 0xB8A8D9BB, 0xE123F017, 0xB80B0047, 0x445D4184 },
+				{ 0xE6D3102A, 0xD96CEC1D, 0xA60DC059, 0x157491E5 },
+				{ 0x9043EA1A, 0xC7E41392, 0x87C89837, 0xAD68DB2F },
+				{ 0xB454E4A1, 0x79DD1877, 0x29BABE45, 0x98C311FB },
+				{ 0xE16A1DC9, 0xD8545E94, 0xF4296DD6, 0xFEF3D67A },
+				{ 0x8CE2529E, 0x2734BB1D, 0x1899E4A6, 0x5F58660C },
+				{ 0xB01AE745, 0xB101E9E4, 0x5EC05DCF, 0xF72E7F8F },
+				{ 0xDC21A117, 0x1D42645D, 0x76707543, 0xF4FA1F73 },
+				{ 0x899504AE, 0x72497EBA, 0x6A06494A, 0x791C53A8 },
+				{ 0xABFA45DA, 0x0EDBDE69, 0x0487DB9D, 0x17636892 },
+				{ 0xD6F8D750, 0x9292D603, 0x45A9D284, 0x5D3C42B6 },
+				{ 0x865B8692, 0x5B9BC5C2, 0x0B8A2392, 0xBA45A9B2 },
+				{ 0xA7F26836, 0xF282B732, 0x8E6CAC77, 0x68D7141E },
+				{ 0xD1EF0244, 0xAF2364FF, 0x3207D795, 0x430CD926 },
+				{ 0x8335616A, 0xED761F1F, 0x7F44E6BD, 0x49E807B8 },
+				{ 0xA402B9C5, 0xA8D3A6E7, 0x5F16206C, 0x9C6209A6 },
+				{ 0xCD036837, 0x130890A1, 0x36DBA887, 0xC37A8C0F },
+				{ 0x80222122, 0x6BE55A64, 0xC2494954, 0xDA2C9789 },
+				{ 0xA02AA96B, 0x06DEB0FD, 0xF2DB9BAA, 0x10B7BD6C },
+				{ 0xC83553C5, 0xC8965D3D, 0x6F928294, 0x94E5ACC7 },
+				{ 0xFA42A8B7, 0x3ABBF48C, 0xCB772339, 0xBA1F17F9 },
+				{ 0x9C69A972, 0x84B578D7, 0xFF2A7604, 0x14536EFB },
+				{ 0xC38413CF, 0x25E2D70D, 0xFEF51385, 0x19684ABA },
+				{ 0xF46518C2, 0xEF5B8CD1, 0x7EB25866, 0x5FC25D69 },
+				{ 0x98BF2F79, 0xD5993802, 0xEF2F773F, 0xFBD97A61 },
+				{ 0xBEEEFB58, 0x4AFF8603, 0xAAFB550F, 0xFACFD8FA },
+				{ 0xEEAABA2E, 0x5DBF6784, 0x95BA2A53, 0xF983CF38 },
+				{ 0x952AB45C, 0xFA97A0B2, 0xDD945A74, 0x7BF26183 },
+				{ 0xBA756174, 0x393D88DF, 0x94F97111, 0x9AEEF9E4 },
+				{ 0xE912B9D1, 0x478CEB17, 0x7A37CD56, 0x01AAB85D },
+				{ 0x91ABB422, 0xCCB812EE, 0xAC62E055, 0xC10AB33A },
+				{ 0xB616A12B, 0x7FE617AA, 0x577B986B, 0x314D6009 },
+				{ 0xE39C4976, 0x5FDF9D94, 0xED5A7E85, 0xFDA0B80B },
+				{ 0x8E41ADE9, 0xFBEBC27D, 0x14588F13, 0xBE847307 },
+				{ 0xB1D21964, 0x7AE6B31C, 0x596EB2D8, 0xAE258FC8 },
+				{ 0xDE469FBD, 0x99A05FE3, 0x6FCA5F8E, 0xD9AEF3BB },
+				{ 0x8AEC23D6, 0x80043BEE, 0x25DE7BB9, 0x480D5854 },
+				{ 0xADA72CCC, 0x20054AE9, 0xAF561AA7, 0x9A10AE6A },
+				{ 0xD910F7FF, 0x28069DA4, 0x1B2BA151, 0x8094DA04 },
+				{ 0x87AA9AFF, 0x79042286, 0x90FB44D2, 0xF05D0842 },
+				{ 0xA99541BF, 0x57452B28, 0x353A1607, 0xAC744A53 },
+				{ 0xD3FA922F, 0x2D1675F2, 0x42889B89, 0x97915CE8 },
+				{ 0x847C9B5D, 0x7C2E09B7, 0x69956135, 0xFEBADA11 },
+				{ 0xA59BC234, 0xDB398C25, 0x43FAB983, 0x7E699095 },
+				{ 0xCF02B2C2, 0x1207EF2E, 0x94F967E4, 0x5E03F4BB },
+				{ 0x8161AFB9, 0x4B44F57D, 0x1D1BE0EE, 0xBAC278F5 },
+				{ 0xA1BA1BA7, 0x9E1632DC, 0x6462D92A, 0x69731732 },
+				{ 0xCA28A291, 0x859BBF93, 0x7D7B8F75, 0x03CFDCFE },
+				{ 0xFCB2CB35, 0xE702AF78, 0x5CDA7352, 0x44C3D43E },
+				{ 0x9DEFBF01, 0xB061ADAB, 0x3A088813, 0x6AFA64A7 },
+				{ 0xC56BAEC2, 0x1C7A1916, 0x088AAA18, 0x45B8FDD0 },
+				{ 0xF6C69A72, 0xA3989F5B, 0x8AAD549E, 0x57273D45 },
+				{ 0x9A3C2087, 0xA63F6399, 0x36AC54E2, 0xF678864B },
+				{ 0xC0CB28A9, 0x8FCF3C7F, 0x84576A1B, 0xB416A7DD },
+				{ 0xF0FDF2D3, 0xF3C30B9F, 0x656D44A2, 0xA11C51D5 },
+				{ 0x969EB7C4, 0x7859E743, 0x9F644AE5, 0xA4B1B325 },
+				{ 0xBC4665B5, 0x96706114, 0x873D5D9F, 0x0DDE1FEE },
+				{ 0xEB57FF22, 0xFC0C7959, 0xA90CB506, 0xD155A7EA },
+				{ 0x9316FF75, 0xDD87CBD8, 0x09A7F124, 0x42D588F2 },
+				{ 0xB7DCBF53, 0x54E9BECE, 0x0C11ED6D, 0x538AEB2F },
+				{ 0xE5D3EF28, 0x2A242E81, 0x8F1668C8, 0xA86DA5FA },
+				{ 0x8FA47579, 0x1A569D10, 0xF96E017D, 0x694487BC },
+				{ 0xB38D92D7, 0x60EC4455, 0x37C981DC, 0xC395A9AC },
+				{ 0xE070F78D, 0x3927556A, 0x85BBE253, 0xF47B1417 },
+				{ 0x8C469AB8, 0x43B89562, 0x93956D74, 0x78CCEC8E },
+				{ 0xAF584166, 0x54A6BABB, 0x387AC8D1, 0x970027B2 },
+				{ 0xDB2E51BF, 0xE9D0696A, 0x06997B05, 0xFCC0319E },
+				{ 0x88FCF317, 0xF22241E2, 0x441FECE3, 0xBDF81F03 },
+				{ 0xAB3C2FDD, 0xEEAAD25A, 0xD527E81C, 0xAD7626C3 },
+				{ 0xD60B3BD5, 0x6A5586F1, 0x8A71E223, 0xD8D3B074 },
+				{ 0x85C70565, 0x62757456, 0xF6872D56, 0x67844E49 },
+				{ 0xA738C6BE, 0xBB12D16C, 0xB428F8AC, 0x016561DB },
+				{ 0xD106F86E, 0x69D785C7, 0xE13336D7, 0x01BEBA52 },
+				{ 0x82A45B45, 0x0226B39C, 0xECC00246, 0x61173473 },
+				{ 0xA34D7216, 0x42B06084, 0x27F002D7, 0xF95D0190 },
+				{ 0xCC20CE9B, 0xD35C78A5, 0x31EC038D, 0xF7B441F4 },
+				{ 0xFF290242, 0xC83396CE, 0x7E670471, 0x75A15271 },
+				{ 0x9F79A169, 0xBD203E41, 0x0F0062C6, 0xE984D386 },
+				{ 0xC75809C4, 0x2C684DD1, 0x52C07B78, 0xA3E60868 },
+				{ 0xF92E0C35, 0x37826145, 0xA7709A56, 0xCCDF8A82 },
+				{ 0x9BBCC7A1, 0x42B17CCB, 0x88A66076, 0x400BB691 },
+				{ 0xC2ABF989, 0x935DDBFE, 0x6ACFF893, 0xD00EA435 },
+				{ 0xF356F7EB, 0xF83552FE, 0x0583F6B8, 0xC4124D43 },
+				{ 0x98165AF3, 0x7B2153DE, 0xC3727A33, 0x7A8B704A },
+				{ 0xBE1BF1B0, 0x59E9A8D6, 0x744F18C0, 0x592E4C5C },
+				{ 0xEDA2EE1C, 0x7064130C, 0x1162DEF0, 0x6F79DF73 },
+				{ 0x9485D4D1, 0xC63E8BE7, 0x8ADDCB56, 0x45AC2BA8 },
+				{ 0xB9A74A06, 0x37CE2EE1, 0x6D953E2B, 0xD7173692 },
+				{ 0xE8111C87, 0xC5C1BA99, 0xC8FA8DB6, 0xCCDD0437 },
+				{ 0x910AB1D4, 0xDB9914A0, 0x1D9C9892, 0x400A22A2 },
+				{ 0xB54D5E4A, 0x127F59C8, 0x2503BEB6, 0xD00CAB4B },
+				{ 0xE2A0B5DC, 0x971F303A, 0x2E44AE64, 0x840FD61D },
+				{ 0x8DA471A9, 0xDE737E24, 0x5CEAECFE, 0xD289E5D2 },
+				{ 0xB10D8E14, 0x56105DAD, 0x7425A83E, 0x872C5F47 },
+				{ 0xDD50F199, 0x6B947518, 0xD12F124E, 0x28F77719 },
+				{ 0x8A5296FF, 0xE33CC92F, 0x82BD6B70, 0xD99AAA6F },
+				{ 0xACE73CBF, 0xDC0BFB7B, 0x636CC64D, 0x1001550B },
+				{ 0xD8210BEF, 0xD30EFA5A, 0x3C47F7E0, 0x5401AA4E },
+				{ 0x8714A775, 0xE3E95C78, 0x65ACFAEC, 0x34810A71 },
+				{ 0xA8D9D153, 0x5CE3B396, 0x7F1839A7, 0x41A14D0D },
+				{ 0xD31045A8, 0x341CA07C, 0x1EDE4811, 0x1209A050 },
+				{ 0x83EA2B89, 0x2091E44D, 0x934AED0A, 0xAB460432 },
+				{ 0xA4E4B66B, 0x68B65D60, 0xF81DA84D, 0x5617853F },
+				{ 0xCE1DE406, 0x42E3F4B9, 0x36251260, 0xAB9D668E },
+				{ 0x80D2AE83, 0xE9CE78F3, 0xC1D72B7C, 0x6B426019 },
+				{ 0xA1075A24, 0xE4421730, 0xB24CF65B, 0x8612F81F },
+				{ 0xC94930AE, 0x1D529CFC, 0xDEE033F2, 0x6797B627 },
+				{ 0xFB9B7CD9, 0xA4A7443C, 0x169840EF, 0x017DA3B1 },
+				{ 0x9D412E08, 0x06E88AA5, 0x8E1F2895, 0x60EE864E },
+				{ 0xC491798A, 0x08A2AD4E, 0xF1A6F2BA, 0xB92A27E2 },
+				{ 0xF5B5D7EC, 0x8ACB58A2, 0xAE10AF69, 0x6774B1DB },
+				{ 0x9991A6F3, 0xD6BF1765, 0xACCA6DA1, 0xE0A8EF29 },
+				{ 0xBFF610B0, 0xCC6EDD3F, 0x17FD090A, 0x58D32AF3 },
+				{ 0xEFF394DC, 0xFF8A948E, 0xDDFC4B4C, 0xEF07F5B0 },
+				{ 0x95F83D0A, 0x1FB69CD9, 0x4ABDAF10, 0x1564F98E },
+				{ 0xBB764C4C, 0xA7A4440F, 0x9D6D1AD4, 0x1ABE37F1 },
+				{ 0xEA53DF5F, 0xD18D5513, 0x84C86189, 0x216DC5ED },
+				{ 0x92746B9B, 0xE2F8552C, 0x32FD3CF5, 0xB4E49BB4 },
+				{ 0xB7118682, 0xDBB66A77, 0x3FBC8C33, 0x221DC2A1 },
+				{ 0xE4D5E823, 0x92A40515, 0x0FABAF3F, 0xEAA5334A },
+				{ 0x8F05B116, 0x3BA6832D, 0x29CB4D87, 0xF2A7400E },
+				{ 0xB2C71D5B, 0xCA9023F8, 0x743E20E9, 0xEF511012 },
+				{ 0xDF78E4B2, 0xBD342CF6, 0x914DA924, 0x6B255416 },
+				{ 0x8BAB8EEF, 0xB6409C1A, 0x1AD089B6, 0xC2F7548E },
+				{ 0xAE9672AB, 0xA3D0C320, 0xA184AC24, 0x73B529B1 },
+				{ 0xDA3C0F56, 0x8CC4F3E8, 0xC9E5D72D, 0x90A2741E },
+				{ 0x88658996, 0x17FB1871, 0x7E2FA67C, 0x7A658892 },
+				{ 0xAA7EEBFB, 0x9DF9DE8D, 0xDDBB901B, 0x98FEEAB7 },
+				{ 0xD51EA6FA, 0x85785631, 0x552A7422, 0x7F3EA565 },
+				{ 0x8533285C, 0x936B35DE, 0xD53A8895, 0x8F87275F },
+				{ 0xA67FF273, 0xB8460356, 0x8A892ABA, 0xF368F137 },
+				{ 0xD01FEF10, 0xA657842C, 0x2D2B7569, 0xB0432D85 },
+				{ 0x8213F56A, 0x67F6B29B, 0x9C3B2962, 0x0E29FC73 },
+				{ 0xA298F2C5, 0x01F45F42, 0x8349F3BA, 0x91B47B8F },
+				{ 0xCB3F2F76, 0x42717713, 0x241C70A9, 0x36219A73 },
+				{ 0xFE0EFB53, 0xD30DD4D7, 0xED238CD3, 0x83AA0110 },
+				{ 0x9EC95D14, 0x63E8A506, 0xF4363804, 0x324A40AA },
+				{ 0xC67BB459, 0x7CE2CE48, 0xB143C605, 0x3EDCD0D5 },
+				{ 0xF81AA16F, 0xDC1B81DA, 0xDD94B786, 0x8E94050A },
+				{ 0x9B10A4E5, 0xE9913128, 0xCA7CF2B4, 0x191C8326 },
+				{ 0xC1D4CE1F, 0x63F57D72, 0xFD1C2F61, 0x1F63A3F0 },
+				{ 0xF24A01A7, 0x3CF2DCCF, 0xBC633B39, 0x673C8CEC },
+				{ 0x976E4108, 0x8617CA01, 0xD5BE0503, 0xE085D813 },
+				{ 0xBD49D14A, 0xA79DBC82, 0x4B2D8644, 0xD8A74E18 },
+				{ 0xEC9C459D, 0x51852BA2, 0xDDF8E7D6, 0x0ED1219E },
+				{ 0x93E1AB82, 0x52F33B45, 0xCABB90E5, 0xC942B503 },
+				{ 0xB8DA1662, 0xE7B00A17, 0x3D6A751F, 0x3B936243 },
+				{ 0xE7109BFB, 0xA19C0C9D, 0x0CC51267, 0x0A783AD4 },
+				{ 0x906A617D, 0x450187E2, 0x27FB2B80, 0x668B24C5 },
+				{ 0xB484F9DC, 0x9641E9DA, 0xB1F9F660, 0x802DEDF6 },
+				{ 0xE1A63853, 0xBBD26451, 0x5E7873F8, 0xA0396973 },
+				{ 0x8D07E334, 0x55637EB2, 0xDB0B487B, 0x6423E1E8 },
+				{ 0xB049DC01, 0x6ABC5E5F, 0x91CE1A9A, 0x3D2CDA62 },
+				{ 0xDC5C5301, 0xC56B75F7, 0x7641A140, 0xCC7810FB },
+				{ 0x89B9B3E1, 0x1B6329BA, 0xA9E904C8, 0x7FCB0A9D },
+				{ 0xAC2820D9, 0x623BF429, 0x546345FA, 0x9FBDCD44 },
+				{ 0xD732290F, 0xBACAF133, 0xA97C1779, 0x47AD4095 },
+				{ 0x867F59A9, 0xD4BED6C0, 0x49ED8EAB, 0xCCCC485D },
+				{ 0xA81F3014, 0x49EE8C70, 0x5C68F256, 0xBFFF5A74 },
+				{ 0xD226FC19, 0x5C6A2F8C, 0x73832EEC, 0x6FFF3111 },
+				{ 0x83585D8F, 0xD9C25DB7, 0xC831FD53, 0xC5FF7EAB },
+				{ 0xA42E74F3, 0xD032F525, 0xBA3E7CA8, 0xB77F5E55 },
+				{ 0xCD3A1230, 0xC43FB26F, 0x28CE1BD2, 0xE55F35EB },
+				{ 0x80444B5E, 0x7AA7CF85, 0x7980D163, 0xCF5B81B3 },
+				{ 0xA0555E36, 0x1951C366, 0xD7E105BC, 0xC332621F },
+				{ 0xC86AB5C3, 0x9FA63440, 0x8DD9472B, 0xF3FEFAA7 },
+				{ 0xFA856334, 0x878FC150, 0xB14F98F6, 0xF0FEB951 },
+				{ 0x9C935E00, 0xD4B9D8D2, 0x6ED1BF9A, 0x569F33D3 },
+				{ 0xC3B83581, 0x09E84F07, 0x0A862F80, 0xEC4700C8 },
+				{ 0xF4A642E1, 0x4C6262C8, 0xCD27BB61, 0x2758C0FA },
+				{ 0x98E7E9CC, 0xCFBD7DBD, 0x8038D51C, 0xB897789C },
+				{ 0xBF21E440, 0x03ACDD2C, 0xE0470A63, 0xE6BD56C3 },
+				{ 0xEEEA5D50, 0x04981478, 0x1858CCFC, 0xE06CAC74 },
+				{ 0x95527A52, 0x02DF0CCB, 0x0F37801E, 0x0C43EBC8 },
+				{ 0xBAA718E6, 0x8396CFFD, 0xD3056025, 0x8F54E6BA },
+				{ 0xE950DF20, 0x247C83FD, 0x47C6B82E, 0xF32A2069 },
+				{ 0x91D28B74, 0x16CDD27E, 0x4CDC331D, 0x57FA5441 },
+				{ 0xB6472E51, 0x1C81471D, 0xE0133FE4, 0xADF8E952 },
+				{ 0xE3D8F9E5, 0x63A198E5, 0x58180FDD, 0xD97723A6 },
+				{ 0x8E679C2F, 0x5E44FF8F, 0x570F09EA, 0xA7EA7648 },
+				{ 0xB201833B, 0x35D63F73, 0x2CD2CC65, 0x51E513DA },
+				{ 0xDE81E40A, 0x034BCF4F, 0xF8077F7E, 0xA65E58D1 },
+				{ 0x8B112E86, 0x420F6191, 0xFB04AFAF, 0x27FAF782 },
+				{ 0xADD57A27, 0xD29339F6, 0x79C5DB9A, 0xF1F9B563 },
+				{ 0xD94AD8B1, 0xC7380874, 0x18375281, 0xAE7822BC },
+				{ 0x87CEC76F, 0x1C830548, 0x8F229391, 0x0D0B15B5 },
+				{ 0xA9C2794A, 0xE3A3C69A, 0xB2EB3875, 0x504DDB22 },
+				{ 0xD433179D, 0x9C8CB841, 0x5FA60692, 0xA46151EB },
+				{ 0x849FEEC2, 0x81D7F328, 0xDBC7C41B, 0xA6BCD333 },
+				{ 0xA5C7EA73, 0x224DEFF3, 0x12B9B522, 0x906C0800 },
+				{ 0xCF39E50F, 0xEAE16BEF, 0xD768226B, 0x34870A00 },
+				{ 0x81842F29, 0xF2CCE375, 0xE6A11583, 0x00D46640 },
+				{ 0xA1E53AF4, 0x6F801C53, 0x60495AE3, 0xC1097FD0 },
+				{ 0xCA5E89B1, 0x8B602368, 0x385BB19C, 0xB14BDFC4 },
+				{ 0xFCF62C1D, 0xEE382C42, 0x46729E03, 0xDD9ED7B5 },
+				{ 0x9E19DB92, 0xB4E31BA9, 0x6C07A2C2, 0x6A8346D1 },
+				{ 0xC5A05277, 0x621BE293, 0xC7098B73, 0x05241885 },
+				{ 0xF7086715, 0x3AA2DB38, 0xB8CBEE4F, 0xC66D1EA7 },
+				{ 0x9A65406D, 0x44A5C903, 0x737F74F1, 0xDC043328 },
+				{ 0xC0FE9088, 0x95CF3B44, 0x505F522E, 0x53053FF2 },
+				{ 0xF13E34AA, 0xBB430A15, 0x647726B9, 0xE7C68FEF },
+				{ 0x96C6E0EA, 0xB509E64D, 0x5ECA7834, 0x30DC19F5 },
+				{ 0xBC789925, 0x624C5FE0, 0xB67D1641, 0x3D132072 },
+				{ 0xEB96BF6E, 0xBADF77D8, 0xE41C5BD1, 0x8C57E88F },
+				{ 0x933E37A5, 0x34CBAAE7, 0x8E91B962, 0xF7B6F159 },
+				{ 0xB80DC58E, 0x81FE95A1, 0x723627BB, 0xB5A4ADB0 },
+				{ 0xE61136F2, 0x227E3B09, 0xCEC3B1AA, 0xA30DD91C },
+				{ 0x8FCAC257, 0x558EE4E6, 0x213A4F0A, 0xA5E8A7B1 },
+				{ 0xB3BD72ED, 0x2AF29E1F, 0xA988E2CD, 0x4F62D19D },
+				{ 0xE0ACCFA8, 0x75AF45A7, 0x93EB1B80, 0xA33B8605 },
+				{ 0x8C6C01C9, 0x498D8B88, 0xBC72F130, 0x660533C3 },
+				{ 0xAF87023B, 0x9BF0EE6A, 0xEB8FAD7C, 0x7F8680B4 },
+				{ 0xDB68C2CA, 0x82ED2A05, 0xA67398DB, 0x9F6820E1 },
+				{ 0x892179BE, 0x91D43A43, 0x88083F89, 0x43A1148C },
+				{ 0xAB69D82E, 0x364948D4, 0x6A0A4F6B, 0x948959B0 },
+				{ 0xD6444E39, 0xC3DB9B09, 0x848CE346, 0x79ABB01C },
+				{ 0x85EAB0E4, 0x1A6940E5, 0xF2D80E0C, 0x0C0B4E11 },
+				{ 0xA7655D1D, 0x2103911F, 0x6F8E118F, 0x0F0E2195 },
+				{ 0xD13EB464, 0x69447567, 0x4B7195F2, 0xD2D1A9FB },
+			};
+			return powers[ exp10 + 348 ];
+		}
+
+		// Eisel-Lemire: computes the correctly rounded value of mantissa * 10^exp10.
+		// Returns false when it can not decide the rounding, or the result is out of
+		// the normal range, so the caller should fall back to a slower algorithm
+		template< typename FloatType, typename Bits >
+		static
+		bool
+		eiselLemire( uint64_t mantissa, int exp10, bool negative, FloatType& value ) {
+			if ( exp10 < -348 || exp10 > 347 ) {
+				return false;
+			}
+			const int mantissaBits = std::numeric_limits< FloatType >::digits - 1;
+			const int shift = 64 - mantissaBits - 3;
+			const uint64_t shiftMask = ( uint64_t( 1 ) << shift ) - 1;
+			const uint64_t bias = std::numeric_limits< FloatType >::max_exponent - 1;
+			const uint64_t infiniteExp = 2 * std::numeric_limits< FloatType >::max_exponent - 1;
+
+			const int clz = leadingZeros( mantissa );
+			mantissa <<= clz;
+			uint64_t exp2 = uint64_t( ( ( 217706 * exp10 ) >> 16 ) + 64 + int( bias ) ) - clz;
+
+			const uint32_t * power = powerOfTen128( exp10 );
+			uint64_t xHi, xLo;
+			mulFull( mantissa, ( uint64_t( power[ 0 ] ) << 32 ) | power[ 1 ], xHi, xLo );
+			if ( ( xHi & shiftMask ) == shiftMask && xLo + mantissa < mantissa ) {
+				uint64_t yHi, yLo;
+				mulFull( mantissa, ( uint64_t( power[ 2 ] ) << 32 ) | power[ 3 ], yHi, yLo );
+				uint64_t mergedHi = xHi;
+				uint64_t mergedLo = xLo + yHi;
+				if ( mergedLo < xLo ) {
+					++mergedHi;
+				}
+				if ( ( mergedHi & shiftMask ) == shiftMask && mergedLo + 1 == 0 && yLo + mantissa < mantissa ) {
+					return false;
+				}
+				xHi = mergedHi;
+				xLo = mergedLo;
+			}
+
+			const uint64_t msb = xHi >> 63;
+			uint64_t result = xHi >> ( msb + shift );
+			exp2 -= 1 ^ msb;
+			if ( xLo == 0 && ( xHi & shiftMask ) == 0 && ( result & 3 ) == 1 ) {
+				return false;
+			}
+			result += result & 1;
+			result >>= 1;
+			if ( result >> ( mantissaBits + 1 ) ) {
+				result >>= 1;
+				++exp2;
+			}
+			if ( exp2 - 1 >= infiniteExp - 1 ) {
+				return false;
+			}
+
+			Bits bits = Bits( ( exp2 << mantissaBits ) | ( result & ( ( uint64_t( 1 ) << mantissaBits ) - 1 ) ) );
+			if ( negative ) {
+				bits |= Bits( 1 ) << ( sizeof( Bits ) * 8 - 1 );
+			}
+			memcpy( &value, &bits, sizeof( bits ) );
+			return true;
+		}
+
+		// Clinger: exact when both mantissa and 10^exp10 are exactly representable
+		template< typename FloatType >
+		static
+		bool
+		clinger( uint64_t mantissa, int exp10, bool negative, FloatType& value ) {
+			static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+											 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+			const int digits = std::numeric_limits< FloatType >::digits;
+			const int mantissaBits = digits < 63 ? digits : 63;
+			const int maxExp10 = digits < 53 ? 10 : 22;
+			if ( ( mantissa >> mantissaBits ) || exp10 < -maxExp10 || exp10 > maxExp10 ) {
+				return false;
+			}
+			value = FloatType( mantissa );
+			if ( exp10 < 0 ) {
+				value /= FloatType( powers[ -exp10 ] );
+			}
+			else {
+				value *= FloatType( powers[ exp10 ] );
+			}
+			if ( negative ) {
+				value = -value;
+			}
+			return true;
+		}
+
+		static
+		bool
+		fastReal( uint64_t mantissa, int exp10, bool negative, float& value ) {
+			return clinger( mantissa, exp10, negative, value )
+				|| eiselLemire< float, uint32_t >( mantissa, exp10, negative, value );
+		}
+
+		static
+		bool
+		fastReal( uint64_t mantissa, int exp10, bool negative, double& value ) {
+			return clinger( mantissa, exp10, negative, value )
+				|| eiselLemire< double, uint64_t >( mantissa, exp10, negative, value );
+		}
+
+		static
+		bool
+		fastReal( uint64_t mantissa, int exp10, bool negative, long double& value ) {
+			return clinger( mantissa, exp10, negative, value );
+		}
+
+		static
+		void
+		strToReal( const char * str, float& value ) {
+			value = strtof( str, NULL );
+		}
+
+		static
+		void
+		strToReal( const char * str, double& value ) {
+			value = strtod( str, NULL );
+		}
+
+		static
+		void
+		strToReal( const char * str, long double& value ) {
+			value = strtold( str, NULL );
+		}
+
+		// Parses with the C library, replacing the decimal point by the one of the current locale
+		template< typename FloatType >
+		static
+		void
+		slowReal( const char * first, const char * last, FloatType& value ) {
+			std::string str( first, last );
+			const char point = *localeconv()->decimal_point;
+			const size_t dot = str.find( '.' );
+			if ( point != '.' && dot != std::string::npos ) {
+				str[ dot ] = point;
+			}
+			strToReal( str.c_str(), value );
+		}
+
+		static
+		bool
+		isDigit( char c ) {
+			return c >= '0' && c <= '9';
+		}
+
+		static
+		bool
+		matches( const char * first, const char * last, const char * literal ) {
+			while ( *literal ) {
+				if ( first == last || *first++ != *literal++ ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template< typename FloatType >
+		static
+		size_t
+		parseReal( const char * first, const char * last, FloatType& value ) {
+			const char * p = first;
+			const bool negative = ( p < last ) && ( *p == '-' );
+			if ( negative ) {
+				++p;
+			}
+			if ( matches( p, last, "nan" ) ) {
+				value = std::numeric_limits< FloatType >::quiet_NaN();
+				return p + 3 - first;
+			}
+			if ( matches( p, last, "inf" ) ) {
+				value = negative ? -std::numeric_limits< FloatType >::infinity() : std::numeric_limits< FloatType >::infinity();
+				return p + 3 - first;
+			}
+
+			const int maxDigits = 19;
+			uint64_t mantissa = 0;
+			int digits = 0;
+			int exp10 = 0;
+			bool truncated = false;
+			const char * start = p;
+			for ( ; p < last && isDigit( *p ); ++p ) {
+				if ( digits < maxDigits ) {
+					mantissa = mantissa * 10 + ( *p - '0' );
+					digits += ( mantissa != 0 );
+				}
+				else {
+					++exp10;
+					truncated |= ( *p != '0' );
+				}
+			}
+			bool hasDigits = ( p != start );
+			if ( p < last && *p == '.' ) {
+				start = ++p;
+				for ( ; p < last && isDigit( *p ); ++p ) {
+					if ( digits < maxDigits ) {
+						mantissa = mantissa * 10 + ( *p - '0' );
+						digits += ( mantissa != 0 );
+						--exp10;
+					}
+					else {
+						truncated |= ( *p != '0' );
+					}
+				}
+				hasDigits |= ( p != start );
+			}
+			if ( !hasDigits ) {
+				return 0;
+			}
+			if ( p < last && ( *p == 'e' || *p == 'E' ) ) {
+				const char * mark = p++;
+				const bool negativeExp = ( p < last ) && ( *p == '-' );
+				if ( p < last && ( *p == '-' || *p == '+' ) ) {
+					++p;
+				}
+				if ( p < last && isDigit( *p ) ) {
+					int exponent = 0;
+					for ( ; p < last && isDigit( *p ); ++p ) {
+						if ( exponent < 100000 ) {
+							exponent = exponent * 10 + ( *p - '0' );
+						}
+					}
+					exp10 += negativeExp ? -exponent : exponent;
+				}
+				else {
+					p = mark;
+				}
+			}
+
+			if ( !mantissa && !truncated ) {
+				value = negative ? -FloatType( 0 ) : FloatType( 0 );
+			}
+			else if ( truncated || !fastReal( mantissa, exp10, negative, value ) ) {
+				slowReal( first, p, value );
+			}
+			return p - first;
+		}
+
+		template< typename T >
+		static
+		size_t
+		parseInteger( const char * first, const char * last, T& value ) {
+			const char * p = first;
+			const bool negative = ( p < last ) && ( *p == '-' );
+			if ( negative ) {
+				if ( !std::numeric_limits< T >::is_signed ) {
+					return 0;
+				}
+				++p;
+			}
+			const uintmax_t limit = negative ? uintmax_t( 0 ) - uintmax_t( std::numeric_limits< T >::min() )
+											 : uintmax_t( std::numeric_limits< T >::max() );
+			uintmax_t magnitude = 0;
+			const char * start = p;
+			for ( ; p < last && isDigit( *p ); ++p ) {
+				const unsigned digit = *p - '0';
+				if ( magnitude > limit / 10 || ( magnitude == limit / 10 && digit > limit % 10 ) ) {
+					return 0;
+				}
+				magnitude = magnitude * 10 + digit;
+			}
+			if ( p == start ) {
+				return 0;
+			}
+			value = negative ? T( 0 - magnitude ) : T( magnitude );
+			return p - first;
+		}
+	};
+
+	/**
+	 * \brief Writes the decimal representation of an integer
+	 *
+	 * \param buffer destination buffer, at least maxNumberLength long
+	 * \param number the number to write
+	 * \return the number of characters written
+	 */
+	template< typename T >
+	typename boost::enable_if< boost::is_integral< T >, size_t >::type
+	formatNumber( char * buffer, T number ) {
+		uintmax_t magnitude = static_cast< uintmax_t >( number );
+		if ( number < T() ) {
+			*buffer = '-';
+			return __numconv::formatUnsigned( buffer + 1, 0 - magnitude ) + 1;
+		}
+		return __numconv::formatUnsigned( buffer, magnitude );
+	}
+
+	/**
+	 * \brief Writes a round-trip decimal representation of a float
+	 *
+	 * Writes a digit sequence that reads back to the same float, independently
+	 * of the current locale. The sequence is usually the shortest one, though
+	 * a few values get a longer one. Values having no more than 15
+	 * integer digits and no more than 3 leading zeros after the decimal point
+	 * are written in fixed notation, without decimal point if they are integral.
+	 * Other values are written in scientific notation, as in 1.5e+20.
+	 * \param buffer destination buffer, at least maxNumberLength long
+	 * \param number the number to write
+	 * \return the number of characters written
+	 */
+	inline
+	size_t
+	formatNumber( char * buffer, float number ) {
+		return __numconv::formatReal< float, uint32_t >( buffer, number );
+	}
+
+	/**
+	 * \brief Writes a round-trip decimal representation of a double
+	 * \sa formatNumber( char * buffer, float number )
+	 */
+	inline
+	size_t
+	formatNumber( char * buffer, double number ) {
+		return __numconv::formatReal< double, uint64_t >( buffer, number );
+	}
+
+	/**
+	 * \brief Writes the decimal representation of a long double
+	 *
+	 * Values representable as a double are written as the double when those
+	 * digits read back as the same long double, as 0.5 does but 0.1 does not.
+	 * Otherwise, enough digits to read back the same long double are written.
+	 * \sa formatNumber( char * buffer, float number )
+	 */
+	inline
+	size_t
+	formatNumber( char * buffer, long double number ) {
+		if ( number != number ) {
+			return formatNumber( buffer, static_cast< double >( number ) );
+		}
+		const double asDouble = static_cast< double >( number );
+		if ( static_cast< long double >( asDouble ) == number ) {
+			const size_t length = formatNumber( buffer, asDouble );
+			long double parsed;
+			if ( __numconv::parseReal( buffer, buffer + length, parsed ) == length && parsed == number ) {
+				return length;
+			}
+		}
+		const int length = sprintf( buffer, "%.*Lg", std::numeric_limits< long double >::digits10 + 3, number );
+		const char point = *localeconv()->decimal_point;
+		if ( point != '.' ) {
+			char * found = (char *)memchr( buffer, point, length );
+			if ( found ) {
+				*found = '.';
+			}
+		}
+		return length;
+	}
+
+	/**
+	 * \brief Parses the decimal representation of an integer
+	 *
+	 * Reads an optional minus sign followed by decimal digits, without skipping
+	 * blanks nor using the current locale, as std::from_chars does.
+	 * \param first pointer to the first character to parse
+	 * \param last pointer past the last character to parse
+	 * \param value receives the parsed number. It is not modified if parsing fails
+	 * \return the number of characters consumed, or 0 if no number was found at first
+	 * or if it does not fit in T
+	 */
+	template< typename T >
+	typename boost::enable_if< boost::is_integral< T >, size_t >::type
+	parseNumber( const char * first, const char * last, T& value ) {
+		return __numconv::parseInteger( first, last, value );
+	}
+
+	/**
+	 * \brief Parses the decimal representation of a float
+	 *
+	 * Reads a JSON number, or one of nan, inf and -inf as written by formatNumber,
+	 * independently of the current locale. The result is correctly rounded: most
+	 * numbers are converted by the Clinger fast path or the Eisel-Lemire algorithm
+	 * and only numbers they can not decide are handed to the C library.
+	 * \param first pointer to the first character to parse
+	 * \param last pointer past the last character to parse
+	 * \param value receives the parsed number. It is not modified if parsing fails
+	 * \return the number of characters consumed, or 0 if no number was found at first
+	 */
+	inline
+	size_t
+	parseNumber( const char * first, const char * last, float& value ) {
+		return __numconv::parseReal( first, last, value );
+	}
+
+	/**
+	 * \brief Parses the decimal representation of a double
+	 * \sa parseNumber( const char * first, const char * last, float& value )
+	 */
+	inline
+	size_t
+	parseNumber( const char * first, const char * last, double& value ) {
+		return __numconv::parseReal( first, last, value );
+	}
+
+	/**
+	 * \brief Parses the decimal representation of a long double
+	 *
+	 * Numbers out of reach of the Clinger fast path are handed to the C library.
+	 * \sa parseNumber( const char * first, const char * last, float& value )
+	 */
+	inline
+	size_t
+	parseNumber( const char * first, const char * last, long double& value ) {
+		return __numconv::parseReal( first, last, value );
+	}
+}; // namespace jrtti
+#endif //jrttinumconvH
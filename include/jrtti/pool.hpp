@@ -0,0 +1,446 @@
+#ifndef jrttipoolH
+#define jrttipoolH
+
+#include <new>
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/type_traits/is_polymorphic.hpp>
+#include <boost/type_traits/has_virtual_destructor.hpp>
+#include <boost/utility/enable_if.hpp>
+#include "exception.hpp"
+#include "threads.hpp"
+
+namespace jrtti {
+
+/**
+ * \brief Pool of objects of a type
+ *
+ * Recycles the memory of destroyed objects to create new ones. Every
+ * thread keeps its own list of free objects, so creating and destroying
+ * objects takes no lock. Lists are refilled, or emptied when too long,
+ * moving batches of objects from and to a list shared by all threads.
+ * The memory is freed when the pool is destroyed, so all its objects
+ * should be destroyed before.
+ * A thread keeps lists for up to 4 pools of the same type alive at a time.
+ * Objects of further pools are created and destroyed under a lock. With
+ * JRTTI_HAS_THREADS the lists of a thread are returned to their pools when
+ * it exits. Otherwise they are kept until the pools are destroyed.
+ * Metatype::enablePool creates the pool of a type.
+ * \tparam T the type of the objects
+ */
+template< typename T >
+class ObjectPool {
+public:
+	/**
+	 * \brief Constructor
+	 * \param batchSize number of objects moved at once between the thread lists and the shared one
+	 */
+	ObjectPool( size_t batchSize = 64 )
+		:	m_free( NULL ),
+			m_batchSize( batchSize ? batchSize : 1 ),
+			m_serial( open() ) {}
+
+	~ObjectPool() {
+		close();
+		for ( size_t i = 0; i < m_slabs.size(); ++i ) {
+			free( m_slabs[ i ] );
+		}
+	}
+
+	/**
+	 * \brief Creates a default constructed object
+	 * \return pointer to the object
+	 */
+	T *
+	create() {
+		Cache * local = cache();
+		Node * node;
+		if ( local ) {
+			if ( !local->head ) {
+				refill( *local );
+			}
+			node = local->head;
+			local->head = node->next;
+			--local->count;
+		}
+		else {
+			node = take();
+		}
+		try {
+			return new ( node ) T();
+		}
+		catch ( ... ) {
+			if ( local ) {
+				node->next = local->head;
+				local->head = node;
+				++local->count;
+			}
+			else {
+				give( node );
+			}
+			throw;
+		}
+	}
+
+	/**
+	 * \brief Destroys an object created by this pool
+	 * \param obj pointer to the object. Nothing is done if NULL
+	 */
+	void
+	destroy( T * obj ) {
+		if ( !obj ) {
+			return;
+		}
+		obj->~T();
+		Cache * local = cache();
+		Node * node = reinterpret_cast< Node * >( obj );
+		if ( !local ) {
+			give( node );
+			return;
+		}
+		node->next = local->head;
+		local->head = node;
+		if ( ++local->count >= 2 * m_batchSize ) {
+			spill( *local );
+		}
+	}
+
+	/**
+	 * \brief Retrieves the number of objects moved at once between thread lists
+	 * \return the batch size
+	 */
+	size_t
+	batchSize() const {
+		return m_batchSize;
+	}
+
+	/**
+	 * \brief Retrieves the number of objects the allocated memory holds
+	 * \return the number of objects, created or free
+	 */
+	size_t
+	capacity() const {
+		__LockGuard lock( m_mutex );
+		return m_slabs.size() * m_batchSize;
+	}
+
+private:
+	ObjectPool( const ObjectPool& );
+	ObjectPool& operator = ( const ObjectPool& );
+
+	union Node {
+		Node *	next;
+		char	object[ sizeof( T ) ];
+		typename boost::type_with_alignment< boost::alignment_of< T >::value >::type	align;
+	};
+
+	// List of free objects of a pool kept by a thread. POD, so it can be thread local without C++11
+	struct Cache {
+		unsigned	serial;
+		Node *		head;
+		size_t		count;
+	};
+
+	// Pools of T alive, by serial
+	struct Registry {
+		Registry()
+			:	last( 0 ) {}
+
+		__Mutex									mutex;
+		unsigned								last;
+		std::map< unsigned, ObjectPool * >	alive;
+	};
+
+	static const size_t cacheSlots = 4;
+
+	// Lists of a thread. POD without JRTTI_HAS_THREADS, so it can be thread local
+	struct Caches {
+#if defined( JRTTI_HAS_THREADS )
+		Caches()
+			:	slots() {}
+
+		// returns the lists to their pools when the thread exits
+		~Caches() {
+			Registry& pools = registry();
+			__LockGuard lock( pools.mutex );
+			for ( size_t i = 0; i < cacheSlots; ++i ) {
+				typename std::map< unsigned, ObjectPool * >::iterator it = pools.alive.find( slots[ i ].serial );
+				if ( it != pools.alive.end() && slots[ i ].head ) {
+					it->second->giveList( slots[ i ].head );
+				}
+			}
+		}
+#endif
+
+		Cache	slots[ cacheSlots ];
+	};
+
+	// Retrieves the list of this pool in the calling thread, taking the one of a destroyed pool if there
+	// is none. Returns NULL if the thread keeps the lists of cacheSlots other pools alive
+	Cache *
+	cache() {
+		static JRTTI_THREAD_LOCAL Caches caches;
+		Cache * local = caches.slots;
+		for ( size_t i = 0; i < cacheSlots; ++i ) {
+			if ( local[ i ].serial == m_serial ) {
+				return &local[ i ];
+			}
+		}
+		Registry& pools = registry();
+		__LockGuard lock( pools.mutex );
+		for ( size_t i = 0; i < cacheSlots; ++i ) {
+			if ( !pools.alive.count( local[ i ].serial ) ) {
+				// free, or the list of a destroyed pool
+				local[ i ].serial = m_serial;
+				local[ i ].head = NULL;
+				local[ i ].count = 0;
+				return &local[ i ];
+			}
+		}
+		return NULL;
+	}
+
+	// Takes an object from the shared list of single objects, used by threads without a list for this pool
+	Node *
+	take() {
+		{
+			__LockGuard lock( m_mutex );
+			if ( m_free ) {
+				Node * node = m_free;
+				m_free = node->next;
+				return node;
+			}
+		}
+		Cache batch = { m_serial, NULL, 0 };
+		refill( batch );
+		Node * node = batch.head;
+		__LockGuard lock( m_mutex );
+		for ( Node * next = node->next; next; ) {
+			Node * rest = next->next;
+			next->next = m_free;
+			m_free = next;
+			next = rest;
+		}
+		return node;
+	}
+
+	// Returns an object to the shared list of single objects
+	void
+	give( Node * node ) {
+		__LockGuard lock( m_mutex );
+		node->next = m_free;
+		m_free = node;
+	}
+
+	// Returns a list of objects to the shared list of single objects
+	void
+	giveList( Node * head ) {
+		Node * last = head;
+		while ( last->next ) {
+			last = last->next;
+		}
+		__LockGuard lock( m_mutex );
+		last->next = m_free;
+		m_free = head;
+	}
+
+	// Moves a batch from the shared lists to the thread list, allocating it if there are none
+	void
+	refill( Cache& local ) {
+		{
+			__LockGuard lock( m_mutex );
+			if ( !m_batches.empty() ) {
+				local.head = m_batches.back();
+				local.count = m_batchSize;
+				m_batches.pop_back();
+				return;
+			}
+			if ( m_free ) {
+				// objects returned by exited threads
+				local.head = m_free;
+				local.count = 1;
+				Node * last = m_free;
+				for ( ; last->next && local.count < m_batchSize; ++local.count ) {
+					last = last->next;
+				}
+				m_free = last->next;
+				last->next = NULL;
+				return;
+			}
+		}
+		Node * slab = static_cast< Node * >( malloc( m_batchSize * sizeof( Node ) ) );
+		if ( !slab ) {
+			throw std::bad_alloc();
+		}
+		for ( size_t i = 0; i + 1 < m_batchSize; ++i ) {
+			slab[ i ].next = &slab[ i + 1 ];
+		}
+		slab[ m_batchSize - 1 ].next = NULL;
+		{
+			__LockGuard lock( m_mutex );
+			m_slabs.push_back( slab );
+		}
+		local.head = slab;
+		local.count = m_batchSize;
+	}
+
+	// Moves a batch from the thread list to the shared list
+	void
+	spill( Cache& local ) {
+		Node * batch = local.head;
+		Node * last = batch;
+		for ( size_t i = 1; i < m_batchSize; ++i ) {
+			last = last->next;
+		}
+		local.head = last->next;
+		local.count -= m_batchSize;
+		last->next = NULL;
+		__LockGuard lock( m_mutex );
+		m_batches.push_back( batch );
+	}
+
+	static
+	Registry&
+	registry() {
+		static Registry pools;
+		return pools;
+	}
+
+	// Registers a new pool, returning its serial. Serials are never reused, so a thread list can not be
+	// taken for the list of a later pool
+	unsigned
+	open() {
+		Registry& pools = registry();
+		__LockGuard lock( pools.mutex );
+		pools.alive[ ++pools.last ] = this;
+		return pools.last;
+	}
+
+	void
+	close() {
+		Registry& pools = registry();
+		__LockGuard lock( pools.mutex );
+		pools.alive.erase( m_serial );
+	}
+
+	std::vector< Node * >	m_slabs;
+	std::vector< Node * >	m_batches;
+	Node *					m_free;
+	size_t					m_batchSize;
+	unsigned				m_serial;
+	mutable __Mutex			m_mutex;
+};
+
+// Polymorphic types without a virtual destructor would make delete warn, though create makes instances
+// of that exact type. They are allocated apart, so the delete expression is only instantiated for other types
+template< typename T >
+struct __PlainDelete
+	:	boost::integral_constant< bool, !boost::is_polymorphic< T >::value || boost::has_virtual_destructor< T >::value > {};
+
+/**
+ * \brief Creator of the instances of a Metatype, from an optional pool
+ *
+ * The pool should be enabled before creating any instance, as instances
+ * created without the pool can not be destroyed by it.
+ * \tparam T the type of the instances
+ */
+template< typename T >
+class __PoolSlot {
+public:
+	__PoolSlot()
+		:	m_pool( NULL ),
+			m_created( false ) {}
+
+	~__PoolSlot() {
+		delete m_pool;
+	}
+
+	void
+	enable( size_t batchSize ) {
+		if ( m_created.load() ) {
+			throw Error( "Pool enabled after creating instances without it" );
+		}
+		if ( !m_pool ) {
+			m_pool = new ObjectPool< T >( batchSize );
+		}
+	}
+
+	ObjectPool< T > *
+	pool() const {
+		return m_pool;
+	}
+
+	T *
+	create() {
+		if ( m_pool ) {
+			return m_pool->create();
+		}
+		if ( !m_created.load() ) {
+			m_created.store( true );
+		}
+		return allocate< T >();
+	}
+
+	void
+	destroy( T * obj ) {
+		if ( m_pool ) {
+			m_pool->destroy( obj );
+		}
+		else {
+			deallocate< T >( obj );
+		}
+	}
+
+private:
+	__PoolSlot( const __PoolSlot& );
+	__PoolSlot& operator = ( const __PoolSlot& );
+
+	template< typename U >
+	static
+	typename boost::enable_if< __PlainDelete< U >, U * >::type
+	allocate() {
+		return new U();
+	}
+
+	template< typename U >
+	static
+	typename boost::disable_if< __PlainDelete< U >, U * >::type
+	allocate() {
+		void * memory = ::operator new( sizeof( U ) );
+		try {
+			return new ( memory ) U();
+		}
+		catch ( ... ) {
+			::operator delete( memory );
+			throw;
+		}
+	}
+
+	template< typename U >
+	static
+	typename boost::enable_if< __PlainDelete< U >, void >::type
+	deallocate( U * obj ) {
+		delete obj;
+	}
+
+	template< typename U >
+	static
+	typename boost::disable_if< __PlainDelete< U >, void >::type
+	deallocate( U * obj ) {
+		if ( obj ) {
+			obj->~U();
+			::operator delete( obj );
+		}
+	}
+
+	ObjectPool< T > *	m_pool;
+	// instances were created without the pool
+	__Atomic< bool >	m_created;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jrttipoolH
@@ -1,303 +1,556 @@
-#ifndef propertyH
-#define propertyH
-
-#include <vector>
-#include <boost/shared_ptr.hpp>
-#include <boost/any.hpp>
-#include "annotations.hpp"
-
-namespace jrtti {
-
-//------------------------------------------------------------------------------
-/**
- * \brief Property abstraction
- */
-class Property
-{
-	friend class Reflector;
-public:
-	enum Mode {Readable=1, Writable=2};
-
-	Property() {
-    	_mode = (Mode)0;
-	}
-
-	/**
-	 * \brief Retrieves the name of this property
-	 * \return the property name
-	 */
-	std::string
-	name() const {
-		return _name;
-	}
-
-	/**
-	 * \brief Sets the name of this property
-	 * \param name the property name
-	 */
-	void
-	name(std::string name)	{
-		_name = name;
-	}
-
-	/**
-	 * \brief Assigns an annotation container to this property
-	 * \param annotationsContainer the annotation container
-	 */
-	void
-	annotations( const Annotations& annotationsContainer ) {
-		_annotations = annotationsContainer;
-	}
-
-	/**
-	 * \brief Retrieve the associated annotations container
-	 * \return the associated annotations container of this property
-	 */
-	Annotations&
-	annotations() {
-		return _annotations;
-	}
-
-	/**
-	 * \brief Retrieves the Metatype of this property
-	 * \return the meta type
-	 */
-	Metatype&
-	metatype() const {
-		return *_metaType;
-	}
-
-	/**
-	 * \brief Check if property is readable
-	 *
-	 * Property is readable if it has a declared getter method or is a class member
-	 * \return true if its value can be retrieved
-	 */
-	bool
-	isReadable() const {
-		return (_mode & Readable);
-	}
-
-	/**
-	 * \brief Check if property is writable
-	 *
-	 * Property is writable if it has a declared setter method or is a class member
-	 * \return true if its value can be set
-	 */
-	bool
-	isWritable() const {
-		return (_mode & Writable) != 0;
-	}
-
-	/**
-	 * \brief Check if property is read-write
-	 * \return true if property is writable and readable
-	 */
-	bool
-	isReadWrite() const {
-		return isReadable() & isWritable();
-	}
-
-	/**
-	 * \brief Check if property is read-only
-	 * \return true if property is read-only
-	 */
-	bool
-	isReadOnly() const {
-		return isReadable() & !isWritable();
-	}
-
-	void setMode(Mode mode){
-			_mode = (Mode) (_mode | mode);
-	}
-
-	/**
-	 * \brief Set the property value
-	 * \param instance the object address where to set the property value
-	 * \param value the value to be set. Will accept any standart or custom type
-	 */
-	virtual
-	void
-	set( void * instance, const boost::any& value ) = 0;
-
-	/**
-	 * \brief Get the property value in a boost::any container
-	 * \param instance the object address from where to retrieve the property value
-	 * \return the property value in a boost::any container
-	 */
-	virtual
-	boost::any
-	get(void * instance) = 0;
-
-	/**
-	 * \brief Get the property value
-	 *
-	 * \tparam PropT the type of the property value
-	 * \param instance the object address from where to retrieve the property value
-	 * \return the property value as PropT
-	 */
-	template < typename PropT >
-	PropT
-	get( void * instance ) {
-		return boost::any_cast< PropT >( get( instance ) );
-	}
-
-protected:
-	void
-	setMetatype( Metatype * mt ) {
-		_metaType = mt;
-	}
-
-private:
-	Annotations	_annotations;
-	Metatype * _metaType;
-	std::string	_name;
-	Mode 	   	_mode;
-};
-
-template <class ClassT, class PropT>
-class TypedProperty : public Property
-{
-public:
-	typedef typename boost::remove_reference< PropT >::type PropNoRefT;
-
-	TypedProperty()
-	{
-		try {
-			setMetatype( &jrtti::metatype< PropT >() );
-		} catch ( Error ) {
-			setMetatype( NULL );
-        	Reflector::instance().addPendingProperty( typeid( PropT ).name(), this );
-		}
-	}
-
-	TypedProperty&
-	setter( boost::function<void ( ClassT*, PropT ) > functor)
-	{
-		if (!functor.empty()) {
-			setMode( Writable );
-			m_setter = functor;
-		}
-		m_dataMember = NULL;
-		return *this;
-	}
-
-	TypedProperty&
-	setter( PropNoRefT ClassT::* dataMember)
-	{
-		setMode( Writable );
-		setMode( Readable );
-		m_dataMember = dataMember;
-		m_setter = NULL;
-		return *this;
-	}
-
-	TypedProperty&
-	getter( boost::function< PropT (ClassT*) > functor )	{
-		if ( !functor.empty() ) {
-			setMode( Readable );
-			m_getter = functor;
-		}
-		else {
-			m_getter = NULL;
-		}
-		return *this;
-	}
-
-	virtual
-	boost::any
-	get( void * instance )	{
-		return internal_get<PropT>( instance );
-	}
-
-	virtual
-	void
-	set( void * instance, const boost::any& val)	{
-		if (isWritable()) {
-			PropNoRefT p = jrtti_cast< PropNoRefT >( val );
-			return internal_set( (ClassT *)instance, p );
-		}
-	}
-
-private:
-	//SFINAE for pointers
-	template < typename T>
-	typename boost::enable_if< typename boost::is_pointer< T >::type, boost::any >::type
-	internal_get(void * instance)	{
-		return  (T)m_getter( (ClassT *)instance );
-	}
-
-	//SFINAE for references
-	template < typename T>
-	typename boost::enable_if< typename boost::is_reference< T >::type, boost::any >::type
-	internal_get(void * instance)	{
-		return boost::ref( (T) m_getter( (ClassT *)instance ) );
-	}
-
-	//SFINAE for values
-	template < typename T>
-	typename boost::disable_if< boost::type_traits::ice_or<
-										boost::is_pointer< T >::value,
-										boost::is_reference< T >::value >, boost::any >::type
-	internal_get(void * instance) {
-		PropT res = m_getter( (ClassT *)instance );
-		return res;
-	}
-
-	void
-	internal_set(ClassT * instance, PropT value) {
-		if (m_dataMember)
-		{
-			ClassT * p = static_cast<ClassT *>(instance);
-			p->*m_dataMember = value;
-		}
-		else
-			m_setter((ClassT *)instance,(PropT)value);
-	}
-
-	boost::function<void (ClassT*, PropT)>	m_setter;
-	boost::function< PropT (ClassT*)>		m_getter;
-	PropNoRefT ClassT::*					m_dataMember;
-};
-
-template< typename ClassT >
-class UntypedProperty : public Property 
-{
-public:
-	UntypedProperty( Metatype& mt, const std::string& pname ) {
-		if ( !mt.isPointer() ) {
-			throw Error( "Metatype of '" + pname + "' must be a pointer type" );
-		}
-		setMetatype( &mt );
-		name( pname );
-		setMode( Readable );
-		setMode( Writable );
-	}
-
-	UntypedProperty&
-	member( void * ClassT::* dataMember )
-	{
-		m_dataMember = dataMember;
-		return *this;
-	}
-
-	void
-	set( void * instance, const boost::any& value ) {
-		if ( !( metatype().typeInfo() == value.type() || value.type() == typeid( void * ) ) )
-			throw Error( "pointer required for parameter value" );
-		ClassT * p = static_cast<ClassT *>(instance);
-		p->*m_dataMember = jrtti_cast< void * >( value );
-	}
-
-	boost::any
-	get( void * instance ) {
-		ClassT * p = static_cast<ClassT *>(instance);
-		return p->*m_dataMember;
-	}
-
-private:
-	void * ClassT::*	m_dataMember;
-};
-//------------------------------------------------------------------------------
-}; //namespace jrtti
-#endif  //propertyH
+#ifndef propertyH
+#define propertyH
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/any.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include "annotations.hpp"
+
+namespace jrtti {
+
+template< typename T > class PropertyAccessor;
+
+//------------------------------------------------------------------------------
+/**
+ * \brief Property abstraction
+ */
+class Property
+{
+	friend class Reflector;
+public:
+	enum Mode {Readable=1, Writable=2};
+
+	/**
+	 * \brief Types of data members accessed directly in memory
+	 */
+	enum MemberKind {
+		memberNone,			///< not a data member or not a directly accessed type
+		memberBool,
+		memberChar,
+		memberShort,
+		memberInt,
+		memberLong,
+		memberFloat,
+		memberDouble,
+		memberLongDouble,
+		memberWchar,
+		memberString
+	};
+
+	Property() {
+    	_mode = (Mode)0;
+		_memberKind = memberNone;
+		_memberOffset = 0;
+		_dataMember = false;
+	}
+
+	/**
+	 * \brief Retrieves the name of this property
+	 * \return the property name
+	 */
+	std::string
+	name() const {
+		return _name;
+	}
+
+	/**
+	 * \brief Sets the name of this property
+	 * \param name the property name
+	 */
+	void
+	name(std::string name)	{
+		_name = name;
+	}
+
+	/**
+	 * \brief Assigns an annotation container to this property
+	 * \param annotationsContainer the annotation container
+	 */
+	void
+	annotations( const Annotations& annotationsContainer ) {
+		_annotations = annotationsContainer;
+	}
+
+	/**
+	 * \brief Retrieve the associated annotations container
+	 * \return the associated annotations container of this property
+	 */
+	Annotations&
+	annotations() {
+		return _annotations;
+	}
+
+	/**
+	 * \brief Retrieves the Metatype of this property
+	 * \return the meta type
+	 */
+	Metatype&
+	metatype() const {
+		return *_metaType;
+	}
+
+	/**
+	 * \brief Check if the Metatype of this property is already declared
+	 *
+	 * Properties of types not yet declared get their Metatype when the type is declared
+	 * \return true if the Metatype is available
+	 */
+	bool
+	hasMetatype() const {
+		return _metaType != NULL;
+	}
+
+	/**
+	 * \brief Check if property is readable
+	 *
+	 * Property is readable if it has a declared getter method or is a class member
+	 * \return true if its value can be retrieved
+	 */
+	bool
+	isReadable() const {
+		return (_mode & Readable);
+	}
+
+	/**
+	 * \brief Check if property is writable
+	 *
+	 * Property is writable if it has a declared setter method or is a class member
+	 * \return true if its value can be set
+	 */
+	bool
+	isWritable() const {
+		return (_mode & Writable) != 0;
+	}
+
+	/**
+	 * \brief Check if property is read-write
+	 * \return true if property is writable and readable
+	 */
+	bool
+	isReadWrite() const {
+		return isReadable() & isWritable();
+	}
+
+	/**
+	 * \brief Check if property is read-only
+	 * \return true if property is read-only
+	 */
+	bool
+	isReadOnly() const {
+		return isReadable() & !isWritable();
+	}
+
+	void setMode(Mode mode){
+			_mode = (Mode) (_mode | mode);
+	}
+
+	/**
+	 * \brief Retrieves the type of the data member of this property
+	 *
+	 * Properties declared from a data member of a fundamental type or std::string
+	 * can be read and written directly in memory through memberAddress.
+	 * \return the data member type or memberNone if it can not be accessed directly
+	 */
+	MemberKind
+	memberKind() const {
+		return _memberKind;
+	}
+
+	/**
+	 * \brief Check if property is a class data member
+	 *
+	 * The address of data members is known without calling any accessor
+	 * \return true if the address of the property value can be retrieved with memberAddress
+	 */
+	bool
+	isDataMember() const {
+		return _dataMember;
+	}
+
+	/**
+	 * \brief Retrieves the address of the data member of this property
+	 *
+	 * Only valid if isDataMember is true
+	 * \param instance the object address
+	 * \return the address of the data member in instance
+	 */
+	void *
+	memberAddress( void * instance ) const {
+		return static_cast< char * >( instance ) + _memberOffset;
+	}
+
+	/**
+	 * \brief Set the property value
+	 * \param instance the object address where to set the property value
+	 * \param value the value to be set. Will accept any standart or custom type
+	 */
+	virtual
+	void
+	set( void * instance, const boost::any& value ) = 0;
+
+	/**
+	 * \brief Get the property value in a boost::any container
+	 * \param instance the object address from where to retrieve the property value
+	 * \return the property value in a boost::any container
+	 */
+	virtual
+	boost::any
+	get(void * instance) = 0;
+
+	/**
+	 * \brief Get the property value
+	 *
+	 * \tparam PropT the type of the property value
+	 * \param instance the object address from where to retrieve the property value
+	 * \return the property value as PropT
+	 */
+	template < typename PropT >
+	PropT
+	get( void * instance ) {
+		return boost::any_cast< PropT >( get( instance ) );
+	}
+
+	/**
+	 * \brief Get a typed accessor for this property
+	 *
+	 * The accessor reads and writes the property value without boost::any
+	 * \tparam PropT the type of the property value
+	 * \return the property accessor
+	 * \throw BadCast if PropT is not the type of the property
+	 * \sa PropertyAccessor
+	 */
+	template < typename PropT >
+	PropertyAccessor< PropT >
+	accessor() {
+		return PropertyAccessor< PropT >( *this );
+	}
+
+protected:
+	void
+	setMetatype( Metatype * mt ) {
+		_metaType = mt;
+	}
+
+	void
+	setMember( MemberKind kind, size_t offset ) {
+		_memberKind = kind;
+		_memberOffset = offset;
+		_dataMember = true;
+	}
+
+	void
+	resetMember() {
+		_memberKind = memberNone;
+		_memberOffset = 0;
+		_dataMember = false;
+	}
+
+private:
+	Annotations	_annotations;
+	Metatype * _metaType;
+	std::string	_name;
+	Mode 	   	_mode;
+	MemberKind	_memberKind;
+	size_t		_memberOffset;
+	bool		_dataMember;
+};
+
+// Property::MemberKind of the types accessed directly in memory
+template< typename T > struct __memberKind { static const Property::MemberKind value = Property::memberNone; };
+template<> struct __memberKind< bool > { static const Property::MemberKind value = Property::memberBool; };
+template<> struct __memberKind< char > { static const Property::MemberKind value = Property::memberChar; };
+template<> struct __memberKind< short > { static const Property::MemberKind value = Property::memberShort; };
+template<> struct __memberKind< int > { static const Property::MemberKind value = Property::memberInt; };
+template<> struct __memberKind< long > { static const Property::MemberKind value = Property::memberLong; };
+template<> struct __memberKind< float > { static const Property::MemberKind value = Property::memberFloat; };
+template<> struct __memberKind< double > { static const Property::MemberKind value = Property::memberDouble; };
+template<> struct __memberKind< long double > { static const Property::MemberKind value = Property::memberLongDouble; };
+template<> struct __memberKind< wchar_t > { static const Property::MemberKind value = Property::memberWchar; };
+template<> struct __memberKind< std::string > { static const Property::MemberKind value = Property::memberString; };
+
+// Access to property values of type T without boost::any, used by PropertyAccessor
+template< typename T >
+class __TypedAccess
+{
+public:
+	virtual
+	~__TypedAccess() {}
+
+	virtual
+	T
+	typedGet( void * instance ) = 0;
+
+	virtual
+	void
+	typedSet( void * instance, const T& value ) = 0;
+};
+
+template <class ClassT, class PropT>
+class TypedProperty : public Property, public __TypedAccess< typename boost::remove_reference< PropT >::type >
+{
+public:
+	typedef typename boost::remove_reference< PropT >::type PropNoRefT;
+
+	TypedProperty()
+		:	m_dataMember( NULL )
+	{
+		try {
+			setMetatype( &jrtti::metatype< PropT >() );
+		} catch ( Error ) {
+			setMetatype( NULL );
+        	Reflector::instance().addPendingProperty( typeid( PropT ).name(), this );
+		}
+	}
+
+	TypedProperty&
+	setter( boost::function<void ( ClassT*, PropT ) > functor)
+	{
+		if (!functor.empty()) {
+			setMode( Writable );
+			m_setter = functor;
+		}
+		m_dataMember = NULL;
+		resetMember();
+		return *this;
+	}
+
+	TypedProperty&
+	setter( PropNoRefT ClassT::* dataMember)
+	{
+		setMode( Writable );
+		setMode( Readable );
+		m_dataMember = dataMember;
+		m_setter = NULL;
+		// dataMember can not belong to a virtual base, so its offset is the same for every instance
+		boost::aligned_storage< sizeof( ClassT ), boost::alignment_of< ClassT >::value > storage;
+		ClassT * object = static_cast< ClassT * >( storage.address() );
+		setMember( __memberKind< PropNoRefT >::value,
+				   reinterpret_cast< char * >( &( object->*dataMember ) ) - reinterpret_cast< char * >( object ) );
+		return *this;
+	}
+
+	TypedProperty&
+	getter( boost::function< PropT (ClassT*) > functor )	{
+		if ( !functor.empty() ) {
+			setMode( Readable );
+			m_getter = functor;
+		}
+		else {
+			m_getter = NULL;
+		}
+		return *this;
+	}
+
+	virtual
+	boost::any
+	get( void * instance )	{
+		checkReadable();
+		return internal_get<PropT>( instance );
+	}
+
+	virtual
+	void
+	set( void * instance, const boost::any& val)	{
+		if (isWritable()) {
+			if ( m_dataMember && val.type() == typeid( PropNoRefT ) ) {
+				static_cast< ClassT * >( instance )->*m_dataMember = *boost::unsafe_any_cast< PropNoRefT >( &val );
+				return;
+			}
+			PropNoRefT p = jrtti_cast< PropNoRefT >( val );
+			return internal_set( (ClassT *)instance, p );
+		}
+	}
+
+	virtual
+	PropNoRefT
+	typedGet( void * instance ) {
+		if ( m_dataMember ) {
+			return static_cast< ClassT * >( instance )->*m_dataMember;
+		}
+		checkReadable();
+		return m_getter( (ClassT *)instance );
+	}
+
+	virtual
+	void
+	typedSet( void * instance, const PropNoRefT& value ) {
+		if ( isWritable() ) {
+			if ( m_dataMember ) {
+				static_cast< ClassT * >( instance )->*m_dataMember = value;
+			}
+			else if ( !m_setter.empty() ) {
+				PropNoRefT p( value );
+				m_setter( (ClassT *)instance, p );
+			}
+		}
+	}
+
+private:
+	void
+	checkReadable() const {
+		if ( !isReadable() || ( !m_dataMember && m_getter.empty() ) ) {
+			throw Error( "Property '" + name() + "' is not readable" );
+		}
+	}
+
+	//SFINAE for pointers
+	template < typename T>
+	typename boost::enable_if< typename boost::is_pointer< T >::type, boost::any >::type
+	internal_get(void * instance)	{
+		return  (T)m_getter( (ClassT *)instance );
+	}
+
+	//SFINAE for references
+	template < typename T>
+	typename boost::enable_if< typename boost::is_reference< T >::type, boost::any >::type
+	internal_get(void * instance)	{
+		return boost::ref( (T) m_getter( (ClassT *)instance ) );
+	}
+
+	//SFINAE for values
+	template < typename T>
+	typename boost::disable_if< boost::type_traits::ice_or<
+										boost::is_pointer< T >::value,
+										boost::is_reference< T >::value >, boost::any >::type
+	internal_get(void * instance) {
+		if ( m_dataMember ) {
+			return static_cast< ClassT * >( instance )->*m_dataMember;
+		}
+		PropT res = m_getter( (ClassT *)instance );
+		return res;
+	}
+
+	void
+	internal_set(ClassT * instance, PropT value) {
+		if (m_dataMember)
+		{
+			ClassT * p = static_cast<ClassT *>(instance);
+			p->*m_dataMember = value;
+		}
+		else
+			m_setter((ClassT *)instance,(PropT)value);
+	}
+
+	boost::function<void (ClassT*, PropT)>	m_setter;
+	boost::function< PropT (ClassT*)>		m_getter;
+	PropNoRefT ClassT::*					m_dataMember;
+};
+
+template< typename ClassT >
+class UntypedProperty : public Property 
+{
+public:
+	UntypedProperty( Metatype& mt, const std::string& pname ) {
+		if ( !mt.isPointer() ) {
+			throw Error( "Metatype of '" + pname + "' must be a pointer type" );
+		}
+		setMetatype( &mt );
+		name( pname );
+		setMode( Readable );
+		setMode( Writable );
+	}
+
+	UntypedProperty&
+	member( void * ClassT::* dataMember )
+	{
+		m_dataMember = dataMember;
+		return *this;
+	}
+
+	void
+	set( void * instance, const boost::any& value ) {
+		if ( !( metatype().typeInfo() == value.type() || value.type() == typeid( void * ) ) )
+			throw Error( "pointer required for parameter value" );
+		ClassT * p = static_cast<ClassT *>(instance);
+		p->*m_dataMember = jrtti_cast< void * >( value );
+	}
+
+	boost::any
+	get( void * instance ) {
+		ClassT * p = static_cast<ClassT *>(instance);
+		return p->*m_dataMember;
+	}
+
+private:
+	void * ClassT::*	m_dataMember;
+};
+/**
+ * \brief Typed handle to a property
+ *
+ * Reads and writes the value of a property without boxing it in a boost::any
+ * nor converting it through jrtti_cast. The type is checked once, when the
+ * accessor is created. Data members of fundamental types and std::string are
+ * accessed directly in memory, other properties through a single virtual call
+ * to their accessors.
+ *
+ * \tparam T the type of the property value, without reference
+ */
+template< typename T >
+class PropertyAccessor
+{
+public:
+	/**
+	 * \brief Constructor
+	 * \param prop the property to access
+	 * \throw BadCast if T is not the type of the property
+	 */
+	PropertyAccessor( Property& prop )
+		:	m_property( &prop ),
+			m_access( dynamic_cast< __TypedAccess< T > * >( &prop ) ),
+			m_direct( prop.memberKind() != Property::memberNone && prop.memberKind() == __memberKind< T >::value )
+	{
+		if ( !m_access ) {
+			throw BadCast( typeid( T ).name() );
+		}
+	}
+
+	/**
+	 * \brief Get the property value
+	 * \param instance the object address from where to retrieve the property value
+	 * \return the property value
+	 */
+	T
+	get( void * instance ) const {
+		if ( m_direct ) {
+			return *static_cast< T * >( m_property->memberAddress( instance ) );
+		}
+		return m_access->typedGet( instance );
+	}
+
+	/**
+	 * \brief Set the property value
+	 *
+	 * Read only properties are not modified
+	 * \param instance the object address where to set the property value
+	 * \param value the value to be set
+	 */
+	void
+	set( void * instance, const T& value ) const {
+		if ( m_direct ) {
+			*static_cast< T * >( m_property->memberAddress( instance ) ) = value;
+		}
+		else {
+			m_access->typedSet( instance, value );
+		}
+	}
+
+	/**
+	 * \brief Retrieves the accessed property
+	 * \return the property
+	 */
+	Property&
+	property() const {
+		return *m_property;
+	}
+
+private:
+	Property *				m_property;
+	__TypedAccess< T > *	m_access;
+	bool					m_direct;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //propertyH
@@ -0,0 +1,85 @@
+#ifndef jrttipropertypathH
+#define jrttipropertypathH
+
+#include <string>
+#include <vector>
+
+namespace jrtti {
+
+class Metatype;
+class Property;
+
+/**
+ * \brief Pre-resolved full categorized property name
+ *
+ * Holds the chain of properties named by a dotted path as "point.x",
+ * resolved once against a root Metatype. Metatype::eval, Metatype::apply and
+ * Metaobject accept a PropertyPath in place of the path string, so the path
+ * is not parsed nor looked up again on every access.
+ * The path stays valid while the properties it names are declared.
+ */
+class PropertyPath {
+public:
+	/**
+	 * \brief Constructor
+	 * \param root the Metatype of the objects the path is applied to
+	 * \param path full categorized property name dotted separated. ex: "point.x"
+	 * \throw Error if a property of the path is not declared
+	 */
+	PropertyPath( Metatype& root, const std::string& path );
+
+	/**
+	 * \brief Retrieves the Metatype the path was resolved against
+	 * \return the root Metatype
+	 */
+	Metatype&
+	root() const {
+		return *m_root;
+	}
+
+	/**
+	 * \brief Retrieves the path as text
+	 * \return the dotted path
+	 */
+	const std::string&
+	str() const {
+		return m_path;
+	}
+
+	/**
+	 * \brief Retrieves the number of properties in the path
+	 * \return the path length
+	 */
+	size_t
+	size() const {
+		return m_properties.size();
+	}
+
+	/**
+	 * \brief Retrieves a property of the path
+	 * \param index position of the property, 0 being the property of the root Metatype
+	 * \return the property
+	 */
+	Property&
+	operator []( size_t index ) const {
+		return *m_properties[ index ];
+	}
+
+	/**
+	 * \brief Retrieves the last property of the path
+	 * \return the property holding the value the path evaluates to
+	 */
+	Property&
+	leaf() const {
+		return *m_properties.back();
+	}
+
+private:
+	Metatype *					m_root;
+	std::vector< Property * >	m_properties;
+	std::string					m_path;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jrttipropertypathH
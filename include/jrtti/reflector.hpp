@@ -7,17 +7,42 @@
 #endif
 
 #include <set>
+#include <cstring>
+#include <boost/unordered_map.hpp>
 #include "basetypes.hpp"
 #include "custommetaclass.hpp"
 #include "collection.hpp"
 #include "metaobject.hpp"
 #include "property.hpp"
+#include "typenames.hpp"
 #include <typeinfo>
 
 namespace jrtti {
 
 typedef std::map< std::string, Metatype * > TypeMap;
 
+// Hash map key wrapping a std::type_info, as std::type_index does in C++11
+struct __TypeKey {
+	__TypeKey( const std::type_info& typeinfo )
+		:	info( &typeinfo ) {}
+
+	bool
+	operator == ( const __TypeKey& other ) const {
+		return *info == *other.info;
+	}
+
+	const std::type_info * info;
+};
+
+// Hashes the type name, as type_info objects of a type may not be unique across modules
+struct __TypeKeyHash {
+	size_t
+	operator () ( const __TypeKey& key ) const {
+		const char * name = key.info->name();
+		return boost::hash_range( name, name + strlen( name ) );
+	}
+};
+
 /**
  * \brief The jrtti engine
  */
@@ -28,6 +53,9 @@ public:
 	~Reflector()
 	{
     	eraseMetatypes();
+		for ( size_t i = 0; i < m_cachedMetatypes.size(); ++i ) {
+			delete m_cachedMetatypes[ i ];
+		}
 	}
 
 	void
@@ -51,17 +79,17 @@ public:
 	{
 		static Reflector inst;
 		return inst;
-	}
-#else
-	;
-#endif
+	}
+#else
+	;
+#endif
 
 	template <typename C>
 	CustomMetaclass<C>&
 	declare( const Annotations& annotations = Annotations() )
 	{
-		if ( _meta_types.count( typeid( C ).name() ) ) {
-			return *( dynamic_cast< CustomMetaclass<C> * >( &metatype< C >() ) );
+		if ( findMetatype( typeid( C ) ) ) {
+			return *( dynamic_cast< CustomMetaclass<C> * >( &metatype< C >() ) );
 		}
 
 		CustomMetaclass<C> * mc = new CustomMetaclass<C>( annotations );
@@ -74,8 +102,8 @@ public:
 	CustomMetaclass<C, boost::true_type>&
 	declareAbstract( const Annotations& annotations = Annotations() )
 	{
-		if ( _meta_types.count( typeid( C ).name() ) ) {			// use find and avoid double search calling metatype
-			return *( dynamic_cast< CustomMetaclass<C, boost::true_type> * >( &metatype< C >() ) );
+		if ( findMetatype( typeid( C ) ) ) {
+			return *( dynamic_cast< CustomMetaclass<C, boost::true_type> * >( &metatype< C >() ) );
 		}
 
 		CustomMetaclass<C, boost::true_type> * mc = new CustomMetaclass<C, boost::true_type>( annotations );
@@ -90,8 +118,8 @@ public:
 	{
 	//////////  COMPILER ERROR: Class C is not a Collection //// Class C should implement type iterator to be a collection
 		typedef typename C::iterator iterator;
-		if ( _meta_types.count( typeid( C ).name() ) ) {
-			return *( dynamic_cast< Metacollection<C> * >( &metatype< C >( ) ) );
+		if ( findMetatype( typeid( C ) ) ) {
+			return *( dynamic_cast< Metacollection<C> * >( &metatype< C >( ) ) );
 		}
 
 		Metacollection<C> * mc = new Metacollection<C>( annotations );
@@ -113,30 +141,64 @@ public:
 		m_prefixDecorators.push_back( decorator );
 	}
 
+	/**
+	 * \brief Retrieve Metatype
+	 *
+	 * The found Metatype is cached for T, so only the first call looks it up.
+	 * The cache is invalidated by clear. Can be called from several threads
+	 * once the types are declared.
+	 * \tparam T the type to retrieve
+	 * \return the found Metatype
+	 * \throw Error if not found
+	 */
 	template < typename T >
 	Metatype &
 	metatype() {
-		return metatype( typeid( T ) );
+		static __Atomic< const CachedMetatype * > cached( NULL );
+		// read before the lookup, so a clear running meanwhile makes the entry stale
+		const unsigned generation = m_generation.load();
+		const CachedMetatype * entry = cached.load();
+		if ( entry && entry->generation == generation ) {
+			return *entry->metatype;
+		}
+		Metatype& mt = metatype( typeid( T ) );
+		cached.store( cacheMetatype( &mt, generation ) );
+		return mt;
 	}
 
 	Metatype &
 	metatype( const std::type_info& tInfo ) {
-		return metatype( tInfo.name() );
+		Metatype * mt = findMetatype( tInfo );
+		return mt ? *mt : metatype( tInfo.name() );
 	}
 
+	/**
+	 * \brief Retrieve Metatype by name
+	 *
+	 * Looks for a Metatype in a hash index of type names. Types are indexed by
+	 * their typeid name, as returned by typeid( T ).name(), and by their
+	 * readable name, as returned by jrtti::typeName.
+	 * \param pname the type name
+	 * \return the found Metatype
+	 * \throw Error if not found
+	 */
 	Metatype &
 	metatype( const std::string& pname ) {
+		NameIndexMap::iterator it = m_nameIndex.find( pname );
+		if ( it != m_nameIndex.end() ) {
+			return *it->second;
+		}
 		std::string name = pname;
 #ifdef __BORLANDC__
 		if ( name[name.length()-1]=='&' ) {
-			name = name.substr( 0, name.length()-2 );
+			name = name.substr( 0, name.length()-2 );
+			it = m_nameIndex.find( name );
+			if ( it != m_nameIndex.end() ) {
+				return *it->second;
+			}
 		}
 #endif
-		TypeMap::iterator it = _meta_types.find( name );
-		if ( it == _meta_types.end() ) {
-			throw Error( "Metatype '" + demangle( name ) + "' not declared" );
-		}
-		return *it->second;
+		throw Error( "Metatype '" + demangle( name ) + "' not declared" );
 	}
 
 	/**
@@ -156,12 +218,12 @@ public:
 	std::string
 	demangle( const std::string& name ) {
 #ifdef __GNUG__
-		int status = -4;
-		char* res = abi::__cxa_demangle(name.c_str(), NULL, NULL, &status);
-		const char* const demangled_name = (status==0)?res:name.c_str();
-		std::string ret_val(demangled_name);
-		free(res);
-		return ret_val;
+		int status = -4;
+		char* res = abi::__cxa_demangle(name.c_str(), NULL, NULL, &status);
+		const char* const demangled_name = (status==0)?res:name.c_str();
+		std::string ret_val(demangled_name);
+		free(res);
+		return ret_val;
 #elif __BORLANDC__
 		return name;
 #else
@@ -187,21 +249,51 @@ public:
 private:
 	typedef std::multimap< std::string, Property * > PendingProps;
 
+	// Metatype found by metatype< T > in a generation, published as one pointer
+	struct CachedMetatype {
+		Metatype *	metatype;
+		unsigned	generation;
+	};
+
+	typedef boost::unordered_map< __TypeKey, Metatype *, __TypeKeyHash > TypeIndexMap;
+	typedef boost::unordered_map< std::string, Metatype * > NameIndexMap;
+
 	Reflector()
+		:	m_generation( 0 )
 	{
 		clear();
 	};
 
+	// Entries are kept until the Reflector is destroyed, as other threads may still be reading them
+	const CachedMetatype *
+	cacheMetatype( Metatype * mt, unsigned generation ) {
+		CachedMetatype * entry = new CachedMetatype();
+		entry->metatype = mt;
+		entry->generation = generation;
+		__LockGuard lock( m_cacheMutex );
+		m_cachedMetatypes.push_back( entry );
+		return entry;
+	}
+
+	Metatype *
+	findMetatype( const std::type_info& tInfo ) {
+		TypeIndexMap::iterator it = m_typeIndex.find( tInfo );
+		return it != m_typeIndex.end() ? it->second : NULL;
+	}
+
 	void eraseMetatypes() {
 		std::set< Metatype * > pending;
-		for ( TypeMap::iterator it = _meta_types.begin(); it != _meta_types.end(); ++it) {
-			pending.insert( it->second );
-		}
-
-		for ( std::set< Metatype * >::iterator it = pending.begin(); it != pending.end(); ++it ) {
-			delete *it;
-		}
-		_meta_types.clear();
+		for ( TypeMap::iterator it = _meta_types.begin(); it != _meta_types.end(); ++it) {
+			pending.insert( it->second );
+		}
+
+		for ( std::set< Metatype * >::iterator it = pending.begin(); it != pending.end(); ++it ) {
+			delete *it;
+		}
+		_meta_types.clear();
+		m_typeIndex.clear();
+		m_nameIndex.clear();
+		m_generation.increment();
 	}
 
 	void
@@ -224,14 +316,21 @@ private:
 	{
 		Metatype * ptr_mc;
 
-		if ( _meta_types.count( typeid( T ).name() ) == 0 ) {
+		if ( !findMetatype( typeid( T ) ) ) {
 			ptr_mc = new MetaPointerType( typeid( T* ), *mc);
 		}
 		else {
 			ptr_mc = &metatype< T* >();
+			m_generation.increment();
 		}
 		_meta_types[ typeid( T ).name() ] = mc;
 		_meta_types[ typeid( T* ).name() ] = ptr_mc;
+		m_typeIndex[ typeid( T ) ] = mc;
+		m_typeIndex[ typeid( T* ) ] = ptr_mc;
+		m_nameIndex[ typeid( T ).name() ] = mc;
+		m_nameIndex[ typeid( T* ).name() ] = ptr_mc;
+		m_nameIndex[ typeName< T >() ] = mc;
+		m_nameIndex[ typeName< T* >() ] = ptr_mc;
 		mc->pointerMetatype( ptr_mc );
 		updatePendingProperties( mc );
 		updatePendingProperties( ptr_mc );
@@ -247,23 +346,12 @@ private:
 		m_pendingProperties.erase( ret.first, ret.second );
 	}
 
-	friend AddressRefMap& _addressRefMap();
-
-	AddressRefMap&
-	_addressRefMap() {
-		return m_addressRefs;
-	}
-
-	friend NameRefMap& _nameRefMap();
-
-	NameRefMap&
-	_nameRefMap() {
-		return m_nameRefs;
-	}
-
 	TypeMap						_meta_types;
-	AddressRefMap				m_addressRefs;
-	NameRefMap					m_nameRefs;
+	TypeIndexMap				m_typeIndex;
+	NameIndexMap				m_nameIndex;
+	__Atomic< unsigned >		m_generation;
+	std::vector< CachedMetatype * >	m_cachedMetatypes;
+	__Mutex						m_cacheMutex;
 	std::vector< std::string >	m_prefixDecorators;
 	PendingProps				m_pendingProperties;
 };
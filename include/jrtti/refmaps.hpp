@@ -0,0 +1,283 @@
+#ifndef jrttirefmapsH
+#define jrttirefmapsH
+
+#include <map>
+#include <string>
+#include <vector>
+#include "numconv.hpp"
+
+namespace jrtti {
+
+/**
+ * \brief Ids given to the objects written by a serialization
+ *
+ * Maps object addresses to integer ids with open addressing in a flat
+ * table, so writing a graph of many objects allocates no memory per object.
+ */
+class AddressRefMap {
+public:
+	AddressRefMap()
+		:	m_size( 0 ) {}
+
+	/**
+	 * \brief Retrieves the number of objects in the map
+	 * \return the number of objects
+	 */
+	size_t
+	size() const {
+		return m_size;
+	}
+
+	/**
+	 * \brief Checks if the map is empty
+	 * \return true if there are no objects
+	 */
+	bool
+	empty() const {
+		return !m_size;
+	}
+
+	/**
+	 * \brief Looks for the id of an object
+	 * \param inst the object address
+	 * \param id receives the object id if found
+	 * \return true if the object is in the map
+	 */
+	bool
+	find( const void * inst, size_t& id ) const {
+		if ( !m_size ) {
+			return false;
+		}
+		for ( size_t i = slot( inst ); m_slots[ i ].inst; i = ( i + 1 ) & ( m_slots.size() - 1 ) ) {
+			if ( m_slots[ i ].inst == inst ) {
+				id = m_slots[ i ].id;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * \brief Sets the id of an object, replacing the previous one if any
+	 * \param inst the object address, not NULL
+	 * \param id the object id
+	 */
+	void
+	insert( void * inst, size_t id ) {
+		// keep at most 3/4 of the slots used, so probe sequences stay short
+		if ( ( m_size + 1 ) * 4 > m_slots.size() * 3 ) {
+			grow();
+		}
+		size_t i = slot( inst );
+		while ( m_slots[ i ].inst && m_slots[ i ].inst != inst ) {
+			i = ( i + 1 ) & ( m_slots.size() - 1 );
+		}
+		if ( !m_slots[ i ].inst ) {
+			m_slots[ i ].inst = inst;
+			++m_size;
+		}
+		m_slots[ i ].id = id;
+	}
+
+	/**
+	 * \brief Removes all objects, keeping the memory for reuse
+	 */
+	void
+	clear() {
+		if ( m_size ) {
+			m_slots.assign( m_slots.size(), Slot() );
+			m_size = 0;
+		}
+	}
+
+private:
+	struct Slot {
+		Slot()
+			:	inst( NULL ),
+				id( 0 ) {}
+
+		const void *	inst;
+		size_t			id;
+	};
+
+	// Multiplicative hash of the address, dropping the low bits that alignment leaves at zero
+	size_t
+	slot( const void * inst ) const {
+		size_t hash = size_t( inst ) >> 3;
+		hash ^= hash >> 15;
+		hash *= 2654435761u;
+		hash ^= hash >> 13;
+		return hash & ( m_slots.size() - 1 );
+	}
+
+	void
+	grow() {
+		std::vector< Slot > old( m_slots.empty() ? 16 : m_slots.size() * 2 );
+		old.swap( m_slots );
+		for ( size_t i = 0; i < old.size(); ++i ) {
+			if ( old[ i ].inst ) {
+				size_t j = slot( old[ i ].inst );
+				while ( m_slots[ j ].inst ) {
+					j = ( j + 1 ) & ( m_slots.size() - 1 );
+				}
+				m_slots[ j ] = old[ i ];
+			}
+		}
+	}
+
+	std::vector< Slot >	m_slots;
+	size_t				m_size;
+};
+
+/**
+ * \brief Objects read by a serialization, by id
+ *
+ * Ids written by jrtti are consecutive integers, so objects are kept in a
+ * vector indexed by id, starting at the first id inserted. Other ids, as
+ * ones not being integers or too far for the vector to stay dense, are kept
+ * in a std::map.
+ */
+class NameRefMap {
+public:
+	NameRefMap()
+		:	m_base( 0 ),
+			m_size( 0 ) {}
+
+	/**
+	 * \brief Retrieves the number of objects in the map
+	 * \return the number of objects
+	 */
+	size_t
+	size() const {
+		return m_size + m_named.size();
+	}
+
+	/**
+	 * \brief Checks if the map is empty
+	 * \return true if there are no objects
+	 */
+	bool
+	empty() const {
+		return !size();
+	}
+
+	/**
+	 * \brief Looks for an object
+	 * \param name the object id, as written in $id
+	 * \param length length of name
+	 * \return the object address or NULL if not found
+	 */
+	void *
+	find( const char * name, size_t length ) const {
+		size_t id;
+		if ( denseId( name, length, id ) && id >= m_base && id - m_base < m_objects.size() && m_objects[ id - m_base ] ) {
+			return m_objects[ id - m_base ];
+		}
+		if ( m_named.empty() ) {
+			return NULL;
+		}
+		std::map< std::string, void * >::const_iterator it = m_named.find( std::string( name, length ) );
+		return it != m_named.end() ? it->second : NULL;
+	}
+
+	/**
+	 * \brief Sets the object with an id, replacing the previous one if any
+	 * \param name the object id, as written in $id
+	 * \param length length of name
+	 * \param inst the object address
+	 */
+	void
+	insert( const char * name, size_t length, void * inst ) {
+		size_t id;
+		if ( !denseId( name, length, id ) || !insert( id, inst, 0 ) ) {
+			m_named[ std::string( name, length ) ] = inst;
+		}
+	}
+
+	/**
+	 * \brief Sets the objects of other map, replacing the ones with the same id
+	 * \param other the map to copy
+	 */
+	void
+	insert( const NameRefMap& other ) {
+		// the other map may start at any id, as the one of a chunk read in parallel
+		const size_t room = other.size();
+		for ( size_t index = 0; index < other.m_objects.size(); ++index ) {
+			if ( other.m_objects[ index ] && !insert( other.m_base + index, other.m_objects[ index ], room ) ) {
+				char name[ maxNumberLength ];
+				m_named[ std::string( name, formatNumber( name, other.m_base + index ) ) ] = other.m_objects[ index ];
+			}
+		}
+		size_t id;
+		for ( std::map< std::string, void * >::const_iterator it = other.m_named.begin(); it != other.m_named.end(); ++it ) {
+			if ( !denseId( it->first.data(), it->first.length(), id ) || !insert( id, it->second, room ) ) {
+				m_named[ it->first ] = it->second;
+			}
+		}
+	}
+
+	/**
+	 * \brief Removes all objects, keeping the memory for reuse
+	 */
+	void
+	clear() {
+		m_objects.clear();
+		m_named.clear();
+		m_base = 0;
+		m_size = 0;
+	}
+
+private:
+	// Sets the object in the vector if it stays dense, room being the number of objects about to be
+	// inserted. Returns false if the id should be kept in m_named
+	bool
+	insert( size_t id, void * inst, size_t room ) {
+		if ( !m_size ) {
+			m_objects.clear();
+			m_base = id;
+		}
+		if ( id < m_base || id - m_base >= ( m_objects.size() + room ) * 2 + 1024 ) {
+			return false;
+		}
+		const size_t index = id - m_base;
+		if ( index >= m_objects.size() ) {
+			m_objects.resize( index + 1, NULL );
+		}
+		if ( !m_objects[ index ] ) {
+			++m_size;
+			if ( !m_named.empty() ) {
+				// the id may have been too far before the vector grew
+				char name[ maxNumberLength ];
+				m_named.erase( std::string( name, formatNumber( name, id ) ) );
+			}
+		}
+		m_objects[ index ] = inst;
+		return true;
+	}
+
+	// Parses ids written by jrtti: decimal integers without leading zeros
+	static
+	bool
+	denseId( const char * name, size_t length, size_t& id ) {
+		if ( !length || length > 9 || ( name[ 0 ] == '0' && length > 1 ) ) {
+			return false;
+		}
+		id = 0;
+		for ( size_t i = 0; i < length; ++i ) {
+			if ( name[ i ] < '0' || name[ i ] > '9' ) {
+				return false;
+			}
+			id = id * 10 + ( name[ i ] - '0' );
+		}
+		return true;
+	}
+
+	std::vector< void * >				m_objects;
+	size_t								m_base;
+	size_t								m_size;
+	std::map< std::string, void * >	m_named;
+};
+
+//------------------------------------------------------------------------------
+}; //namespace jrtti
+#endif  //jrttirefmapsH
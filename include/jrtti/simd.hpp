@@ -0,0 +1,66 @@
+#ifndef jrttisimdH
+#define jrttisimdH
+
+/**
+ * Vector instruction sets used by jrtti, detected from the compiler target.
+ * Define JRTTI_NO_SIMD before including jrtti.hpp to use the scalar code only.
+ */
+#if !defined( JRTTI_NO_SIMD ) && ( defined( __GNUC__ ) || defined( _MSC_VER ) )
+	#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+		#define JRTTI_SSE2
+		#include <emmintrin.h>
+	#endif
+	#if defined( JRTTI_SSE2 ) && ( defined( __SSSE3__ ) || defined( __AVX__ ) )
+		#define JRTTI_SSSE3
+		#include <tmmintrin.h>
+	#endif
+	#if defined( JRTTI_SSSE3 ) && defined( __AVX2__ )
+		#define JRTTI_AVX2
+		#include <immintrin.h>
+	#endif
+#endif
+#if defined( _MSC_VER )
+	#include <intrin.h>
+#endif
+#include <stdint.h>
+
+namespace jrtti {
+	struct __simd {
+		/**
+		 * Index of the lowest set bit of a non zero mask, as returned by movemask
+		 */
+		static
+		int
+		firstBit( unsigned mask ) {
+#if defined( __GNUC__ )
+			return __builtin_ctz( mask );
+#elif defined( _MSC_VER )
+			unsigned long index;
+			_BitScanForward( &index, mask );
+			return int( index );
+#else
+			int index = 0;
+			while ( !( mask & 1 ) ) {
+				mask >>= 1;
+				++index;
+			}
+			return index;
+#endif
+		}
+
+		/**
+		 * Index of the lowest set bit of a non zero 64 bit mask
+		 */
+		static
+		int
+		firstBit64( uint64_t mask ) {
+#if defined( __GNUC__ )
+			return __builtin_ctzll( mask );
+#else
+			const unsigned low = unsigned( mask );
+			return low ? firstBit( low ) : 32 + firstBit( unsigned( mask >> 32 ) );
+#endif
+		}
+	};
+}; // namespace jrtti
+#endif //jrttisimdH
@@ -0,0 +1,155 @@
+#ifndef jrttithreadsH
+#define jrttithreadsH
+
+/**
+ * Thread support used by jrtti, detected from the compiler.
+ * JRTTI_HAS_THREADS is defined when std::mutex, std::atomic and thread_local
+ * are available (C++11). Lazily built caches are then guarded, so metatypes
+ * can be used from several threads once declared. Define JRTTI_NO_THREADS
+ * before including jrtti.hpp to disable the guards.
+ * JRTTI_THREAD_LOCAL qualifies thread local variables of POD types. It is
+ * empty if the compiler has no thread local storage.
+ */
+#if !defined( JRTTI_NO_THREADS ) && ( __cplusplus >= 201103L || ( defined( _MSC_VER ) && _MSC_VER >= 1900 ) )
+	#define JRTTI_HAS_THREADS
+	#define JRTTI_THREAD_LOCAL	thread_local
+	#include <mutex>
+	#include <atomic>
+	#include <thread>
+	#include <exception>
+	#include <vector>
+#elif !defined( JRTTI_NO_THREADS ) && defined( __GNUC__ )
+	#define JRTTI_THREAD_LOCAL	__thread
+#elif !defined( JRTTI_NO_THREADS ) && defined( _MSC_VER )
+	#define JRTTI_THREAD_LOCAL	__declspec( thread )
+#else
+	#define JRTTI_THREAD_LOCAL
+#endif
+
+namespace jrtti {
+	// Mutex guarding lazily built caches. Does nothing without JRTTI_HAS_THREADS
+	class __Mutex {
+	public:
+		void
+		lock() {
+#if defined( JRTTI_HAS_THREADS )
+			m_mutex.lock();
+#endif
+		}
+
+		void
+		unlock() {
+#if defined( JRTTI_HAS_THREADS )
+			m_mutex.unlock();
+#endif
+		}
+
+	private:
+#if defined( JRTTI_HAS_THREADS )
+		std::mutex	m_mutex;
+#endif
+	};
+
+	// Scoped lock of a __Mutex
+	class __LockGuard {
+	public:
+		__LockGuard( __Mutex& mutex )
+			:	m_mutex( mutex ) {
+			m_mutex.lock();
+		}
+
+		~__LockGuard() {
+			m_mutex.unlock();
+		}
+
+	private:
+		__LockGuard( const __LockGuard& );
+		__LockGuard& operator = ( const __LockGuard& );
+
+		__Mutex&	m_mutex;
+	};
+
+	// Value published to other threads with acquire/release semantics. A plain value without JRTTI_HAS_THREADS
+	template< typename T >
+	class __Atomic {
+	public:
+		__Atomic( T value = T() )
+			:	m_value( value ) {}
+
+		T
+		load() const {
+#if defined( JRTTI_HAS_THREADS )
+			return m_value.load( std::memory_order_acquire );
+#else
+			return m_value;
+#endif
+		}
+
+		void
+		store( T value ) {
+#if defined( JRTTI_HAS_THREADS )
+			m_value.store( value, std::memory_order_release );
+#else
+			m_value = value;
+#endif
+		}
+
+		// Adds one to an integral value, returning the new value
+		T
+		increment() {
+#if defined( JRTTI_HAS_THREADS )
+			return m_value.fetch_add( 1, std::memory_order_acq_rel ) + 1;
+#else
+			return ++m_value;
+#endif
+		}
+
+	private:
+		__Atomic( const __Atomic& );
+		__Atomic& operator = ( const __Atomic& );
+
+#if defined( JRTTI_HAS_THREADS )
+		std::atomic< T >	m_value;
+#else
+		T					m_value;
+#endif
+	};
+
+#if defined( JRTTI_HAS_THREADS )
+	// Calls task( i ) for every i in [0, count) from up to threads threads, the calling one included.
+	// Rethrows in the calling thread the first exception thrown by a task
+	template< typename TaskT >
+	void
+	__parallelFor( size_t count, unsigned threads, TaskT task ) {
+		std::atomic< size_t > next( 0 );
+		std::exception_ptr error;
+		std::mutex errorMutex;
+		auto worker = [ & ]() {
+			for ( size_t i = next++; i < count; i = next++ ) {
+				try {
+					task( i );
+				}
+				catch ( ... ) {
+					std::lock_guard< std::mutex > lock( errorMutex );
+					if ( !error ) {
+						error = std::current_exception();
+					}
+					next = count;
+				}
+			}
+		};
+		std::vector< std::thread > pool;
+		for ( unsigned i = 1; i < threads && i < count; ++i ) {
+			pool.push_back( std::thread( worker ) );
+		}
+		worker();
+		for ( size_t i = 0; i < pool.size(); ++i ) {
+			pool[ i ].join();
+		}
+		if ( error ) {
+			std::rethrow_exception( error );
+		}
+	}
+#endif
+}; // namespace jrtti
+#endif //jrttithreadsH
@@ -0,0 +1,85 @@
+#ifndef jrttitypenamesH
+#define jrttitypenamesH
+
+#include <string>
+#include <cstring>
+#include <typeinfo>
+
+#if defined( _MSC_VER )
+	#define JRTTI_FUNCTION_SIGNATURE	__FUNCSIG__
+#elif defined( __GNUC__ ) || defined( __clang__ )
+	#define JRTTI_FUNCTION_SIGNATURE	__PRETTY_FUNCTION__
+#endif
+
+namespace jrtti {
+	struct __typeNames {
+		// Extracts the template argument from the signature of typeName< T >. Returns an empty string if not found
+		static
+		std::string
+		extract( const char * signature ) {
+#if defined( _MSC_VER )
+			// ... __cdecl jrtti::typeName<class Sample>(void)
+			const char * first = strstr( signature, "typeName<" );
+			const char * last = strrchr( signature, '>' );
+			if ( !first || !last ) {
+				return std::string();
+			}
+			first += 9;
+			static const char * const decorators[] = { "class ", "struct ", "union ", "enum " };
+			for ( size_t i = 0; i < sizeof( decorators ) / sizeof( decorators[ 0 ] ); ++i ) {
+				const size_t length = strlen( decorators[ i ] );
+				if ( !strncmp( first, decorators[ i ], length ) ) {
+					first += length;
+					break;
+				}
+			}
+			return std::string( first, last );
+#elif defined( JRTTI_FUNCTION_SIGNATURE )
+			// gcc: ... jrtti::typeName() [with T = Sample; std::string = ...]
+			// clang: ... jrtti::typeName() [T = Sample]
+			const char * first = strstr( signature, "T = " );
+			if ( !first ) {
+				return std::string();
+			}
+			first += 4;
+			const char * last = first;
+			int nesting = 0;
+			for ( ; *last && ( nesting || ( *last != ';' && *last != ']' ) ); ++last ) {
+				if ( *last == '[' || *last == '<' || *last == '(' ) {
+					++nesting;
+				}
+				else if ( *last == ']' || *last == '>' || *last == ')' ) {
+					--nesting;
+				}
+			}
+			return std::string( first, last );
+#else
+			return std::string();
+#endif
+		}
+	};
+
+	/**
+	 * \brief Retrieves the readable name of a type
+	 *
+	 * The name is taken from the compiler generated signature of this function,
+	 * without calling a demangler, and is computed once per type. Compilers
+	 * not exposing the function signature use jrtti::demangle instead.
+	 * The name could differ from Metatype::name, as compilers do not write
+	 * default template arguments in function signatures.
+	 * \tparam T the type
+	 * \return the type name
+	 */
+	template< typename T >
+	const std::string&
+	typeName() {
+#if defined( JRTTI_FUNCTION_SIGNATURE )
+		static const std::string extracted = __typeNames::extract( JRTTI_FUNCTION_SIGNATURE );
+#else
+		static const std::string extracted;
+#endif
+		static const std::string name = extracted.empty() ? demangle( typeid( T ).name() ) : extracted;
+		return name;
+	}
+}; // namespace jrtti
+#endif //jrttitypenamesH
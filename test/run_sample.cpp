@@ -1,8 +1,8 @@
-#include "sample.h"
-
-int main() {
-	declare();
-	useCase();
-	std::cin.ignore(1);
-	return 0;
+#include "sample.h"
+
+int main() {
+	declare();
+	useCase();
+	std::cin.ignore(1);
+	return 0;
 }
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include <gtest/gtest.h>
 #include "test_jrtti.h"
 #include "sample.h"
+#ifdef JRTTI_HAS_THREADS
+	#include <atomic>
+	#include <thread>
+#endif
 
 
 using namespace jrtti;
@@ -289,7 +293,7 @@ TEST_F(MetaTypeTest, Serialize) {
 	std::vector< Date >& col = sample.getCollection();
 	for (int i = 0; i < 2; i++) {
 		++date.y;
-		col.push_back( date );
+		col.push_back( date );
 	}
 	for (int i = 0; i< 5; ++i )
 		sample.getArray()[i] = i+10;
@@ -307,7 +311,7 @@ TEST_F(MetaTypeTest, Serialize) {
 	std::ofstream f("test");
 	f << ss;
 	ss.erase( std::remove_if( ss.begin(), ss.end(), ::isspace ), ss.end() );
-	serialized =             "{\"$id\":\"0\",\"circularRef\":{\"$ref\":\"0\"},\"collection\":{\"properties\":{\"$id\":\"1\"},\"elements\":[{\"$id\":\"2\",\"d\":1,\"m\":4,\"place\":{\"$id\":\"3\",\"x\":98,\"y\":93},\"y\":2012},{\"d\":1,\"m\":4,\"place\":{\"x\":98,\"y\":93},\"y\":2013}]},\"date\":{\"d\":1,\"m\":4,\"place\":{\"x\":98,\"y\":93},\"y\":2011},\"intAbstract\":34,\"intOverloaded\":87,\"memoryDump\":\"CgsMDQ4=\",\"point\":{\"$id\":\"4\",\"x\":45,\"y\":80},\"refToDate\":{\"$id\":\"5\",\"d\":1,\"m\":4,\"place\":{\"x\":98,\"y\":93},\"y\":2011},\"testBool\":true,\"testDouble\":65,\"testRO\":23,\"testStr\":\"Hello,\\\"world\\\"!\\nThisisanewlinewithnonprintablechar\\u0011\"}";
+	serialized =             "{\"$id\":\"0\",\"circularRef\":{\"$ref\":\"0\"},\"collection\":{\"properties\":{\"$id\":\"1\"},\"elements\":[{\"d\":1,\"m\":4,\"place\":{\"x\":98,\"y\":93},\"y\":2012},{\"d\":1,\"m\":4,\"place\":{\"x\":98,\"y\":93},\"y\":2013}]},\"date\":{\"d\":1,\"m\":4,\"place\":{\"x\":98,\"y\":93},\"y\":2011},\"intAbstract\":34,\"intOverloaded\":87,\"memoryDump\":\"CgsMDQ4=\",\"point\":{\"$id\":\"2\",\"x\":45,\"y\":80},\"refToDate\":{\"$id\":\"3\",\"d\":1,\"m\":4,\"place\":{\"x\":98,\"y\":93},\"y\":2011},\"testBool\":true,\"testDouble\":65,\"testRO\":23,\"testStr\":\"Hello,\\\"world\\\"!\\nThisisanewlinewithnonprintablechar\\u0011\"}";
 	EXPECT_EQ( serialized, ss );
 	delete point;
 }
@@ -358,6 +362,53 @@ TEST_F(MetaTypeTest, testTypeAnnotation) {
 	EXPECT_EQ( "sample.ico", a->icon() );
 }
 
+struct TestRegisteredAnnotation : public GUIAnnotation {
+};
+
+TEST_F(MetaTypeTest, annotationFlags) {
+	Annotations::registerType< TestRegisteredAnnotation >();
+	StringifyDelegate< Point > * delegate = new StringifyDelegate< Point >( NULL, NULL );
+	// declared first, so it outlives annotations once it takes their ownership
+	Annotations copy;
+	Annotations annotations;
+	annotations << new NoStreamable() << new MenuAnnotation( "menu" ) << delegate << new TestRegisteredAnnotation();
+	EXPECT_EQ( unsigned( Annotations::hasNoStreamable | Annotations::hasStringifyDelegate ), annotations.flags() );
+	EXPECT_EQ( delegate, annotations.stringifyDelegate() );
+	EXPECT_EQ( delegate, annotations.getFirst< StringifyDelegateBase >() );
+	EXPECT_TRUE( annotations.has< TestRegisteredAnnotation >() );
+	// found as a GUIAnnotation too
+	EXPECT_TRUE( annotations.getFirst< GUIAnnotation >() == annotations.getFirst< TestRegisteredAnnotation >() );
+	EXPECT_EQ( "menu", annotations.getFirst< MenuAnnotation >()->submenu() );
+	EXPECT_FALSE( annotations.has< ForceStreamLoadable >() );
+
+	copy = annotations;
+	EXPECT_EQ( annotations.flags(), copy.flags() );
+	EXPECT_EQ( delegate, copy.stringifyDelegate() );
+	EXPECT_TRUE( copy.has< TestRegisteredAnnotation >() );
+	EXPECT_EQ( 0u, Annotations().flags() );
+
+	// only changes of content invalidate serialization plans
+	const unsigned version = Annotations::version();
+	Annotations empty;
+	Annotations copied( empty );
+	empty = Annotations();
+	copied = empty;
+	EXPECT_EQ( version, Annotations::version() );
+	empty << new NoStreamable();
+	EXPECT_NE( version, Annotations::version() );
+}
+
+TEST_F(MetaTypeTest, annotationsAddedAfterUse) {
+	Point p;
+	p.x = 1;
+	p.y = 2;
+	Metatype& mt = metatype< Point >();
+	EXPECT_NE( std::string::npos, mt.toStr( &p, true ).find( "\"x\"" ) );
+	mt[ "x" ].annotations() << new NoStreamable();
+	EXPECT_EQ( std::string::npos, mt.toStr( &p, true ).find( "\"x\"" ) );
+	EXPECT_NE( std::string::npos, mt.toStr( &p, true ).find( "\"y\"" ) );
+}
+
 TEST_F(MetaTypeTest, testMethodAnnotation) {
 	jrtti::Annotations annotations = mClass().method( "testMethod" ).annotations();
 
@@ -396,20 +447,750 @@ TEST_F(MetaTypeTest, base64) {
 	const int length = 0xffff;
 	uint8_t * p = new uint8_t[length];
 
-	srand ( (unsigned int) time(NULL) );
+	srand ( (unsigned int) time(NULL) );
 	for (int i = 0; i < length; ++i) {
 		p[ i ] = rand() % 0xff;
-	}
-
-	std::string encoded = jrtti::Base64::encode( p, length );
-	uint8_t * decoded = jrtti::Base64::decode( encoded );
-	int i = memcmp( p, decoded, length );
-
+	}
+
+	std::string encoded = jrtti::Base64::encode( p, length );
+	uint8_t * decoded = jrtti::Base64::decode( encoded );
+	int i = memcmp( p, decoded, length );
+
 	EXPECT_FALSE(i);
 	delete p;
 	delete decoded;
 }
 
+TEST_F(MetaTypeTest, base64Chunks) {
+	const int length = 1000;
+	uint8_t data[ length ];
+	for (int i = 0; i < length; ++i) {
+		data[ i ] = rand() % 0xff;
+	}
+	std::string encoded = jrtti::Base64::encode( data, length );
+	EXPECT_EQ( jrtti::Base64::encodedSize( length ), encoded.length() );
+	EXPECT_EQ( length, jrtti::Base64::decodedSize( encoded ) );
+
+	jrtti::Base64::Encoder encoder;
+	char text[ 2000 ];
+	size_t textLength = 0;
+	for (int i = 0; i < length; i += 7) {
+		textLength += encoder.update( data + i, std::min( 7, length - i ), text + textLength );
+	}
+	textLength += encoder.finish( text + textLength );
+	EXPECT_EQ( encoded, std::string( text, textLength ) );
+
+	jrtti::Base64::Decoder decoder;
+	uint8_t decoded[ length + 1 ];
+	decoded[ length ] = 0;
+	size_t decodedLength = 0;
+	for (size_t i = 0; i < textLength; i += 5) {
+		decodedLength += decoder.update( text + i, std::min< size_t >( 5, textLength - i ), decoded + decodedLength );
+	}
+	decodedLength += decoder.finish( decoded + decodedLength );
+	EXPECT_EQ( length, decodedLength );
+	EXPECT_FALSE( memcmp( data, decoded, length ) );
+	EXPECT_EQ( 0, decoded[ length ] );
+}
+
+TEST_F(MetaTypeTest, numberFormatting) {
+	EXPECT_EQ( "65", jrtti::numToStr( 65.0 ) );
+	EXPECT_EQ( "0.1", jrtti::numToStr( 0.1f ) );
+	EXPECT_EQ( "-0.0025", jrtti::numToStr( -0.0025 ) );
+	EXPECT_EQ( "1e+20", jrtti::numToStr( 1e20 ) );
+	EXPECT_EQ( "-2147483648", jrtti::numToStr( -2147483647 - 1 ) );
+	EXPECT_EQ( "A", jrtti::numToStr( 'A' ) );
+	EXPECT_EQ( 'A', jrtti::strToNum< char >( " A" ) );
+
+	double third = 1.0 / 3;
+	EXPECT_EQ( third, jrtti::strToNum< double >( jrtti::numToStr( third ) ) );
+
+	// long doubles equal to a double are written shorter only if they read back the same
+	EXPECT_EQ( "0.5", jrtti::numToStr( 0.5L ) );
+	const long double longDoubles[] = { (long double)0.1, 0.1L, 1.0L / 3, (long double)( 1.0 / 3 ), -1e300L, 4e-320L };
+	for ( size_t i = 0; i < sizeof( longDoubles ) / sizeof( longDoubles[ 0 ] ); ++i ) {
+		EXPECT_EQ( longDoubles[ i ], jrtti::strToNum< long double >( jrtti::numToStr( longDoubles[ i ] ) ) );
+	}
+}
+
+TEST_F(MetaTypeTest, numberParsing) {
+	const char * text = "-12.5e1,";
+	double d;
+	EXPECT_EQ( 7, jrtti::parseNumber( text, text + 8, d ) );
+	EXPECT_EQ( -125.0, d );
+	int i;
+	EXPECT_EQ( 3, jrtti::parseNumber( text, text + 8, i ) );
+	EXPECT_EQ( -12, i );
+	const char * overflow = "2147483648";
+	EXPECT_EQ( 0, jrtti::parseNumber( overflow, overflow + 10, i ) );
+
+	EXPECT_EQ( 0.1, jrtti::strToNum< double >( " 0.1" ) );
+	long double ld;
+	const std::string doubleTenth = jrtti::numToStr( (long double)0.1 );
+	EXPECT_EQ( doubleTenth.length(), jrtti::parseNumber( doubleTenth.data(), doubleTenth.data() + doubleTenth.length(), ld ) );
+	EXPECT_EQ( (long double)0.1, ld );
+	EXPECT_EQ( 0, jrtti::strToNum< int >( "abc" ) );
+	EXPECT_THROW( mClass().fromStr( &sample, "{ \"intMember\": abc }" ), jrtti::Error );
+}
+
+TEST_F(MetaTypeTest, stringEscaping) {
+	std::string text = "A long enough text to be scanned in blocks: \"quoted\", a/b, c:\\d,\ttab,\x01 and caf\xC3\xA9";
+	sample.setStdStringProp( text );
+	std::string serialized = mClass().toStr( &sample );
+	EXPECT_NE( std::string::npos, serialized.find( "\\\"quoted\\\", a\\/b, c:\\\\d,\\ttab,\\u0001 and caf\xC3\xA9\"" ) );
+
+	Sample loaded;
+	mClass().fromStr( &loaded, serialized );
+	EXPECT_EQ( text, loaded.getStdStringProp() );
+
+	mClass().fromStr( &loaded, "{ \"testStr\": \"caf\\u00e9 \\ud83d\\ude00\" }" );
+	EXPECT_EQ( "caf\xC3\xA9 \xF0\x9F\x98\x80", loaded.getStdStringProp() );
+	EXPECT_THROW( mClass().fromStr( &loaded, "{ \"testStr\": \"\\u00g9\" }" ), jrtti::Error );
+}
+
+TEST_F(MetaTypeTest, MinifiedSerialization) {
+	std::ifstream fin("test");
+	std::stringstream sss;
+	sss << fin.rdbuf();
+	mClass().fromStr( &sample, sss.str() );
+
+	std::string pretty = mClass().toStr( &sample );
+	std::string minified = mClass().toStr( &sample, false, true );
+
+	EXPECT_EQ( std::string::npos, minified.find( '\n' ) );
+	EXPECT_LT( minified.length(), pretty.length() );
+
+	Sample loaded;
+	mClass().fromStr( &loaded, minified );
+	EXPECT_EQ( pretty, mClass().toStr( &loaded ) );
+	delete sample.getByPtrProp();
+	delete loaded.getByPtrProp();
+}
+
+TEST_F(MetaTypeTest, SerializationContexts) {
+	std::ifstream fin("test");
+	std::stringstream sss;
+	sss << fin.rdbuf();
+	mClass().fromStr( &sample, sss.str() );
+	std::string expected = mClass().toStr( &sample, true );
+
+	SerializationContext outer;
+	{
+		SerializationContext::Scope scope( outer );
+		EXPECT_EQ( &outer, &SerializationContext::current() );
+		EXPECT_EQ( expected, mClass().toStr( &sample, true ) );
+		EXPECT_EQ( &outer, &SerializationContext::current() );
+		EXPECT_TRUE( outer.addressRefs().empty() );
+	}
+	EXPECT_NE( &outer, &SerializationContext::current() );
+
+	SerializationContext shared;
+	EXPECT_EQ( expected, mClass().toStr( &sample, shared, true ) );
+	EXPECT_FALSE( shared.addressRefs().empty() );
+	EXPECT_EQ( std::string::npos, mClass().toStr( &sample, shared, true ).find( "$id" ) );
+
+#ifdef JRTTI_HAS_THREADS
+	std::vector< std::string > results( 4 );
+	std::vector< std::thread > threads;
+	for ( size_t i = 0; i < results.size(); ++i ) {
+		threads.push_back( std::thread( [ this, &results, i ]() {
+			for ( int n = 0; n < 50; ++n ) {
+				results[ i ] = mClass().toStr( &sample, true );
+			}
+		} ) );
+	}
+	for ( size_t i = 0; i < threads.size(); ++i ) {
+		threads[ i ].join();
+		EXPECT_EQ( expected, results[ i ] );
+	}
+#endif
+	delete sample.getByPtrProp();
+}
+
+struct TestShapes {
+	std::vector< Point * > points;
+
+	std::vector< Point * >& getPoints() { return points; }
+};
+
+TEST_F(MetaTypeTest, parallelCollections) {
+	declare< TestShapes >()
+		.collection( "points", &TestShapes::getPoints );
+
+	std::vector< Point > distinct( 200 );
+	std::vector< Point > shared( 7 );
+	TestShapes shapes;
+	for ( size_t i = 0; i < 100; ++i ) {
+		distinct[ i ].x = (double)i;
+		shapes.points.push_back( &distinct[ i ] );
+	}
+	for ( size_t i = 0; i < 100; ++i ) {
+		shapes.points.push_back( &shared[ i % shared.size() ] );
+	}
+	// chunks after the ones written again take the ids following them
+	for ( size_t i = 100; i < distinct.size(); ++i ) {
+		distinct[ i ].x = (double)i;
+		shapes.points.push_back( &distinct[ i ] );
+	}
+	shapes.points.push_back( &distinct[ 0 ] );
+
+	SerializationContext context;
+	context.setThreads( 4 );
+	context.setMinParallelElements( 2 );
+	EXPECT_EQ( metatype< TestShapes >().toStr( &shapes, true ), metatype< TestShapes >().toStr( &shapes, context, true ) );
+	context.clear();
+	EXPECT_EQ( metatype< TestShapes >().toStr( &shapes, false, true ), metatype< TestShapes >().toStr( &shapes, context, false, true ) );
+}
+
+struct TestRawDelegate : public StringifyDelegateBase {
+	// not escaped by the writer
+	virtual std::string toStr( void * ) { return "\"\x01" "0\x01\""; }
+	virtual void fromStr( void *, std::string ) {}
+};
+
+struct TestRawItem {
+	int value;
+};
+
+struct TestRawItems {
+	std::vector< TestRawItem * > items;
+
+	std::vector< TestRawItem * >& getItems() { return items; }
+};
+
+TEST_F(MetaTypeTest, parallelCollectionsRawText) {
+	declare< TestRawItem >()
+		.property( "value", &TestRawItem::value, Annotations() << new TestRawDelegate() );
+	Metatype& mt = declare< TestRawItems >()
+		.collection( "items", &TestRawItems::getItems );
+
+	std::vector< TestRawItem > items( 50 );
+	TestRawItems holder;
+	for ( size_t i = 0; i < items.size(); ++i ) {
+		holder.items.push_back( &items[ i ] );
+	}
+	SerializationContext context;
+	context.setThreads( 4 );
+	context.setMinParallelElements( 2 );
+	const std::string serialized = mt.toStr( &holder, context, true );
+	EXPECT_EQ( mt.toStr( &holder, true ), serialized );
+	EXPECT_NE( std::string::npos, serialized.find( "\"\x01" "0\x01\"" ) );
+}
+
+TEST_F(MetaTypeTest, parallelCollectionsLoad) {
+	Metatype& mt = declare< TestShapes >()
+		.collection( "points", &TestShapes::getPoints, Annotations() << new ForceStreamLoadable() );
+
+	std::vector< Point > distinct( 100 );
+	TestShapes shapes;
+	for ( size_t i = 0; i < distinct.size(); ++i ) {
+		distinct[ i ].x = (double)i;
+		shapes.points.push_back( &distinct[ i ] );
+	}
+	std::string serialized = mt.toStr( &shapes, true );
+
+	SerializationContext context;
+	context.setThreads( 4 );
+	context.setMinParallelElements( 2 );
+	TestShapes loaded;
+	mt.fromStr( &loaded, serialized, context );
+	ASSERT_EQ( distinct.size(), loaded.points.size() );
+	for ( size_t i = 0; i < distinct.size(); ++i ) {
+		EXPECT_EQ( (double)i, loaded.points[ i ]->x );
+	}
+	EXPECT_EQ( serialized, mt.toStr( &loaded, true ) );
+	SerializationContext serialContext;
+	TestShapes serialLoaded;
+	mt.fromStr( &serialLoaded, serialized, serialContext );
+	EXPECT_EQ( serialContext.nameRefs().size(), context.nameRefs().size() );
+
+	// elements referencing other elements are read serially
+	shapes.points.push_back( &distinct[ 0 ] );
+	serialized = mt.toStr( &shapes, true );
+	context.clear();
+	TestShapes shared;
+	mt.fromStr( &shared, serialized, context );
+	ASSERT_EQ( shapes.points.size(), shared.points.size() );
+	EXPECT_EQ( 99.0, shared.points[ 99 ]->x );
+
+	for ( size_t i = 0; i < loaded.points.size(); ++i ) {
+		delete loaded.points[ i ];
+		delete serialLoaded.points[ i ];
+	}
+	for ( size_t i = 0; i < shared.points.size(); ++i ) {
+		delete shared.points[ i ];
+	}
+}
+
+struct TestArenaNode {
+	TestArenaNode() : value( 0 ) { ++alive; }
+	~TestArenaNode() { --alive; }
+
+	int value;
+	std::string name;
+
+	static int alive;
+};
+
+int TestArenaNode::alive = 0;
+
+struct TestArenaGraph {
+	std::vector< TestArenaNode * > nodes;
+	TestArenaNode * first;
+
+	std::vector< TestArenaNode * >& getNodes() { return nodes; }
+};
+
+TEST_F(MetaTypeTest, objectArena) {
+	declare< TestArenaNode >()
+		.property( "value", &TestArenaNode::value )
+		.property( "name", &TestArenaNode::name );
+	Metatype& mt = declare< TestArenaGraph >()
+		.collection( "nodes", &TestArenaGraph::getNodes, Annotations() << new ForceStreamLoadable() )
+		.property( "first", &TestArenaGraph::first );
+
+	std::string json = "{\"first\":{\"value\":-1,\"name\":\"first\"},\"nodes\":{\"elements\":[";
+	for ( int i = 0; i < 50; ++i ) {
+		json += ( i ? ",{\"value\":" : "{\"value\":" ) + numToStr( i ) + ",\"name\":\"a name too long for small strings\"}";
+	}
+	json += "]}}";
+
+	ObjectArena arena( 1024 );
+	SerializationContext context;
+	context.setArena( &arena );
+	for ( int load = 0; load < 3; ++load ) {
+		TestArenaGraph graph;
+		graph.first = NULL;
+		mt.fromStr( &graph, json, context );
+		ASSERT_EQ( 50u, graph.nodes.size() );
+		EXPECT_EQ( 49, graph.nodes.back()->value );
+		EXPECT_EQ( "first", graph.first->name );
+		EXPECT_EQ( 51, TestArenaNode::alive );
+		const size_t capacity = arena.capacity();
+		arena.clear();
+		EXPECT_EQ( 0, TestArenaNode::alive );
+		EXPECT_EQ( capacity, arena.capacity() );
+		context.clear();
+	}
+	arena.release();
+	EXPECT_EQ( 0u, arena.capacity() );
+}
+
+TEST_F(MetaTypeTest, objectPool) {
+	Metatype& mt = declare< TestArenaNode >()
+		.pooled( 16 )
+		.property( "value", &TestArenaNode::value );
+	Metatype& intType = metatype< int >();
+	intType.enablePool();
+#ifdef JRTTI_HAS_THREADS
+	Metatype& pointType = metatype< Point >();
+	pointType.enablePool( 8 );
+#endif
+
+	std::vector< boost::any > nodes;
+	for ( int round = 0; round < 3; ++round ) {
+		for ( int i = 0; i < 100; ++i ) {
+			nodes.push_back( mt.create() );
+			jrtti_cast< TestArenaNode * >( nodes.back() )->value = i;
+		}
+		EXPECT_EQ( 100, TestArenaNode::alive );
+		EXPECT_EQ( 99, jrtti_cast< TestArenaNode * >( nodes.back() )->value );
+		for ( size_t i = 0; i < nodes.size(); ++i ) {
+			mt.destroy( nodes[ i ] );
+		}
+		nodes.clear();
+		EXPECT_EQ( 0, TestArenaNode::alive );
+	}
+	// pools of the same type alive at once keep their own thread lists
+	ObjectPool< TestArenaNode > pool( 16 );
+	for ( int i = 0; i < 1000; ++i ) {
+		TestArenaNode * fromPool = pool.create();
+		boost::any fromMetatype = mt.create();
+		EXPECT_NE( jrtti_cast< TestArenaNode * >( fromMetatype ), fromPool );
+		pool.destroy( fromPool );
+		mt.destroy( fromMetatype );
+	}
+	EXPECT_EQ( 16u, pool.capacity() );
+
+	boost::any value = intType.create();
+	*jrtti_cast< int * >( value ) = 5;
+	intType.destroy( value );
+	EXPECT_THROW( metatype< SampleBase >().destroy( boost::any() ), Error );
+
+	Metatype& doubleType = metatype< double >();
+	doubleType.destroy( doubleType.create() );
+	EXPECT_THROW( doubleType.enablePool(), Error );
+
+#ifdef JRTTI_HAS_THREADS
+	std::vector< std::thread > threads;
+	for ( int t = 0; t < 4; ++t ) {
+		threads.push_back( std::thread( [ &pointType, t ]() {
+			std::vector< boost::any > created;
+			for ( int i = 0; i < 500; ++i ) {
+				created.push_back( pointType.create() );
+				jrtti_cast< Point * >( created.back() )->x = t;
+			}
+			for ( size_t i = 0; i < created.size(); ++i ) {
+				EXPECT_EQ( t, jrtti_cast< Point * >( created[ i ] )->x );
+				pointType.destroy( created[ i ] );
+			}
+		} ) );
+	}
+	for ( size_t t = 0; t < threads.size(); ++t ) {
+		threads[ t ].join();
+	}
+#endif
+}
+
+#ifdef JRTTI_HAS_THREADS
+struct TestPooledNode {
+	int value;
+};
+
+struct TestPooledGraph {
+	std::vector< TestPooledNode * > nodes;
+
+	std::vector< TestPooledNode * >& getNodes() { return nodes; }
+};
+
+struct TestCountedNode {
+	TestCountedNode() { ++alive; }
+	~TestCountedNode() { --alive; }
+
+	int value;
+
+	static std::atomic< int > alive;
+};
+
+std::atomic< int > TestCountedNode::alive( 0 );
+
+struct TestCountedGraph {
+	std::vector< TestCountedNode * > nodes;
+
+	std::vector< TestCountedNode * >& getNodes() { return nodes; }
+};
+
+TEST_F(MetaTypeTest, parallelLoadErrors) {
+	declare< TestCountedNode >()
+		.property( "value", &TestCountedNode::value );
+	Metatype& mt = declare< TestCountedGraph >()
+		.collection( "nodes", &TestCountedGraph::getNodes, Annotations() << new ForceStreamLoadable() );
+
+	std::string json = "{\"nodes\":{\"elements\":[";
+	for ( int i = 0; i < 200; ++i ) {
+		json += "{\"value\":" + numToStr( i ) + "},";
+	}
+	json += "{\"value\":\"x\"}]}}";
+
+	// the elements read before the error are destroyed
+	SerializationContext context;
+	context.setThreads( 4 );
+	context.setMinParallelElements( 2 );
+	TestCountedGraph graph;
+	EXPECT_THROW( mt.fromStr( &graph, json, context ), Error );
+	EXPECT_TRUE( graph.nodes.empty() );
+	EXPECT_EQ( 0, TestCountedNode::alive );
+}
+
+TEST_F(MetaTypeTest, objectPoolParallelLoads) {
+	CustomMetaclass< TestPooledNode >& nodeType = declare< TestPooledNode >()
+		.pooled( 8 )
+		.property( "value", &TestPooledNode::value );
+	Metatype& mt = declare< TestPooledGraph >()
+		.collection( "nodes", &TestPooledGraph::getNodes, Annotations() << new ForceStreamLoadable() );
+
+	std::string json = "{\"nodes\":{\"elements\":[";
+	for ( int i = 0; i < 2000; ++i ) {
+		json += ( i ? ",{\"value\":" : "{\"value\":" ) + numToStr( i ) + "}";
+	}
+	json += "]}}";
+
+	// the lists of the threads reading the elements return to the pool when they exit
+	size_t capacity = 0;
+	for ( int round = 0; round < 20; ++round ) {
+		SerializationContext context;
+		context.setThreads( 4 );
+		context.setMinParallelElements( 2 );
+		TestPooledGraph graph;
+		mt.fromStr( &graph, json, context );
+		ASSERT_EQ( 2000u, graph.nodes.size() );
+		for ( size_t i = 0; i < graph.nodes.size(); ++i ) {
+			nodeType.destroy( graph.nodes[ i ] );
+		}
+		if ( !round ) {
+			capacity = nodeType.pool()->capacity();
+		}
+	}
+	EXPECT_LE( nodeType.pool()->capacity(), capacity + 4 * 2 * 8 );
+
+	// threads exiting with objects left in their lists, whatever the scheduling
+	capacity = nodeType.pool()->capacity();
+	for ( int round = 0; round < 100; ++round ) {
+		std::vector< boost::any > created( 4 );
+		std::vector< std::thread > threads;
+		for ( size_t t = 0; t < created.size(); ++t ) {
+			threads.push_back( std::thread( [ &nodeType, &created, t ]() {
+				created[ t ] = nodeType.create();
+			} ) );
+		}
+		for ( size_t t = 0; t < threads.size(); ++t ) {
+			threads[ t ].join();
+			nodeType.destroy( created[ t ] );
+		}
+	}
+	EXPECT_LE( nodeType.pool()->capacity(), capacity + 4 * 2 * 8 );
+}
+#endif
+
+TEST_F(MetaTypeTest, refMaps) {
+	std::vector< int > objects( 5000 );
+	AddressRefMap ids;
+	size_t id;
+	for ( size_t i = 0; i < objects.size(); ++i ) {
+		ids.insert( &objects[ i ], i );
+	}
+	ids.insert( &objects[ 7 ], 70 );
+	EXPECT_EQ( objects.size(), ids.size() );
+	ASSERT_TRUE( ids.find( &objects[ 4999 ], id ) );
+	EXPECT_EQ( 4999u, id );
+	ASSERT_TRUE( ids.find( &objects[ 7 ], id ) );
+	EXPECT_EQ( 70u, id );
+	EXPECT_FALSE( ids.find( &objects[ 0 ] + objects.size(), id ) );
+	ids.clear();
+	EXPECT_TRUE( ids.empty() );
+	EXPECT_FALSE( ids.find( &objects[ 0 ], id ) );
+
+	NameRefMap objs;
+	objs.insert( "0", 1, &objects[ 0 ] );
+	objs.insert( "12", 2, &objects[ 12 ] );
+	objs.insert( "first", 5, &objects[ 1 ] );
+	objs.insert( "012", 3, &objects[ 2 ] );
+	objs.insert( "999999999", 9, &objects[ 3 ] );
+	EXPECT_EQ( 5u, objs.size() );
+	EXPECT_EQ( &objects[ 12 ], objs.find( "12", 2 ) );
+	EXPECT_EQ( &objects[ 1 ], objs.find( "first", 5 ) );
+	EXPECT_EQ( &objects[ 2 ], objs.find( "012", 3 ) );
+	EXPECT_EQ( &objects[ 3 ], objs.find( "999999999", 9 ) );
+	EXPECT_TRUE( objs.find( "5", 1 ) == NULL );
+
+	// an id too far when first inserted is counted once when the vector reaches it
+	NameRefMap grown;
+	grown.insert( "0", 1, &objects[ 0 ] );
+	grown.insert( "2000", 4, &objects[ 2000 ] );
+	for ( size_t i = 1; i <= 2000; ++i ) {
+		const std::string name = numToStr( i );
+		grown.insert( name.data(), name.length(), &objects[ i ] );
+	}
+	EXPECT_EQ( 2001u, grown.size() );
+	EXPECT_EQ( &objects[ 2000 ], grown.find( "2000", 4 ) );
+
+	// maps of chunks read in parallel start at any id
+	NameRefMap merged;
+	for ( size_t chunk = 0; chunk < 5; ++chunk ) {
+		NameRefMap part;
+		for ( size_t i = chunk * 1000; i < chunk * 1000 + 1000; ++i ) {
+			const std::string name = numToStr( i );
+			part.insert( name.data(), name.length(), &objects[ i ] );
+		}
+		part.insert( "first", 5, &objects[ chunk ] );
+		merged.insert( part );
+	}
+	EXPECT_EQ( 5001u, merged.size() );
+	EXPECT_EQ( &objects[ 4999 ], merged.find( "4999", 4 ) );
+	EXPECT_EQ( &objects[ 4 ], merged.find( "first", 5 ) );
+
+	// ids not written by jrtti are still resolved
+	Rect rect;
+	rect.tl = rect.br = NULL;
+	SerializationContext context;
+	metatype< Rect >().fromStr( &rect, "{\"tl\":{\"$id\":\"corner\",\"x\":1,\"y\":2},\"bl\":{\"$ref\":\"corner\"}}", context );
+	EXPECT_TRUE( rect.tl != NULL );
+	EXPECT_EQ( rect.tl, rect.br );
+	EXPECT_EQ( (void *)rect.tl, context.nameRefs().find( "corner", 6 ) );
+	delete rect.tl;
+}
+
+TEST_F(MetaTypeTest, BinaryRoundTrip) {
+	std::ifstream fin("test");
+	std::stringstream sss;
+	sss << fin.rdbuf();
+	std::string serialized = sss.str();
+	mClass().fromStr( &sample, serialized );
+
+	std::string binary = mClass().toBinary( &sample );
+	EXPECT_LT( binary.length() * 2, serialized.length() );
+
+	Sample loaded;
+	loaded.circularRef = NULL;
+	loaded.getArray()[0] = 0;
+	mClass().fromBinary( &loaded, binary );
+
+	EXPECT_EQ( serialized, mClass().toStr( &loaded, true ) );
+	EXPECT_TRUE( &loaded == loaded.circularRef );
+	EXPECT_THROW( mClass().fromBinary( &loaded, binary.substr( 0, binary.length() / 2 ) ), jrtti::Error );
+	delete sample.getByPtrProp();
+	delete loaded.getByPtrProp();
+}
+
+struct TestPolyShape {
+	TestPolyShape() : x( 0 ) {}
+	virtual ~TestPolyShape() {}
+	virtual std::string typeName() { return metatype< TestPolyShape >().name(); }
+	int x;
+};
+
+struct TestPolyCircle : public TestPolyShape {
+	TestPolyCircle() : radius( 0 ) {}
+	virtual std::string typeName() { return metatype< TestPolyCircle >().name(); }
+	int radius;
+};
+
+struct TestPolyDrawing {
+	TestPolyDrawing() : tail( 0 ) {}
+	~TestPolyDrawing() {
+		for ( size_t i = 0; i < shapes.size(); ++i ) {
+			delete shapes[ i ];
+		}
+	}
+	std::vector< TestPolyShape * > shapes;
+	int tail;
+	std::vector< TestPolyShape * >& getShapes() { return shapes; }
+};
+
+TEST_F(MetaTypeTest, BinarySkipsPolymorphicCollections) {
+	declare< TestPolyShape >()
+		.property( "__typeInfoName", &TestPolyShape::typeName )
+		.property( "x", &TestPolyShape::x );
+	declare< TestPolyCircle >()
+		.derivesFrom< TestPolyShape >()
+		.property( "radius", &TestPolyCircle::radius );
+	// read only collection, skipped when loading
+	Metatype& mt = declare< TestPolyDrawing >()
+		.collection( "shapes", &TestPolyDrawing::getShapes )
+		.property( "tail", &TestPolyDrawing::tail );
+
+	TestPolyDrawing drawing;
+	drawing.shapes.push_back( new TestPolyCircle() );
+	drawing.shapes.push_back( new TestPolyShape() );
+	drawing.shapes.push_back( new TestPolyCircle() );
+	drawing.tail = 42;
+	const std::string binary = mt.toBinary( &drawing );
+
+	TestPolyDrawing loaded;
+	mt.fromBinary( &loaded, binary );
+	EXPECT_TRUE( loaded.shapes.empty() );
+	EXPECT_EQ( 42, loaded.tail );
+}
+
+struct TestBinaryValues {
+	TestBinaryValues() : i( 0 ), ld( 0 ) {}
+	int i;
+	long double ld;
+	std::string s;
+};
+
+TEST_F(MetaTypeTest, BinaryRejectsMalformedData) {
+	Metatype& mt = declare< TestBinaryValues >()
+		.property( "i", &TestBinaryValues::i )
+		.property( "ld", &TestBinaryValues::ld )
+		.property( "s", &TestBinaryValues::s );
+
+	TestBinaryValues values;
+	values.i = -7;
+	values.ld = 0.1L;
+	values.s = "text";
+	const std::string binary = mt.toBinary( &values );
+	TestBinaryValues loaded;
+	mt.fromBinary( &loaded, binary );
+	EXPECT_EQ( values.ld, loaded.ld );
+	for ( size_t length = 0; length < binary.length(); ++length ) {
+		EXPECT_THROW( mt.fromBinary( &loaded, binary.substr( 0, length ) ), Error );
+	}
+
+	const std::string header( BinaryWriter::signature(), BinaryWriter::signatureLength() );
+	// unknown member holding a long double longer than the data
+	EXPECT_THROW( mt.fromBinary( &loaded, header + "\x08\x0dunknown\x06\xc8" ), Error );
+	// long double of a size not native to this platform
+	std::string foreign = header + "\x08\x05ld\x06\x03" + std::string( 3, '\0' ) + std::string( 1, '\0' );
+	EXPECT_THROW( mt.fromBinary( &loaded, foreign ), Error );
+	EXPECT_THROW( mt.fromBinary( &loaded, header + "\x08\x05ld\x7f" ), Error );
+}
+
+TEST_F(MetaTypeTest, DeserializeSkipsUnknownMembers) {
+	std::string serialized = "{ \"unknown\": { \"a\": [ 1, { \"b\": \"}]\\\"\" } ] }, \"intMember\": 5,\n"
+							 "\"date\": { \"d\": 3, \"m\": 2, \"y\": 2000, \"place\": { \"x\": 1.5, \"y\": -2 } } }";
+	mClass().fromStr( &sample, serialized );
+
+	EXPECT_EQ( 5, sample.intMember );
+	EXPECT_EQ( 2000, sample.getByValProp().y );
+	EXPECT_EQ( -2, sample.getByValProp().place.y );
+
+	// large unknown members, the later ones skipped through the index
+	std::string large = "[ { \"s\": \"]}\" }";
+	for ( int i = 0; i < 20000; ++i ) {
+		large += ", [ 1 ]";
+	}
+	large += " ]";
+	serialized = "{ \"u1\": " + large + ", \"u2\": " + large + ", \"intMember\": 7, \"u3\": { \"a\": " + large + " },\n"
+				 "\"date\": { \"d\": 3, \"m\": 2, \"y\": 2001, \"place\": { \"x\": 1.5, \"y\": -3 } }, \"u4\": " + large + " }";
+	mClass().fromStr( &sample, serialized );
+
+	EXPECT_EQ( 7, sample.intMember );
+	EXPECT_EQ( 2001, sample.getByValProp().y );
+	EXPECT_EQ( -3, sample.getByValProp().place.y );
+
+	EXPECT_THROW( mClass().fromStr( &sample, "{ \"intMember\": 5, \"date\": { \"d\": 3 " ), jrtti::Error );
+}
+
+TEST_F(MetaTypeTest, JSONSpanParser) {
+	std::string json = "{ \"z\": 1, \"a\": { \"b\": [ 2, 3 ] }, \"s\": \"x\\\"y\" }";
+	jrtti::JSONSpanParser parser( json );
+	jrtti::JSONSpanParser::Member member;
+
+	ASSERT_TRUE( parser.next( member ) );
+	EXPECT_TRUE( parser.equals( member.key, "z" ) );
+	EXPECT_EQ( "1", parser.str( member.value ) );
+	ASSERT_TRUE( parser.next( member ) );
+	EXPECT_TRUE( parser.equals( member.key, "a" ) );
+	EXPECT_EQ( "{ \"b\": [ 2, 3 ] }", parser.str( member.value ) );
+	ASSERT_TRUE( parser.next( member ) );
+	EXPECT_EQ( "x\\\"y", parser.str( member.value ) );
+	EXPECT_EQ( json.find( "x\\\"y" ), member.value.offset );
+	EXPECT_FALSE( parser.next( member ) );
+}
+
+TEST_F(MetaTypeTest, JSONIndex) {
+	std::string json = "{ \"a\": [ \"]}\\\\\", { \"b\": \"x\\\"{\" } ], \"padding to cross the first block of 64 characters\": [ [], {} ], \"c\": 1 }";
+	jrtti::JSONIndex index( json.data(), json.length() );
+	ASSERT_TRUE( index.valid() );
+	EXPECT_EQ( 12u, index.size() );
+
+	size_t hint = 0;
+	size_t closing;
+	ASSERT_TRUE( index.closing( json.find( '[' ), hint, closing ) );
+	EXPECT_EQ( json.find( " ], \"padding" ) + 1, closing );
+	ASSERT_TRUE( index.closing( 0, hint, closing ) );
+	EXPECT_EQ( json.length() - 1, closing );
+	ASSERT_TRUE( index.closing( json.find( "{}" ), hint, closing ) );
+	EXPECT_EQ( json.find( "{}" ) + 1, closing );
+	EXPECT_FALSE( index.closing( json.find( "]}" ), hint, closing ) );
+
+	EXPECT_FALSE( jrtti::JSONIndex( "{ [ }", 5 ).valid() );
+	EXPECT_FALSE( jrtti::JSONIndex( "{ \"} }", 6 ).valid() );
+
+	jrtti::JSONReader reader( json );
+	reader.beginObject();
+	JSONSpan key;
+	ASSERT_TRUE( reader.nextMember( key ) );
+	reader.skipValue();
+	ASSERT_TRUE( reader.nextMember( key ) );
+	EXPECT_TRUE( reader.equals( key, "padding to cross the first block of 64 characters" ) );
+	reader.skipValue();
+	ASSERT_TRUE( reader.nextMember( key ) );
+	EXPECT_EQ( 1, reader.number< int >() );
+	EXPECT_FALSE( reader.nextMember( key ) );
+}
+
 TEST_F(MetaTypeTest, testCollectionInterface) {
 	MyCollection col;
 	col.intMember = 153;
@@ -456,92 +1237,348 @@ TEST_F(MetaTypeTest, testMetaobject) {
 //	std::cout << mo.toStr() << std::endl;
 }
 
-TEST_F(MetaTypeTest, comparationOperators) {
-	Metatype &mt_sample = jrtti::metatype<Sample>();
-	Metatype &mt_date = jrtti::metatype<Date>();
-	Metatype &mt_point = jrtti::metatype<Point>();
-
-	EXPECT_TRUE( ( mt_date == mt_sample["date"].metatype() ) );
-	EXPECT_TRUE( ( mt_date == mt_sample["refToDate"].metatype() ) );
-	EXPECT_TRUE( ( mt_point != mt_sample["point"].metatype() ) );
-}
-
-TEST_F(MetaTypeTest, parentCheck) {
-	Metatype &mt_sample = jrtti::metatype<Sample>();
-	Metatype &mt_date = jrtti::metatype<Date>();
-
-	EXPECT_FALSE( mt_date.isDerivedFrom( mt_sample ) );
-	EXPECT_TRUE( jrtti::metatype< SampleDerived >().isDerivedFrom( mt_sample ) );
-	EXPECT_TRUE( jrtti::metatype< SampleDerived >().isDerivedFrom< SampleBase >() );
-
-	Metatype &mtp_sample = jrtti::metatype<Sample *>();
-	Metatype &mtp_date = jrtti::metatype<Date*>();
-
-	EXPECT_FALSE( mtp_date.isDerivedFrom( mtp_sample ) );
-	EXPECT_TRUE( jrtti::metatype< SampleDerived * >().isDerivedFrom( mtp_sample ) );
-	EXPECT_TRUE( jrtti::metatype< SampleDerived *>().isDerivedFrom< SampleBase * >() );
-}
-
-TEST_F(MetaTypeTest, queryTypeAttributes) {
-// isAbstract
-	EXPECT_FALSE( jrtti::metatype<Date>().isAbstract() );
-	EXPECT_TRUE( jrtti::metatype<SampleBase>().isAbstract() );
-
-	EXPECT_FALSE( jrtti::metatype<Date *>().isAbstract() );
-	EXPECT_TRUE( jrtti::metatype<SampleBase *>().isAbstract() );
-
-// isCollection
+TEST_F(MetaTypeTest, propertyPath) {
+	Point p;
+	p.x = 3;
+	Rect r;
+	r.tl = &p;
+	r.br = NULL;
+
+	PropertyPath tlx( metatype< Rect >(), "tl.x" );
+	EXPECT_EQ( 2u, tlx.size() );
+	EXPECT_EQ( &metatype< Point >()[ "x" ], &tlx.leaf() );
+	EXPECT_EQ( 3, metatype< Rect >().eval< double >( &r, tlx ) );
+	metatype< Rect >().apply( &r, tlx, 4.0 );
+	EXPECT_EQ( 4, p.x );
+	EXPECT_THROW( metatype< Rect >().eval( &r, PropertyPath( metatype< Rect >(), "bl.x" ) ), NullPtrError );
+	EXPECT_THROW( PropertyPath( metatype< Rect >(), "tl.z" ), Error );
+
+	Sample sample;
+	Metaobject mo( mClass(), &sample );
+	PropertyPath placeX( mClass(), "date.place.x" );
+	PropertyPath refDay( mClass(), "refToDate.d" );
+	mo.set( placeX, 5.5 );
+	mo.set( refDay, 7 );
+	EXPECT_EQ( 5.5, sample.getByValProp().place.x );
+	EXPECT_EQ( 5.5, mo.get< double >( placeX ) );
+	EXPECT_EQ( 7, sample.getByRefProp().d );
+	EXPECT_EQ( 7, boost::any_cast< int >( mo.get( refDay ) ) );
+}
+
+TEST_F(MetaTypeTest, metatypeCache) {
+	Metatype * cached = &metatype< Sample >();
+	EXPECT_EQ( cached, &metatype< Sample >() );
+	EXPECT_EQ( cached, &metatype( typeid( Sample ) ) );
+	EXPECT_EQ( cached, &Reflector::instance().metatype( typeid( Sample ).name() ) );
+
+	Reflector::instance().clear();
+	EXPECT_THROW( metatype< Sample >(), Error );
+	declare();
+	EXPECT_EQ( &metatype( typeid( Sample ) ), &metatype< Sample >() );
+	EXPECT_TRUE( metatype< Sample * >().isPointer() );
+
+#ifdef JRTTI_HAS_THREADS
+	// the first lookups after a clear race to fill the cache
+	Reflector::instance().clear();
+	declare();
+	Metatype * expected = &metatype( typeid( Point ) );
+	std::vector< std::thread > threads;
+	for ( int t = 0; t < 4; ++t ) {
+		threads.push_back( std::thread( [ expected ]() {
+			for ( int i = 0; i < 1000; ++i ) {
+				EXPECT_EQ( expected, &metatype< Point >() );
+			}
+		} ) );
+	}
+	for ( size_t t = 0; t < threads.size(); ++t ) {
+		threads[ t ].join();
+	}
+#endif
+}
+
+TEST_F(MetaTypeTest, typeNames) {
+	EXPECT_EQ( "Sample", typeName< Sample >() );
+	EXPECT_EQ( "Point*", typeName< Point * >() );
+	EXPECT_EQ( "int", typeName< int >() );
+	EXPECT_EQ( &typeName< Sample >(), &typeName< Sample >() );
+
+	EXPECT_EQ( &mClass(), &Reflector::instance().metatype( "Sample" ) );
+	EXPECT_EQ( &metatype< Point * >(), &Reflector::instance().metatype( typeName< Point * >() ) );
+	EXPECT_EQ( &metatype< std::string >(), &Reflector::instance().metatype( typeName< std::string >() ) );
+	EXPECT_THROW( Reflector::instance().metatype( "Undeclared" ), Error );
+
+	EXPECT_EQ( "Sample", mClass().name() );
+	EXPECT_EQ( &mClass().name(), &mClass().name() );
+}
+
+TEST_F(MetaTypeTest, comparationOperators) {
+	Metatype &mt_sample = jrtti::metatype<Sample>();
+	Metatype &mt_date = jrtti::metatype<Date>();
+	Metatype &mt_point = jrtti::metatype<Point>();
+
+	EXPECT_TRUE( ( mt_date == mt_sample["date"].metatype() ) );
+	EXPECT_TRUE( ( mt_date == mt_sample["refToDate"].metatype() ) );
+	EXPECT_TRUE( ( mt_point != mt_sample["point"].metatype() ) );
+}
+
+TEST_F(MetaTypeTest, parentCheck) {
+	Metatype &mt_sample = jrtti::metatype<Sample>();
+	Metatype &mt_date = jrtti::metatype<Date>();
+
+	EXPECT_FALSE( mt_date.isDerivedFrom( mt_sample ) );
+	EXPECT_TRUE( jrtti::metatype< SampleDerived >().isDerivedFrom( mt_sample ) );
+	EXPECT_TRUE( jrtti::metatype< SampleDerived >().isDerivedFrom< SampleBase >() );
+
+	Metatype &mtp_sample = jrtti::metatype<Sample *>();
+	Metatype &mtp_date = jrtti::metatype<Date*>();
+
+	EXPECT_FALSE( mtp_date.isDerivedFrom( mtp_sample ) );
+	EXPECT_TRUE( jrtti::metatype< SampleDerived * >().isDerivedFrom( mtp_sample ) );
+	EXPECT_TRUE( jrtti::metatype< SampleDerived *>().isDerivedFrom< SampleBase * >() );
+}
+
+TEST_F(MetaTypeTest, queryTypeAttributes) {
+// isAbstract
+	EXPECT_FALSE( jrtti::metatype<Date>().isAbstract() );
+	EXPECT_TRUE( jrtti::metatype<SampleBase>().isAbstract() );
+
+	EXPECT_FALSE( jrtti::metatype<Date *>().isAbstract() );
+	EXPECT_TRUE( jrtti::metatype<SampleBase *>().isAbstract() );
+
+// isCollection
 	jrtti::declareCollection< MyCollection >()
 		.property( "intMember", &MyCollection::intMember );
-
-	EXPECT_FALSE( jrtti::metatype<Sample>().isCollection() );
-	EXPECT_TRUE( jrtti::metatype< MyCollection >().isCollection() );
-
-	EXPECT_FALSE( jrtti::metatype<Sample *>().isCollection() );
-	EXPECT_TRUE( jrtti::metatype< MyCollection *>().isCollection() );
-
-}
-
-struct TestUntyped {
-	int i;
-	void * ptr;
-};
-
-TEST_F(MetaTypeTest, untypedProperty) {
-	TestUntyped testUntyped;
-
-	Metatype& mt = declare< TestUntyped >();
-	UntypedProperty< TestUntyped > * prop = new UntypedProperty< TestUntyped >( metatype< Point * >(), "untyped" );
-	prop->member( &TestUntyped::ptr );
-	mt.addProperty( "untyped", prop ); 
-
-	Point p;
-	p.x = 2;
-	p.y = 3;
-
-	mt[ "untyped" ].set( &testUntyped, &p );
-
-	std::string s = mt.toStr( &testUntyped );
+
+	EXPECT_FALSE( jrtti::metatype<Sample>().isCollection() );
+	EXPECT_TRUE( jrtti::metatype< MyCollection >().isCollection() );
+
+	EXPECT_FALSE( jrtti::metatype<Sample *>().isCollection() );
+	EXPECT_TRUE( jrtti::metatype< MyCollection *>().isCollection() );
+
+}
+
+struct TestUntyped {
+	int i;
+	void * ptr;
+};
+
+TEST_F(MetaTypeTest, untypedProperty) {
+	TestUntyped testUntyped;
+
+	Metatype& mt = declare< TestUntyped >();
+	UntypedProperty< TestUntyped > * prop = new UntypedProperty< TestUntyped >( metatype< Point * >(), "untyped" );
+	prop->member( &TestUntyped::ptr );
+	mt.addProperty( "untyped", prop ); 
+
+	Point p;
+	p.x = 2;
+	p.y = 3;
+
+	mt[ "untyped" ].set( &testUntyped, &p );
+
+	std::string s = mt.toStr( &testUntyped );
 	s.erase( std::remove_if( s.begin(), s.end(), ::isspace ), s.end() );
-	EXPECT_EQ( s, "{\"untyped\":{\"x\":2,\"y\":3}}" );
-
-	s = mt[ "untyped" ].metatype().toStr( testUntyped.ptr ); 
+	EXPECT_EQ( s, "{\"untyped\":{\"x\":2,\"y\":3}}" );
+
+	s = mt[ "untyped" ].metatype().toStr( testUntyped.ptr ); 
 	s.erase( std::remove_if( s.begin(), s.end(), ::isspace ), s.end() );
-	EXPECT_EQ( s, "{\"x\":2,\"y\":3}" );
-	
-	Point p1 = jrtti_cast< Point >( mt[ "untyped" ].get( &testUntyped ) );
-
-	Sample sample;
-	mClass()[ "point" ].set( &sample, mt[ "untyped" ].get( &testUntyped ) );
-	EXPECT_EQ( sample.getByPtrProp()->y, 3 );
-
-	mClass().apply( &sample, "date.place", mt[ "untyped" ].get( &testUntyped ) );
-	EXPECT_EQ( sample.getByRefProp().place.y, 3 );
-}
-
-TEST_F(MetaTypeTest, checkUseCase) {
-	useCase();
-}
+	EXPECT_EQ( s, "{\"x\":2,\"y\":3}" );
+	
+	Point p1 = jrtti_cast< Point >( mt[ "untyped" ].get( &testUntyped ) );
+
+	Sample sample;
+	mClass()[ "point" ].set( &sample, mt[ "untyped" ].get( &testUntyped ) );
+	EXPECT_EQ( sample.getByPtrProp()->y, 3 );
+
+	mClass().apply( &sample, "date.place", mt[ "untyped" ].get( &testUntyped ) );
+	EXPECT_EQ( sample.getByRefProp().place.y, 3 );
+}
+
+struct TestPlan {
+	int first;
+	int second;
+};
+
+TEST_F(MetaTypeTest, serializationPlanFollowsProperties) {
+	TestPlan testPlan;
+	testPlan.first = 1;
+	testPlan.second = 2;
+
+	CustomMetaclass< TestPlan >& mt = declare< TestPlan >();
+	mt.property( "first", &TestPlan::first );
+	EXPECT_EQ( "{\"first\":1}", mt.toStr( &testPlan, false, true ) );
+
+	mt.property( "second", &TestPlan::second );
+	EXPECT_EQ( "{\"first\":1,\"second\":2}", mt.toStr( &testPlan, false, true ) );
+
+	mt.deleteProperty( "first" );
+	EXPECT_EQ( "{\"second\":2}", mt.toStr( &testPlan, false, true ) );
+
+	mt.fromStr( &testPlan, "{\"first\":5,\"second\":6}" );
+	EXPECT_EQ( 1, testPlan.first );
+	EXPECT_EQ( 6, testPlan.second );
+}
+
+struct TestMembers {
+	bool		b;
+	char		c;
+	short		s;
+	int			i;
+	long		l;
+	float		f;
+	double		d;
+	long double	ld;
+	wchar_t		w;
+	std::string	str;
+};
+
+struct TestCharAccessor {
+	char c;
+
+	char getC() { return c; }
+	void setC( char value ) { c = value; }
+};
+
+TEST_F(MetaTypeTest, dataMemberProperties) {
+	CustomMetaclass< TestMembers >& mt = declare< TestMembers >()
+		.property( "b", &TestMembers::b )
+		.property( "c", &TestMembers::c )
+		.property( "s", &TestMembers::s )
+		.property( "i", &TestMembers::i )
+		.property( "l", &TestMembers::l )
+		.property( "f", &TestMembers::f )
+		.property( "d", &TestMembers::d )
+		.property( "ld", &TestMembers::ld )
+		.property( "w", &TestMembers::w )
+		.property( "str", &TestMembers::str );
+	EXPECT_EQ( Property::memberLongDouble, mt[ "ld" ].memberKind() );
+	EXPECT_EQ( Property::memberString, mt[ "str" ].memberKind() );
+
+	TestMembers members;
+	members.b = true;
+	members.c = 'c';
+	members.s = -3;
+	members.i = 4;
+	members.l = 5;
+	members.f = 6.5f;
+	members.d = 0.1;
+	members.ld = 8.25;
+	members.w = L'w';
+	members.str = "nine";
+
+	std::string json = mt.toStr( &members, false, true );
+	EXPECT_EQ( "{\"b\":true,\"c\":c,\"d\":0.1,\"f\":6.5,\"i\":4,\"l\":5,\"ld\":8.25,\"s\":-3,\"str\":\"nine\",\"w\":119}", json );
+
+	TestMembers loaded;
+	mt.fromStr( &loaded, json );
+	EXPECT_EQ( json, mt.toStr( &loaded, false, true ) );
+
+	TestMembers binaryLoaded;
+	mt.fromBinary( &binaryLoaded, mt.toBinary( &members ) );
+	EXPECT_EQ( json, mt.toStr( &binaryLoaded, false, true ) );
+
+	// characters are written as themselves, as in documents written by older versions
+	Metatype& accessors = declare< TestCharAccessor >()
+		.property( "c", &TestCharAccessor::setC, &TestCharAccessor::getC );
+	TestCharAccessor accessor;
+	accessors.fromStr( &accessor, "{\"c\":x}" );
+	EXPECT_EQ( 'x', accessor.c );
+	EXPECT_EQ( "{\"c\":x}", accessors.toStr( &accessor, false, true ) );
+
+	EXPECT_EQ( 4, mt.eval< int >( &members, "i" ) );
+	EXPECT_EQ( "nine", mt.eval< std::string >( &members, "str" ) );
+	mt.apply( &members, "d", 2.5 );
+	mt[ "str" ].set( &members, std::string( "ten" ) );
+	EXPECT_EQ( 2.5, members.d );
+	EXPECT_EQ( "ten", boost::any_cast< std::string >( mt[ "str" ].get( &members ) ) );
+}
+
+struct TestByValue {
+	std::vector< int > values;
+	Point point;
+
+	std::vector< int > getValues() { return values; }
+	Point getPoint() { return point; }
+};
+
+TEST_F(MetaTypeTest, byValueProperties) {
+	CustomMetaclass< TestByValue >& mt = declare< TestByValue >()
+		.collection( "values", &TestByValue::getValues )
+		.property( "point", &TestByValue::getPoint );
+
+	TestByValue first;
+	first.values.push_back( 1 );
+	first.point.x = 1;
+	first.point.y = 2;
+	TestByValue second;
+	second.values.push_back( 3 );
+	second.values.push_back( 4 );
+	second.point.x = 5;
+	second.point.y = 6;
+
+	EXPECT_EQ( "{\"point\":{\"x\":1,\"y\":2},\"values\":{\"properties\":{},\"elements\":[1]}}", mt.toStr( &first, false, true ) );
+	EXPECT_EQ( "{\"point\":{\"x\":5,\"y\":6},\"values\":{\"properties\":{},\"elements\":[3,4]}}", mt.toStr( &second, false, true ) );
+	EXPECT_EQ( "{\"$id\":\"0\",\"point\":{\"x\":5,\"y\":6},\"values\":{\"properties\":{},\"elements\":[3,4]}}", mt.toStr( &second, true, true ) );
+	EXPECT_EQ( 1, mt.eval< double >( &first, "point.x" ) );
+	EXPECT_EQ( 5, mt.eval< double >( &second, "point.x" ) );
+}
+
+TEST_F(MetaTypeTest, propertyAccessor) {
+	PropertyAccessor< int > intMember = mClass()[ "intMember" ].accessor< int >();
+	PropertyAccessor< double > testDouble = mClass()[ "testDouble" ].accessor< double >();
+	PropertyAccessor< Point * > point = mClass()[ "point" ].accessor< Point * >();
+	PropertyAccessor< int > testRO = mClass()[ "testRO" ].accessor< int >();
+
+	intMember.set( &sample, 12 );
+	EXPECT_EQ( 12, sample.intMember );
+	EXPECT_EQ( 12, intMember.get( &sample ) );
+
+	testDouble.set( &sample, 3.5 );
+	EXPECT_EQ( 3.5, sample.getDoubleProp() );
+	EXPECT_EQ( 3.5, testDouble.get( &sample ) );
+
+	Point * previous = point.get( &sample );
+	Point p;
+	point.set( &sample, &p );
+	EXPECT_EQ( &p, point.get( &sample ) );
+	point.set( &sample, previous );
+
+	testRO.set( &sample, 1 );
+	EXPECT_EQ( sample.testIntFunc(), testRO.get( &sample ) );
+
+	PropertyAccessor< double > onlySetter = mClass()[ "onlySetter" ].accessor< double >();
+	onlySetter.set( &sample, 7.5 );
+	EXPECT_EQ( 7.5, sample.getDoubleProp() );
+	EXPECT_THROW( onlySetter.get( &sample ), Error );
+	EXPECT_THROW( mClass()[ "onlySetter" ].get( &sample ), Error );
+
+	EXPECT_THROW( mClass()[ "intMember" ].accessor< double >(), BadCast );
+	EXPECT_THROW( mClass()[ "testStr" ].accessor< int >(), BadCast );
+}
+
+TEST_F(MetaTypeTest, hashedLookup) {
+	const char * path = "intMember.x";
+	EXPECT_EQ( &mClass()[ "intMember" ], mClass().findProperty( path, 9 ) );
+	EXPECT_EQ( &mClass()[ "intMember" ], &mClass().property( path, 9 ) );
+	EXPECT_EQ( NULL, mClass().findProperty( path, 8 ) );
+	EXPECT_EQ( NULL, mClass().findProperty( "" ) );
+	EXPECT_THROW( mClass().property( path, 8 ), Error );
+
+	EXPECT_EQ( &mClass().method( "testSquare" ), mClass().findMethod( "testSquare" ) );
+	EXPECT_EQ( NULL, mClass().findMethod( "testSquar" ) );
+	EXPECT_EQ( &mClass()[ "point" ], metatype< Sample * >().findProperty( "point" ) );
+
+	Metatype& mt = declare< TestUntyped >();
+	EXPECT_EQ( NULL, mt.findProperty( "index" ) );
+	mt.addProperty( "index", new UntypedProperty< TestUntyped >( metatype< Point * >(), "index" ) );
+	EXPECT_EQ( &mt[ "index" ], mt.findProperty( "index" ) );
+	mt.deleteProperty( "index" );
+	EXPECT_EQ( NULL, mt.findProperty( "index" ) );
+}
+
+TEST_F(MetaTypeTest, checkUseCase) {
+	useCase();
+}
 
 GTEST_API_ int main(int argc, char **argv) {
 	std::cout << "Running tests\n";